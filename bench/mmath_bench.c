@@ -0,0 +1,411 @@
+// Measures every public mmath function and prints the results as JSON.
+//
+// Each benchmark runs in two modes:
+//   latency     every call consumes the previous call's output (one dependent chain)
+//   throughput  calls rotate over BENCH_SLOTS independent operands, batch functions
+//               process BENCH_BATCH elements per call
+//
+// Usage: mmath_bench [--filter <substring>] [--mode latency|throughput] [--min-time <ms>]
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define BENCH_HAVE_MXCSR
+#endif
+
+#include "mmath.h"
+
+#define BENCH_SLOTS 64
+#define BENCH_BATCH 64
+
+// One operand of any type, every benchmark picks the member it needs
+typedef union bench_slot {
+  float f[32];
+  vec2 vec2;
+  vec3 vec3;
+  vec4 vec4;
+  quat quat;
+  quat2 quat2;
+  mat2 mat2;
+  mat2d mat2d;
+  mat3 mat3;
+  mat4 mat4;
+  mat3x4 mat3x4;
+  aabb3 aabb3;
+  frustum frustum;
+  ray3 ray3;
+} bench_slot;
+
+// x is the chained operand, y and z are read-only inputs
+typedef struct bench_state {
+  bench_slot x[BENCH_SLOTS];
+  bench_slot y[BENCH_SLOTS];
+  bench_slot z[BENCH_SLOTS];
+  size_t mask;
+  size_t n;
+  float zero;
+} bench_state;
+
+typedef void (*bench_fn)(bench_state *S, size_t iterations);
+
+typedef struct bench_entry {
+  const char *name;
+  bench_fn fn;
+  // Batch functions count S->n operations per call
+  bool batched;
+} bench_entry;
+
+// Buffers for the batch functions, the latency mode works in place on their first element
+static float bench_floats[16][BENCH_BATCH];
+static vec3 bench_vec3s[2][BENCH_BATCH];
+static vec4 bench_vec4s[BENCH_BATCH];
+static quat bench_quats[3][BENCH_BATCH];
+static quat2 bench_quat2s[BENCH_BATCH];
+static mat4 bench_mat4s[2][BENCH_BATCH];
+static mat3x4 bench_mat3x4s[2][BENCH_BATCH];
+// Tagged copies of the x and y slot matrices, the tag does not fit in a slot
+static xform bench_xforms[2][BENCH_SLOTS];
+static aabb3 bench_aabb3s[2][BENCH_BATCH];
+static uint32_t bench_indices[BENCH_BATCH];
+static uint16_t bench_joints[BENCH_BATCH * 4];
+static float bench_weights[BENCH_BATCH * 4];
+static vec3_soa *bench_vec3_soas[2];
+static vec4_soa *bench_vec4_soas[2];
+static quat_soa *bench_quat_soas[2];
+// A 4x4x4 grid of half-unit boxes over [-2, 2]
+static aabb3 bench_bvh_bounds[BENCH_BATCH];
+static bvh *bench_bvh;
+static hierarchy *bench_hierarchy;
+static hierarchy *bench_hierarchy_scratch;
+// Rays straight down through bench_triangle at lane-dependent spots, and copies of the
+// triangle stacked along z
+static vec3 bench_triangle[3] = { { { -1.f, -1.f, 0.f } }, { { 1.f, -1.f, 0.f } }, { { 0.f, 1.f, 0.f } } };
+static ray3 bench_ray3s[8];
+static ray3_packet bench_ray3_packet;
+static ray3_triangle_packet bench_triangle_packet;
+static ray3_packet_hit bench_packet_hit;
+static mmath_arena *bench_arena;
+static mmath_pool *bench_pool;
+static mmath_rng bench_rng;
+static frustum bench_frustum;
+static const bench_slot bench_ones = { { 1.f, 1.f, 1.f, 1.f } };
+
+// Touches every element so the chunks of a parallel_for are not empty
+static void bench_parallel_scale(size_t begin, size_t end, void *user) {
+  float *data = (float *) user;
+  for (; begin < end; ++begin) {
+    data[begin] *= 1.f;
+  }
+}
+
+typedef struct bench_ray {
+  const vec3 *origin;
+  const vec3 *direction;
+} bench_ray;
+
+// Slab test of a bench_ray against bench_bvh_bounds[index]
+static bool bench_bvh_ray(uint32_t index, float *t, void *user) {
+  const bench_ray *ray = (const bench_ray *) user;
+  const aabb3 *box = &bench_bvh_bounds[index];
+  float lo = 0.f, hi = *t;
+  int k;
+
+  for (k = 0; k < 3; ++k) {
+    float inverse = 1.f / ray->direction->data[k];
+    float d0 = (box->min.data[k] - ray->origin->data[k]) * inverse;
+    float d1 = (box->max.data[k] - ray->origin->data[k]) * inverse;
+    lo = fmaxf(lo, fminf(d0, d1));
+    hi = fminf(hi, fmaxf(d0, d1));
+  }
+  if (lo > hi) {
+    return false;
+  }
+  *t = lo;
+  return true;
+}
+
+// Keeps a result alive and makes the next call depend on it, S->zero is 0 at run time
+#define FEED(v) (X->f[0] += (float) (v) * S->zero)
+// A scalar argument that depends on the previous call
+#define CHAIN(v) ((v) + X->f[0] * S->zero)
+
+// mmath_bench_cases.h is expanded twice, once into functions and once into the entry table
+#define BENCH(name, ...) BENCH_CASE(name, false, __VA_ARGS__)
+#define BENCH_BATCH_CASE(name, ...) BENCH_CASE(name, true, __VA_ARGS__)
+
+#define BENCH_CASE(name, batched, ...) \
+  static void bench_##name(bench_state *S, size_t iterations) { \
+    size_t it; \
+    for (it = 0; it < iterations; ++it) { \
+      bench_slot *X = &S->x[it & S->mask]; \
+      const bench_slot *Y = &S->y[it & S->mask]; \
+      const bench_slot *Z = &S->z[it & S->mask]; \
+      size_t n = S->n; \
+      (void) X; (void) Y; (void) Z; (void) n; \
+      __VA_ARGS__; \
+    } \
+  }
+
+// Shapes shared by most of the API
+#define B_CREATE(T) BENCH(T##_create, T##_free(T##_create()))
+#define B_CLONE(T) BENCH(T##_clone, T##_free(T##_clone(&X->T)))
+#define B_OUT(T, fn) BENCH(fn, fn(&X->T))
+#define B_UNARY(T, fn) BENCH(fn, fn(&X->T, &X->T))
+#define B_BINARY(T, fn) BENCH(fn, fn(&X->T, &X->T, &Y->T))
+#define B_SCALAR(T, fn) BENCH(fn, fn(&X->T, &X->T, CHAIN(1.f)))
+#define B_ANGLE(T, fn) BENCH(fn, fn(&X->T, &X->T, .1f))
+#define B_LERP(T, fn) BENCH(fn, fn(&X->T, &Y->T, &Z->T, CHAIN(.5f)))
+#define B_REDUCE1(T, fn) BENCH(fn, FEED(fn(&X->T)))
+#define B_REDUCE2(T, fn) BENCH(fn, FEED(fn(&X->T, &Y->T)))
+
+#include "mmath_bench_cases.h"
+
+#undef BENCH_CASE
+#define BENCH_CASE(name, batched, ...) { #name, bench_##name, batched },
+
+static const bench_entry bench_entries[] = {
+#include "mmath_bench_cases.h"
+};
+
+static double bench_now() {
+#if defined(_WIN32)
+  LARGE_INTEGER counter, frequency;
+  QueryPerformanceCounter(&counter);
+  QueryPerformanceFrequency(&frequency);
+  return (double) counter.QuadPart / (double) frequency.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Two rigid transforms back to back, so every type reads a sensible value out of a slot:
+// unit-length vectors and quaternions, invertible matrices, non-empty boxes.
+static void bench_init_slot(bench_slot *slot, float angle) {
+  quat q;
+  vec3 axis = { { .3f, .9f, .2f } };
+  vec3 t = { { 1.f, 2.f, 3.f } };
+
+  vec3_normalize(&axis, &axis);
+  quat_set_axis_angle(&q, &axis, angle);
+  mat4_from_rotation_translation(&slot->mat4, &q, &t);
+  quat_set_axis_angle(&q, &axis, angle + 1.f);
+  mat4_from_rotation_translation((mat4 *) &slot->f[16], &q, &t);
+}
+
+static void bench_reset(bench_state *S, int throughput) {
+  size_t i, k;
+
+  for (i = 0; i < BENCH_SLOTS; ++i) {
+    bench_init_slot(&S->x[i], .5f + (float) i * .01f);
+    bench_init_slot(&S->y[i], 1.f + (float) i * .01f);
+    bench_init_slot(&S->z[i], 1.5f + (float) i * .01f);
+    xform_from_mat4(&bench_xforms[0][i], &S->x[i].mat4);
+    xform_from_mat4(&bench_xforms[1][i], &S->y[i].mat4);
+  }
+  S->mask = throughput ? BENCH_SLOTS - 1 : 0;
+  S->n = throughput ? BENCH_BATCH : 1;
+
+  for (i = 0; i < BENCH_BATCH; ++i) {
+    for (k = 0; k < 16; ++k) {
+      bench_floats[k][i] = S->x[i].f[k];
+    }
+    for (k = 0; k < 2; ++k) {
+      vec3_copy(&bench_vec3s[k][i], &S->x[i].vec3);
+      mat4_copy(&bench_mat4s[k][i], &S->y[i].mat4);
+      mat3x4_from_mat4(&bench_mat3x4s[k][i], &S->y[i].mat4);
+      aabb3_set(&bench_aabb3s[k][i], &S->x[i].vec3, &S->y[i].vec3);
+      aabb3_expand(&bench_aabb3s[k][i], &bench_aabb3s[k][i], &S->y[i].vec3);
+    }
+    vec4_copy(&bench_vec4s[i], &S->x[i].vec4);
+    for (k = 0; k < 3; ++k) {
+      mat4_get_rotation(&bench_quats[k][i], &S->x[(i + k) % BENCH_SLOTS].mat4);
+    }
+    quat2_from_mat4(&bench_quat2s[i], &S->y[i].mat4);
+    bench_floats[3][i] = .5f;
+    for (k = 0; k < 4; ++k) {
+      bench_joints[i * 4 + k] = (uint16_t) ((i + k * 7) % BENCH_BATCH);
+      bench_weights[i * 4 + k] = .25f;
+    }
+    bench_indices[i] = (uint32_t) i;
+  }
+  for (k = 0; k < 2; ++k) {
+    vec3_soa_from_vec3(bench_vec3_soas[k], bench_vec3s[k]);
+    vec4_soa_from_vec4(bench_vec4_soas[k], bench_vec4s);
+    quat_soa_from_quat(bench_quat_soas[k], bench_quats[k]);
+  }
+}
+
+typedef struct bench_result {
+  double ns_per_op;
+  double ops_per_sec;
+  size_t iterations;
+} bench_result;
+
+static bench_result bench_run(const bench_entry *entry, bench_state *S, int throughput, double min_time) {
+  size_t iterations = 16;
+  double elapsed = 0.;
+  bench_result result;
+
+  bench_reset(S, throughput);
+  entry->fn(S, iterations);
+
+  // Grow the run until it lasts min_time, extrapolating from the last one
+  for (;;) {
+    double start = bench_now();
+    entry->fn(S, iterations);
+    elapsed = bench_now() - start;
+
+    if (elapsed >= min_time) {
+      break;
+    }
+    if (elapsed < min_time / 100.) {
+      iterations *= 10;
+    } else {
+      iterations = (size_t) ((double) iterations * min_time * 1.2 / elapsed) + 1;
+    }
+  }
+
+  double ops = (double) iterations * (entry->batched ? (double) S->n : 1.);
+  result.ns_per_op = elapsed * 1e9 / ops;
+  result.ops_per_sec = ops / elapsed;
+  result.iterations = iterations;
+  return result;
+}
+
+int main(int argc, char **argv) {
+  const char *filter = NULL;
+  const char *only_mode = NULL;
+  double min_time = .02;
+  int first = 1;
+  size_t i;
+  int mode;
+  bool flush_denormals = false;
+  volatile float zero = 0.f;
+
+  for (i = 1; i < (size_t) argc; ++i) {
+    if (strcmp(argv[i], "--filter") == 0 && i + 1 < (size_t) argc) {
+      filter = argv[++i];
+    } else if (strcmp(argv[i], "--mode") == 0 && i + 1 < (size_t) argc) {
+      only_mode = argv[++i];
+    } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < (size_t) argc) {
+      min_time = atof(argv[++i]) * 1e-3;
+    } else {
+      fprintf(stderr, "usage: %s [--filter <substring>] [--mode latency|throughput] [--min-time <ms>]\n", argv[0]);
+      return 1;
+    }
+  }
+
+#if defined(BENCH_HAVE_MXCSR)
+  // Long dependent chains can drift into denormals, which would measure the FPU assist instead
+  _mm_setcsr(_mm_getcsr() | 0x8040);
+  flush_denormals = true;
+#endif
+
+  bench_state *S = malloc(sizeof(bench_state));
+  S->zero = zero;
+
+  for (i = 0; i < 2; ++i) {
+    bench_vec3_soas[i] = vec3_soa_create(BENCH_BATCH);
+    bench_vec4_soas[i] = vec4_soa_create(BENCH_BATCH);
+    bench_quat_soas[i] = quat_soa_create(BENCH_BATCH);
+  }
+  bench_hierarchy = hierarchy_create(BENCH_BATCH);
+  for (i = 0; i < BENCH_BATCH; ++i) {
+    hierarchy_add(bench_hierarchy, i == 0 ? -1 : (int32_t) ((i - 1) / 4));
+  }
+  bench_hierarchy_scratch = hierarchy_create(BENCH_BATCH);
+  for (i = 0; i < BENCH_BATCH; ++i) {
+    vec3 min = { { (float) (i % 4) - 2.f, (float) (i / 4 % 4) - 2.f, (float) (i / 16) - 2.f } }, max;
+    aabb3_set(&bench_bvh_bounds[i], &min, vec3_add(&max, &min, &(vec3) { { .5f, .5f, .5f } }));
+  }
+  bench_bvh = bvh_create(bench_bvh_bounds, BENCH_BATCH, NULL);
+  for (i = 0; i < 8; ++i) {
+    vec3 offset = { { 0.f, 0.f, (float) i * .1f } }, a, b, c;
+
+    ray3_set(&bench_ray3s[i], &(vec3) { { (float) i * .05f - .2f, -.2f, 2.f } }, &(vec3) { { 0.f, 0.f, -1.f } });
+    ray3_packet_set(&bench_ray3_packet, i, &bench_ray3s[i]);
+    vec3_add(&a, &bench_triangle[0], &offset);
+    vec3_add(&b, &bench_triangle[1], &offset);
+    vec3_add(&c, &bench_triangle[2], &offset);
+    ray3_triangle_packet_set(&bench_triangle_packet, i, &a, &b, &c);
+    bench_packet_hit.t[i] = 10.f;
+  }
+  bench_arena = mmath_arena_create(0);
+  bench_pool = mmath_pool_create(0);
+  mmath_rng_seed(&bench_rng, 1);
+
+  {
+    mat4 projection, view;
+    vec3 eye = { { 0.f, 0.f, 5.f } }, center = { { 0.f, 0.f, 0.f } }, up = { { 0.f, 1.f, 0.f } };
+    mat4_perspective(&projection, 1.f, 1.f, .1f, 100.f);
+    mat4_look_at(&view, &eye, &center, &up);
+    frustum_from_mat4(&bench_frustum, mat4_multiply(&projection, &projection, &view));
+  }
+
+  printf("{\n");
+  printf("  \"library\": \"mmath\",\n");
+  printf("  \"backend\": \"%s\",\n", mmath_backend_name(mmath_get_backend()));
+  printf("  \"flush_denormals\": %s,\n", flush_denormals ? "true" : "false");
+  printf("  \"min_time_ms\": %g,\n", min_time * 1e3);
+  printf("  \"slots\": %d,\n", BENCH_SLOTS);
+  printf("  \"batch\": %d,\n", BENCH_BATCH);
+  printf("  \"threads\": %zu,\n", mmath_pool_threads(bench_pool));
+  printf("  \"results\": [");
+
+  for (i = 0; i < sizeof(bench_entries) / sizeof(bench_entries[0]); ++i) {
+    const bench_entry *entry = &bench_entries[i];
+
+    if (filter != NULL && strstr(entry->name, filter) == NULL) {
+      continue;
+    }
+
+    for (mode = 0; mode < 2; ++mode) {
+      const char *mode_name = mode ? "throughput" : "latency";
+      bench_result r;
+
+      if (only_mode != NULL && strcmp(only_mode, mode_name) != 0) {
+        continue;
+      }
+
+      r = bench_run(entry, S, mode, min_time);
+      printf(
+        "%s\n    {\"name\": \"%s\", \"mode\": \"%s\", \"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"iterations\": %zu}",
+        first ? "" : ",", entry->name, mode_name, r.ns_per_op, r.ops_per_sec, r.iterations
+      );
+      first = 0;
+      fflush(stdout);
+    }
+  }
+
+  printf("\n  ]\n}\n");
+
+  mmath_pool_destroy(bench_pool);
+  mmath_arena_destroy(bench_arena);
+  bvh_free(bench_bvh);
+  hierarchy_free(bench_hierarchy_scratch);
+  hierarchy_free(bench_hierarchy);
+  for (i = 0; i < 2; ++i) {
+    quat_soa_free(bench_quat_soas[i]);
+    vec4_soa_free(bench_vec4_soas[i]);
+    vec3_soa_free(bench_vec3_soas[i]);
+  }
+  free(S);
+  return 0;
+}
@@ -0,0 +1,804 @@
+// One BENCH or BENCH_BATCH_CASE per public function, grouped by header in include order.
+// X is chained through every call, Y and Z are read-only. Functions that allocate are
+// measured together with their matching *_free.
+
+// alloc.h
+BENCH(mmath_set_allocator, mmath_set_allocator(NULL))
+BENCH(mmath_arena_create, mmath_arena_destroy(mmath_arena_create(0)))
+BENCH(
+  mmath_arena_begin,
+  mmath_arena_begin(bench_arena);
+  vec4_free(vec4_create());
+  mmath_arena_end();
+  mmath_arena_reset(bench_arena)
+)
+
+// common.h
+BENCH(mmath_random, FEED(mmath_random()))
+BENCH_BATCH_CASE(mmath_sincosf_batch, mmath_sincosf_batch(bench_floats[0], bench_floats[1], bench_floats[0], n))
+BENCH(mmath_get_backend, FEED(mmath_get_backend()))
+BENCH(mmath_backend_name, FEED(mmath_backend_name(mmath_get_backend())[0]))
+
+// rng.h
+BENCH(mmath_rng_create, mmath_rng_free(mmath_rng_create(it)))
+BENCH(mmath_rng_seed, mmath_rng_seed(&bench_rng, it))
+BENCH(mmath_rng_thread, FEED(mmath_rng_thread()->s[0]))
+BENCH(mmath_random_seed, mmath_random_seed(it))
+BENCH(mmath_rng_next, FEED(mmath_rng_next(&bench_rng)))
+BENCH(mmath_rng_float, FEED(mmath_rng_float(&bench_rng)))
+BENCH_BATCH_CASE(mmath_rng_fill_float, mmath_rng_fill_float(&bench_rng, bench_floats[4], n))
+BENCH_BATCH_CASE(mmath_rng_fill_unit_vec3, mmath_rng_fill_unit_vec3(&bench_rng, bench_vec3s[1], n))
+BENCH_BATCH_CASE(mmath_rng_fill_unit_quat, mmath_rng_fill_unit_quat(&bench_rng, bench_quats[2], n))
+
+// mat2.h
+B_CREATE(mat2)
+B_CREATE(mat2a)
+B_CLONE(mat2)
+BENCH(mat2_from_values, mat2_free(mat2_from_values(X->f[0], 0.f, 0.f, 1.f)))
+B_UNARY(mat2, mat2_copy)
+B_OUT(mat2, mat2_identity)
+BENCH(mat2_set, mat2_set(&X->mat2, CHAIN(1.f), 0.f, 0.f, 1.f))
+B_UNARY(mat2, mat2_transpose)
+B_UNARY(mat2, mat2_invert)
+B_UNARY(mat2, mat2_adjoint)
+B_REDUCE1(mat2, mat2_determinant)
+B_BINARY(mat2, mat2_multiply)
+B_ANGLE(mat2, mat2_rotate)
+BENCH(mat2_scale, mat2_scale(&X->mat2, &X->mat2, &bench_ones.vec2))
+BENCH(mat2_from_rotation, mat2_from_rotation(&X->mat2, CHAIN(.1f)))
+BENCH(mat2_from_scaling, mat2_from_scaling(&X->mat2, &X->vec2))
+B_REDUCE1(mat2, mat2_frob)
+B_BINARY(mat2, mat2_add)
+B_BINARY(mat2, mat2_subtract)
+B_SCALAR(mat2, mat2_multiply_scalar)
+BENCH(mat2_multiply_scalar_and_add, mat2_multiply_scalar_and_add(&X->mat2, &X->mat2, &Y->mat2, CHAIN(1.f)))
+B_REDUCE2(mat2, mat2_exact_equals)
+B_REDUCE2(mat2, mat2_equals)
+
+// mat2d.h
+B_CREATE(mat2d)
+B_CREATE(mat2da)
+B_CLONE(mat2d)
+BENCH(mat2d_from_values, mat2d_free(mat2d_from_values(X->f[0], 0.f, 0.f, 1.f, 0.f, 0.f)))
+B_UNARY(mat2d, mat2d_copy)
+B_OUT(mat2d, mat2d_identity)
+BENCH(mat2d_set, mat2d_set(&X->mat2d, CHAIN(1.f), 0.f, 0.f, 1.f, 0.f, 0.f))
+B_UNARY(mat2d, mat2d_invert)
+B_REDUCE1(mat2d, mat2d_determinant)
+B_BINARY(mat2d, mat2d_multiply)
+B_ANGLE(mat2d, mat2d_rotate)
+BENCH(mat2d_scale, mat2d_scale(&X->mat2d, &X->mat2d, &bench_ones.vec2))
+BENCH(mat2d_translate, mat2d_translate(&X->mat2d, &X->mat2d, &Y->vec2))
+BENCH(mat2d_from_rotation, mat2d_from_rotation(&X->mat2d, CHAIN(.1f)))
+BENCH(mat2d_from_scaling, mat2d_from_scaling(&X->mat2d, &X->vec2))
+BENCH(mat2d_from_translation, mat2d_from_translation(&X->mat2d, &X->vec2))
+B_REDUCE1(mat2d, mat2d_frob)
+B_BINARY(mat2d, mat2d_add)
+B_BINARY(mat2d, mat2d_subtract)
+B_SCALAR(mat2d, mat2d_multiply_scalar)
+BENCH(mat2d_multiply_scalar_and_add, mat2d_multiply_scalar_and_add(&X->mat2d, &X->mat2d, &Y->mat2d, CHAIN(1.f)))
+B_REDUCE2(mat2d, mat2d_exact_equals)
+B_REDUCE2(mat2d, mat2d_equals)
+
+// mat3.h
+B_CREATE(mat3)
+B_CREATE(mat3a)
+B_CLONE(mat3)
+BENCH(mat3_from_values, mat3_free(mat3_from_values(X->f[0], 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f)))
+B_UNARY(mat3, mat3_copy)
+B_OUT(mat3, mat3_identity)
+BENCH(mat3_set, mat3_set(&X->mat3, CHAIN(1.f), 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f))
+B_UNARY(mat3, mat3_transpose)
+B_UNARY(mat3, mat3_invert)
+B_UNARY(mat3, mat3_adjoint)
+B_REDUCE1(mat3, mat3_determinant)
+B_BINARY(mat3, mat3_multiply)
+BENCH(mat3_translate, mat3_translate(&X->mat3, &X->mat3, &Y->vec2))
+B_ANGLE(mat3, mat3_rotate)
+BENCH(mat3_scale, mat3_scale(&X->mat3, &X->mat3, &bench_ones.vec2))
+BENCH(mat3_from_translation, mat3_from_translation(&X->mat3, &X->vec2))
+BENCH(mat3_from_rotation, mat3_from_rotation(&X->mat3, CHAIN(.1f)))
+BENCH(mat3_from_scaling, mat3_from_scaling(&X->mat3, &X->vec2))
+BENCH(mat3_from_mat2d, mat3_from_mat2d(&X->mat3, &Y->mat2d); FEED(X->f[1]))
+BENCH(mat3_from_mat4, mat3_from_mat4(&X->mat3, &Y->mat4); FEED(X->f[1]))
+B_REDUCE1(mat3, mat3_frob)
+B_BINARY(mat3, mat3_add)
+B_BINARY(mat3, mat3_subtract)
+B_SCALAR(mat3, mat3_multiply_scalar)
+BENCH(mat3_multiply_scalar_and_add, mat3_multiply_scalar_and_add(&X->mat3, &X->mat3, &Y->mat3, CHAIN(1.f)))
+BENCH(mat3_projection, mat3_projection(&X->mat3, CHAIN(1280.f), 720.f))
+B_REDUCE2(mat3, mat3_exact_equals)
+B_REDUCE2(mat3, mat3_equals)
+
+// mat4.h
+B_CREATE(mat4)
+B_CREATE(mat4a)
+B_CLONE(mat4)
+BENCH(
+  mat4_from_values,
+  mat4_free(mat4_from_values(X->f[0], 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f))
+)
+B_UNARY(mat4, mat4_copy)
+B_OUT(mat4, mat4_identity)
+BENCH(mat4_set, mat4_set(&X->mat4, CHAIN(1.f), 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f))
+B_UNARY(mat4, mat4_transpose)
+B_UNARY(mat4, mat4_invert)
+B_UNARY(mat4, mat4_invert_affine)
+B_UNARY(mat4, mat4_invert_rigid)
+BENCH_BATCH_CASE(mat4_invert_batch, FEED(mat4_invert_batch(bench_mat4s[0], bench_mat4s[0], n, bench_indices)))
+BENCH_BATCH_CASE(mat4_invert_affine_batch, FEED(mat4_invert_affine_batch(bench_mat4s[0], bench_mat4s[0], n, bench_indices)))
+BENCH_BATCH_CASE(mat4_invert_rigid_batch, mat4_invert_rigid_batch(bench_mat4s[0], bench_mat4s[0], n))
+BENCH_BATCH_CASE(mat4_multiply_batch, mat4_multiply_batch(bench_mat4s[1], &bench_mat4s[0][0], bench_mat4s[1], n))
+BENCH_BATCH_CASE(mat4_multiply_pairs_batch, mat4_multiply_pairs_batch(bench_mat4s[1], bench_mat4s[0], bench_mat4s[1], n))
+BENCH_BATCH_CASE(
+  mat4_multiply_indexed_batch,
+  mat4_multiply_indexed_batch(bench_mat4s[1], bench_mat4s[0], bench_indices, bench_mat4s[1], n)
+)
+B_UNARY(mat4, mat4_adjoint)
+B_REDUCE1(mat4, mat4_determinant)
+B_BINARY(mat4, mat4_multiply)
+BENCH(mat4_translate, mat4_translate(&X->mat4, &X->mat4, &Y->vec4))
+BENCH(mat4_rotate, mat4_rotate(&X->mat4, &X->mat4, .1f, &Y->vec3))
+B_ANGLE(mat4, mat4_rotate_x)
+B_ANGLE(mat4, mat4_rotate_y)
+B_ANGLE(mat4, mat4_rotate_z)
+BENCH(mat4_scale, mat4_scale(&X->mat4, &X->mat4, &bench_ones.vec4))
+BENCH(mat4_from_translation, mat4_from_translation(&X->mat4, &X->vec4))
+BENCH(mat4_from_rotation, mat4_from_rotation(&X->mat4, CHAIN(.1f), &Y->vec3))
+BENCH(mat4_from_rotation_x, mat4_from_rotation_x(&X->mat4, CHAIN(.1f)))
+BENCH(mat4_from_rotation_y, mat4_from_rotation_y(&X->mat4, CHAIN(.1f)))
+BENCH(mat4_from_rotation_z, mat4_from_rotation_z(&X->mat4, CHAIN(.1f)))
+BENCH_BATCH_CASE(
+  mat4_from_rotation_x_batch,
+  mat4_from_rotation_x_batch(bench_mat4s[1], bench_floats[0], n);
+  bench_floats[0][0] += bench_mat4s[1][0].data[5] * S->zero
+)
+BENCH_BATCH_CASE(
+  mat4_from_rotation_y_batch,
+  mat4_from_rotation_y_batch(bench_mat4s[1], bench_floats[0], n);
+  bench_floats[0][0] += bench_mat4s[1][0].data[0] * S->zero
+)
+BENCH_BATCH_CASE(
+  mat4_from_rotation_z_batch,
+  mat4_from_rotation_z_batch(bench_mat4s[1], bench_floats[0], n);
+  bench_floats[0][0] += bench_mat4s[1][0].data[0] * S->zero
+)
+BENCH(mat4_from_scaling, mat4_from_scaling(&X->mat4, &X->vec4))
+BENCH(mat4_from_rotation_translation, mat4_from_rotation_translation(&X->mat4, &Y->quat, &X->vec3))
+BENCH(mat4_from_quat2, mat4_from_quat2(&X->mat4, &Y->quat2); FEED(X->f[1]))
+BENCH(mat4_from_mat3x4, mat4_from_mat3x4(&X->mat4, &Y->mat3x4); FEED(X->f[1]))
+BENCH_BATCH_CASE(mat4_from_mat3x4_batch, mat4_from_mat3x4_batch(bench_mat4s[1], bench_mat3x4s[0], n))
+BENCH(mat4_get_translation, mat4_get_translation(&X->vec3, &X->mat4))
+BENCH(mat4_get_rotation, mat4_get_rotation(&X->quat, &X->mat4))
+BENCH(mat4_get_scaling, mat4_get_scaling(&X->vec3, &X->mat4))
+BENCH(
+  mat4_decompose,
+  // Outputs go to the upper half of the slot, after the matrix
+  mat4_decompose((quat *) &X->f[16], (vec3 *) &X->f[20], (vec3 *) &X->f[24], (vec3 *) &X->f[28], &X->mat4);
+  FEED(X->f[16])
+)
+BENCH_BATCH_CASE(
+  mat4_decompose_batch,
+  FEED(mat4_decompose_batch(bench_quats[0], bench_vec3s[0], bench_vec3s[1], NULL, bench_mat4s[0], n, bench_indices))
+)
+BENCH(
+  mat4_from_rotation_translation_scale,
+  mat4_from_rotation_translation_scale(&X->mat4, &Y->quat, &X->vec3, &bench_ones.vec3)
+)
+BENCH_BATCH_CASE(
+  mat4_from_rotation_translation_scale_batch,
+  mat4_from_rotation_translation_scale_batch(
+    bench_mat4s[1], bench_quats[0], bench_vec3s[0], bench_vec3s[1], &bench_mat4s[0][0], n
+  )
+)
+BENCH_BATCH_CASE(
+  mat4_from_rotation_translation_scale_batch_soa,
+  mat4_from_rotation_translation_scale_batch_soa(
+    bench_mat4s[1],
+    (const float *const[4]) { bench_floats[4], bench_floats[5], bench_floats[6], bench_floats[7] },
+    (const float *const[3]) { bench_floats[8], bench_floats[9], bench_floats[10] },
+    (const float *const[3]) { bench_floats[11], bench_floats[12], bench_floats[13] },
+    &bench_mat4s[0][0],
+    n
+  )
+)
+BENCH(
+  mat4_from_rotation_translation_scale_origin,
+  mat4_from_rotation_translation_scale_origin(&X->mat4, &Y->quat, &X->vec3, &bench_ones.vec3, &Z->vec3)
+)
+BENCH(mat4_from_quat, mat4_from_quat(&X->mat4, &X->quat))
+BENCH(mat4_frustum, mat4_frustum(&X->mat4, CHAIN(-1.f), 1.f, -1.f, 1.f, .1f, 100.f))
+BENCH(mat4_perspective, mat4_perspective(&X->mat4, CHAIN(1.f), 1.f, .1f, 100.f))
+BENCH(
+  mat4_perspective_from_field_of_view,
+  mat4_perspective_from_field_of_view(&X->mat4, CHAIN(45.f), 45.f, 45.f, 45.f, .1f, 100.f)
+)
+BENCH(mat4_ortho, mat4_ortho(&X->mat4, CHAIN(-1.f), 1.f, -1.f, 1.f, .1f, 100.f))
+BENCH(mat4_look_at, mat4_look_at(&X->mat4, &X->vec3, &Y->vec3, &Z->vec3))
+BENCH(mat4_target_to, mat4_target_to(&X->mat4, &X->vec3, &Y->vec3, &Z->vec3))
+B_REDUCE1(mat4, mat4_frob)
+B_BINARY(mat4, mat4_add)
+B_BINARY(mat4, mat4_subtract)
+B_SCALAR(mat4, mat4_multiply_scalar)
+BENCH(mat4_multiply_scalar_and_add, mat4_multiply_scalar_and_add(&X->mat4, &X->mat4, &Y->mat4, CHAIN(1.f)))
+B_REDUCE2(mat4, mat4_exact_equals)
+B_REDUCE2(mat4, mat4_equals)
+
+// mat3x4.h
+B_CREATE(mat3x4)
+B_CREATE(mat3x4a)
+B_CLONE(mat3x4)
+B_UNARY(mat3x4, mat3x4_copy)
+B_OUT(mat3x4, mat3x4_identity)
+BENCH(mat3x4_from_mat4, mat3x4_from_mat4(&X->mat3x4, &Y->mat4); FEED(X->f[1]))
+BENCH(
+  mat3x4_from_rotation_translation_scale,
+  mat3x4_from_rotation_translation_scale(&X->mat3x4, &Y->quat, &X->vec3, &bench_ones.vec3)
+)
+B_BINARY(mat3x4, mat3x4_multiply)
+B_UNARY(mat3x4, mat3x4_invert)
+BENCH(mat3x4_transform_point, mat3x4_transform_point(&X->vec3, &X->vec3, &Y->mat3x4))
+BENCH(mat3x4_transform_vector, mat3x4_transform_vector(&X->vec3, &X->vec3, &Y->mat3x4))
+BENCH_BATCH_CASE(mat3x4_from_mat4_batch, mat3x4_from_mat4_batch(bench_mat3x4s[1], bench_mat4s[0], n))
+BENCH_BATCH_CASE(
+  mat3x4_from_rotation_translation_scale_batch,
+  mat3x4_from_rotation_translation_scale_batch(bench_mat3x4s[1], bench_quats[0], bench_vec3s[0], bench_vec3s[1], n)
+)
+BENCH_BATCH_CASE(mat3x4_multiply_batch, mat3x4_multiply_batch(bench_mat3x4s[0], bench_mat3x4s[0], bench_mat3x4s[1], n))
+BENCH_BATCH_CASE(mat3x4_invert_batch, FEED(mat3x4_invert_batch(bench_mat3x4s[0], bench_mat3x4s[0], n, bench_indices)))
+BENCH_BATCH_CASE(
+  mat3x4_transform_point_batch,
+  mat3x4_transform_point_batch(bench_vec3s[0], sizeof(vec3), bench_vec3s[0], sizeof(vec3), n, &Y->mat3x4)
+)
+BENCH_BATCH_CASE(
+  mat3x4_transform_vector_batch,
+  mat3x4_transform_vector_batch(bench_vec3s[0], sizeof(vec3), bench_vec3s[0], sizeof(vec3), n, &Y->mat3x4)
+)
+B_REDUCE2(mat3x4, mat3x4_exact_equals)
+B_REDUCE2(mat3x4, mat3x4_equals)
+
+// quat.h
+B_CREATE(quat)
+B_CREATE(quata)
+B_CLONE(quat)
+BENCH(quat_from_values, quat_free(quat_from_values(X->f[0], 0.f, 0.f, 1.f)))
+B_UNARY(quat, quat_copy)
+B_OUT(quat, quat_identity)
+BENCH(quat_set, quat_set(&X->quat, CHAIN(0.f), 0.f, 0.f, 1.f))
+BENCH(quat_get_axis_angle, FEED(quat_get_axis_angle((quat *) &X->f[4], &X->quat)))
+BENCH(quat_set_axis_angle, quat_set_axis_angle(&X->quat, &Y->vec3, CHAIN(.1f)))
+B_ANGLE(quat, quat_rotate_x)
+B_ANGLE(quat, quat_rotate_y)
+B_ANGLE(quat, quat_rotate_z)
+B_UNARY(quat, quat_calculate_w)
+B_BINARY(quat, quat_multiply)
+B_BINARY(quat, quat_add)
+B_SCALAR(quat, quat_scale)
+B_REDUCE2(quat, quat_dot)
+B_LERP(quat, quat_lerp)
+B_LERP(quat, quat_slerp)
+B_LERP(quat, quat_slerp_fast)
+BENCH_BATCH_CASE(quat_slerp_batch, quat_slerp_batch(bench_quats[0], bench_quats[1], bench_quats[2], bench_floats[3], n))
+BENCH_BATCH_CASE(
+  quat_slerp_fast_batch,
+  quat_slerp_fast_batch(bench_quats[0], bench_quats[1], bench_quats[2], bench_floats[3], n)
+)
+BENCH_BATCH_CASE(quat_nlerp_batch, quat_nlerp_batch(bench_quats[0], bench_quats[1], bench_quats[2], bench_floats[3], n))
+BENCH_BATCH_CASE(
+  quat_slerp_batch_soa,
+  quat_slerp_batch_soa(
+    (float *const[4]) { bench_floats[4], bench_floats[5], bench_floats[6], bench_floats[7] },
+    (const float *const[4]) { bench_floats[4], bench_floats[5], bench_floats[6], bench_floats[7] },
+    (const float *const[4]) { bench_floats[8], bench_floats[9], bench_floats[10], bench_floats[11] },
+    bench_floats[3],
+    n
+  )
+)
+BENCH_BATCH_CASE(
+  quat_slerp_fast_batch_soa,
+  quat_slerp_fast_batch_soa(
+    (float *const[4]) { bench_floats[4], bench_floats[5], bench_floats[6], bench_floats[7] },
+    (const float *const[4]) { bench_floats[4], bench_floats[5], bench_floats[6], bench_floats[7] },
+    (const float *const[4]) { bench_floats[8], bench_floats[9], bench_floats[10], bench_floats[11] },
+    bench_floats[3],
+    n
+  )
+)
+BENCH_BATCH_CASE(
+  quat_nlerp_batch_soa,
+  quat_nlerp_batch_soa(
+    (float *const[4]) { bench_floats[4], bench_floats[5], bench_floats[6], bench_floats[7] },
+    (const float *const[4]) { bench_floats[4], bench_floats[5], bench_floats[6], bench_floats[7] },
+    (const float *const[4]) { bench_floats[8], bench_floats[9], bench_floats[10], bench_floats[11] },
+    bench_floats[3],
+    n
+  )
+)
+B_OUT(quat, quat_random)
+B_UNARY(quat, quat_invert)
+B_UNARY(quat, quat_conjugate)
+B_REDUCE1(quat, quat_length)
+B_REDUCE1(quat, quat_length_squared)
+B_UNARY(quat, quat_normalize)
+BENCH(quat_from_mat3, quat_from_mat3(&X->quat, &Y->mat3); FEED(X->f[1]))
+BENCH(quat_from_euler, quat_from_euler(&X->quat, CHAIN(.1f), .2f, .3f))
+B_REDUCE2(quat, quat_exact_equals)
+B_REDUCE2(quat, quat_equals)
+
+// quat2.h
+B_CREATE(quat2)
+B_CREATE(quat2a)
+B_CLONE(quat2)
+BENCH(quat2_from_values, quat2_free(quat2_from_values(X->f[0], 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f)))
+BENCH(
+  quat2_from_rotation_translation_values,
+  quat2_free(quat2_from_rotation_translation_values(X->f[0], 0.f, 0.f, 1.f, 1.f, 2.f, 3.f))
+)
+BENCH(quat2_from_rotation_translation, quat2_from_rotation_translation(&X->quat2, &Y->quat, &X->vec3))
+BENCH(quat2_from_translation, quat2_from_translation(&X->quat2, &X->vec3))
+BENCH(quat2_from_rotation, quat2_from_rotation(&X->quat2, &X->quat))
+BENCH(quat2_from_mat4, quat2_from_mat4(&X->quat2, &Y->mat4); FEED(X->f[1]))
+B_UNARY(quat2, quat2_copy)
+B_OUT(quat2, quat2_identity)
+BENCH(quat2_set, quat2_set(&X->quat2, CHAIN(0.f), 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f))
+BENCH(quat2_get_real, quat2_get_real(&X->quat, &X->quat2))
+BENCH(quat2_get_dual, quat2_get_dual(&X->quat, (const quat2 *) &X->f[0]))
+BENCH(quat2_set_real, quat2_set_real(&X->quat2, (const quat *) &X->f[4]))
+BENCH(quat2_set_dual, quat2_set_dual(&X->quat2, &X->quat))
+BENCH(quat2_get_translation, quat2_get_translation(&X->vec3, &X->quat2))
+BENCH(quat2_translate, quat2_translate(&X->quat2, &X->quat2, &Y->vec3))
+B_ANGLE(quat2, quat2_rotate_x)
+B_ANGLE(quat2, quat2_rotate_y)
+B_ANGLE(quat2, quat2_rotate_z)
+BENCH(quat2_rotate_by_quat_append, quat2_rotate_by_quat_append(&X->quat2, &X->quat2, &Y->quat))
+BENCH(quat2_rotate_by_quat_prepend, quat2_rotate_by_quat_prepend(&X->quat2, &Y->quat, &X->quat2))
+BENCH(quat2_rotate_around_axis, quat2_rotate_around_axis(&X->quat2, &X->quat2, &Y->vec3, .1f))
+B_BINARY(quat2, quat2_add)
+B_BINARY(quat2, quat2_multiply)
+B_SCALAR(quat2, quat2_scale)
+B_REDUCE2(quat2, quat2_dot)
+B_LERP(quat2, quat2_lerp)
+B_LERP(quat2, quat2_sclerp)
+B_UNARY(quat2, quat2_invert)
+B_UNARY(quat2, quat2_conjugate)
+B_REDUCE1(quat2, quat2_length)
+B_REDUCE1(quat2, quat2_length_squared)
+B_UNARY(quat2, quat2_normalize)
+B_REDUCE2(quat2, quat2_exact_equals)
+B_REDUCE2(quat2, quat2_equals)
+
+// vec2.h
+B_CREATE(vec2)
+B_CREATE(vec2a)
+B_CLONE(vec2)
+BENCH(vec2_from_values, vec2_free(vec2_from_values(X->f[0], 1.f)))
+B_UNARY(vec2, vec2_copy)
+B_OUT(vec2, vec2_zero)
+BENCH(vec2_set, vec2_set(&X->vec2, CHAIN(1.f), 1.f))
+B_BINARY(vec2, vec2_add)
+B_BINARY(vec2, vec2_subtract)
+B_BINARY(vec2, vec2_multiply)
+B_BINARY(vec2, vec2_divide)
+B_UNARY(vec2, vec2_ceil)
+B_UNARY(vec2, vec2_floor)
+B_BINARY(vec2, vec2_min)
+B_BINARY(vec2, vec2_max)
+B_UNARY(vec2, vec2_round)
+B_SCALAR(vec2, vec2_scale)
+BENCH(vec2_scale_and_add, vec2_scale_and_add(&X->vec2, &X->vec2, &Y->vec2, CHAIN(1.f)))
+B_REDUCE2(vec2, vec2_distance)
+B_REDUCE2(vec2, vec2_distance_squared)
+B_REDUCE1(vec2, vec2_length)
+B_REDUCE1(vec2, vec2_length_squared)
+B_UNARY(vec2, vec2_negate)
+B_UNARY(vec2, vec2_inverse)
+B_UNARY(vec2, vec2_normalize)
+B_REDUCE2(vec2, vec2_dot)
+BENCH(vec2_cross, vec2_cross(&X->vec3, &X->vec2, &Y->vec2))
+B_LERP(vec2, vec2_lerp)
+BENCH(vec2_random, vec2_random(&X->vec2, CHAIN(1.f)))
+BENCH(vec2_transform_mat2, vec2_transform_mat2(&X->vec2, &X->vec2, &Y->mat2))
+BENCH(vec2_transform_mat2d, vec2_transform_mat2d(&X->vec2, &X->vec2, &Y->mat2d))
+BENCH(vec2_transform_mat3, vec2_transform_mat3(&X->vec2, &X->vec2, &Y->mat3))
+BENCH(vec2_transform_mat4, vec2_transform_mat4(&X->vec2, &X->vec2, &Y->mat4))
+BENCH(vec2_rotate, vec2_rotate(&X->vec2, &X->vec2, &Y->vec2, .1f))
+B_REDUCE2(vec2, vec2_angle)
+B_REDUCE2(vec2, vec2_exact_equals)
+B_REDUCE2(vec2, vec2_equals)
+
+// vec3.h
+B_CREATE(vec3)
+B_CREATE(vec3a)
+B_CLONE(vec3)
+BENCH(vec3_from_values, vec3_free(vec3_from_values(X->f[0], 1.f, 1.f)))
+B_UNARY(vec3, vec3_copy)
+B_OUT(vec3, vec3_zero)
+BENCH(vec3_set, vec3_set(&X->vec3, CHAIN(1.f), 1.f, 1.f))
+B_BINARY(vec3, vec3_add)
+B_BINARY(vec3, vec3_subtract)
+B_BINARY(vec3, vec3_multiply)
+B_BINARY(vec3, vec3_divide)
+B_UNARY(vec3, vec3_ceil)
+B_UNARY(vec3, vec3_floor)
+B_BINARY(vec3, vec3_min)
+B_BINARY(vec3, vec3_max)
+B_UNARY(vec3, vec3_round)
+B_SCALAR(vec3, vec3_scale)
+BENCH(vec3_scale_and_add, vec3_scale_and_add(&X->vec3, &X->vec3, &Y->vec3, CHAIN(1.f)))
+B_REDUCE2(vec3, vec3_distance)
+B_REDUCE2(vec3, vec3_distance_squared)
+B_REDUCE1(vec3, vec3_length)
+B_REDUCE1(vec3, vec3_length_squared)
+B_UNARY(vec3, vec3_negate)
+B_UNARY(vec3, vec3_inverse)
+B_UNARY(vec3, vec3_normalize)
+B_REDUCE2(vec3, vec3_dot)
+B_BINARY(vec3, vec3_cross)
+B_LERP(vec3, vec3_lerp)
+BENCH(vec3_hermite, vec3_hermite(&X->vec3, &Y->vec3, &Z->vec3, &Y->vec3, &Z->vec3, CHAIN(.5f)))
+BENCH(vec3_bezier, vec3_bezier(&X->vec3, &Y->vec3, &Z->vec3, &Y->vec3, &Z->vec3, CHAIN(.5f)))
+BENCH(vec3_random, vec3_random(&X->vec3, CHAIN(1.f)))
+BENCH(vec3_transform_mat3, vec3_transform_mat3(&X->vec3, &X->vec3, (mat3 *) &Y->mat3))
+BENCH(vec3_transform_mat4, vec3_transform_mat4(&X->vec3, &X->vec3, (mat4 *) &Y->mat4))
+BENCH_BATCH_CASE(
+  vec3_transform_mat4_batch,
+  vec3_transform_mat4_batch(bench_vec3s[0], sizeof(vec3), bench_vec3s[0], sizeof(vec3), n, &Y->mat4)
+)
+BENCH(vec3_rotate_x, vec3_rotate_x(&X->vec3, &X->vec3, &Y->vec3, .1f))
+BENCH(vec3_rotate_y, vec3_rotate_y(&X->vec3, &X->vec3, &Y->vec3, .1f))
+BENCH(vec3_rotate_z, vec3_rotate_z(&X->vec3, &X->vec3, &Y->vec3, .1f))
+B_REDUCE2(vec3, vec3_angle)
+B_REDUCE2(vec3, vec3_exact_equals)
+B_REDUCE2(vec3, vec3_equals)
+
+// vec4.h
+B_CREATE(vec4)
+B_CREATE(vec4a)
+B_CLONE(vec4)
+BENCH(vec4_from_values, vec4_free(vec4_from_values(X->f[0], 1.f, 1.f, 1.f)))
+B_UNARY(vec4, vec4_copy)
+B_OUT(vec4, vec4_zero)
+BENCH(vec4_set, vec4_set(&X->vec4, CHAIN(1.f), 1.f, 1.f, 1.f))
+B_BINARY(vec4, vec4_add)
+B_BINARY(vec4, vec4_subtract)
+B_BINARY(vec4, vec4_multiply)
+B_BINARY(vec4, vec4_divide)
+B_UNARY(vec4, vec4_ceil)
+B_UNARY(vec4, vec4_floor)
+B_BINARY(vec4, vec4_min)
+B_BINARY(vec4, vec4_max)
+B_UNARY(vec4, vec4_round)
+B_SCALAR(vec4, vec4_scale)
+BENCH(vec4_scale_and_add, vec4_scale_and_add(&X->vec4, &X->vec4, &Y->vec4, CHAIN(1.f)))
+B_REDUCE2(vec4, vec4_distance)
+B_REDUCE2(vec4, vec4_distance_squared)
+B_REDUCE1(vec4, vec4_length)
+B_REDUCE1(vec4, vec4_length_squared)
+B_UNARY(vec4, vec4_negate)
+B_UNARY(vec4, vec4_inverse)
+B_UNARY(vec4, vec4_normalize)
+B_REDUCE2(vec4, vec4_dot)
+BENCH(vec4_cross, vec4_cross(&X->vec4, &X->vec4, &Y->vec4, &Z->vec4))
+B_LERP(vec4, vec4_lerp)
+BENCH(vec4_random, vec4_random(&X->vec4, CHAIN(1.f)))
+BENCH(vec4_transform_mat4, vec4_transform_mat4(&X->vec4, &X->vec4, (mat4 *) &Y->mat4))
+B_REDUCE2(vec4, vec4_exact_equals)
+B_REDUCE2(vec4, vec4_equals)
+
+// soa.h
+#define V3S(k) bench_vec3_soas[k]
+#define V4S(k) bench_vec4_soas[k]
+#define QS(k) bench_quat_soas[k]
+BENCH(vec3_soa_create, vec3_soa_free(vec3_soa_create(BENCH_BATCH)))
+BENCH(vec4_soa_create, vec4_soa_free(vec4_soa_create(BENCH_BATCH)))
+BENCH(quat_soa_create, quat_soa_free(quat_soa_create(BENCH_BATCH)))
+BENCH(vec3_soa_get, vec3_soa_get(&X->vec3, V3S(0), it & S->mask))
+BENCH(vec3_soa_set, vec3_soa_set(V3S(0), it & S->mask, &X->vec3))
+BENCH(vec4_soa_get, vec4_soa_get(&X->vec4, V4S(0), it & S->mask))
+BENCH(vec4_soa_set, vec4_soa_set(V4S(0), it & S->mask, &X->vec4))
+BENCH(quat_soa_get, quat_soa_get(&X->quat, QS(0), it & S->mask))
+BENCH(quat_soa_set, quat_soa_set(QS(0), it & S->mask, &X->quat))
+BENCH_BATCH_CASE(vec3_soa_from_vec3, vec3_soa_from_vec3(V3S(0), bench_vec3s[0]))
+BENCH_BATCH_CASE(vec3_soa_to_vec3, vec3_soa_to_vec3(bench_vec3s[0], V3S(0)))
+BENCH_BATCH_CASE(vec4_soa_from_vec4, vec4_soa_from_vec4(V4S(0), bench_vec4s))
+BENCH_BATCH_CASE(vec4_soa_to_vec4, vec4_soa_to_vec4(bench_vec4s, V4S(0)))
+BENCH_BATCH_CASE(quat_soa_from_quat, quat_soa_from_quat(QS(0), bench_quats[0]))
+BENCH_BATCH_CASE(quat_soa_to_quat, quat_soa_to_quat(bench_quats[0], QS(0)))
+BENCH_BATCH_CASE(vec3_soa_add, vec3_soa_add(V3S(0), V3S(0), V3S(1)))
+BENCH_BATCH_CASE(vec3_soa_scale_and_add, vec3_soa_scale_and_add(V3S(0), V3S(0), V3S(1), .5f))
+BENCH_BATCH_CASE(vec3_soa_dot, vec3_soa_dot(bench_floats[0], V3S(0), V3S(1)))
+BENCH_BATCH_CASE(vec3_soa_cross, vec3_soa_cross(V3S(0), V3S(0), V3S(1)))
+BENCH_BATCH_CASE(vec3_soa_normalize, vec3_soa_normalize(V3S(0), V3S(0)))
+BENCH_BATCH_CASE(vec3_soa_lerp, vec3_soa_lerp(V3S(0), V3S(0), V3S(1), .5f))
+BENCH_BATCH_CASE(vec3_soa_transform_mat4, vec3_soa_transform_mat4(V3S(0), V3S(0), &bench_mat4s[0][0]))
+BENCH_BATCH_CASE(vec4_soa_add, vec4_soa_add(V4S(0), V4S(0), V4S(1)))
+BENCH_BATCH_CASE(vec4_soa_scale_and_add, vec4_soa_scale_and_add(V4S(0), V4S(0), V4S(1), .5f))
+BENCH_BATCH_CASE(vec4_soa_dot, vec4_soa_dot(bench_floats[0], V4S(0), V4S(1)))
+BENCH_BATCH_CASE(vec4_soa_normalize, vec4_soa_normalize(V4S(0), V4S(0)))
+BENCH_BATCH_CASE(vec4_soa_lerp, vec4_soa_lerp(V4S(0), V4S(0), V4S(1), .5f))
+BENCH_BATCH_CASE(vec4_soa_transform_mat4, vec4_soa_transform_mat4(V4S(0), V4S(0), &bench_mat4s[0][0]))
+BENCH_BATCH_CASE(quat_soa_multiply, quat_soa_multiply(QS(0), QS(0), QS(1)))
+BENCH_BATCH_CASE(quat_soa_normalize, quat_soa_normalize(QS(0), QS(0)))
+#undef V3S
+#undef V4S
+#undef QS
+
+// aabb3.h
+B_CREATE(aabb3)
+B_CLONE(aabb3)
+BENCH(aabb3_from_values, aabb3_free(aabb3_from_values(&X->vec3, &Y->vec3)))
+B_UNARY(aabb3, aabb3_copy)
+BENCH(aabb3_set, aabb3_set(&X->aabb3, &X->vec3, &Y->vec3))
+B_OUT(aabb3, aabb3_empty)
+B_REDUCE1(aabb3, aabb3_is_empty)
+B_BINARY(aabb3, aabb3_union)
+B_BINARY(aabb3, aabb3_intersect)
+BENCH(aabb3_expand, aabb3_expand(&X->aabb3, &X->aabb3, &Y->vec3))
+BENCH(aabb3_inflate, aabb3_inflate(&X->aabb3, &X->aabb3, CHAIN(0.f)))
+BENCH(aabb3_center, aabb3_center(&X->vec3, &X->aabb3))
+BENCH(aabb3_extents, aabb3_extents(&X->vec3, &X->aabb3))
+B_REDUCE1(aabb3, aabb3_surface_area)
+BENCH(aabb3_contains_point, FEED(aabb3_contains_point(&X->aabb3, &Y->vec3)))
+B_REDUCE2(aabb3, aabb3_intersects)
+BENCH(aabb3_transform_mat4, aabb3_transform_mat4(&X->aabb3, &X->aabb3, &Y->mat4))
+BENCH_BATCH_CASE(
+  aabb3_transform_mat4_batch,
+  aabb3_transform_mat4_batch(bench_aabb3s[0], bench_aabb3s[0], bench_mat4s[0], n)
+)
+B_REDUCE2(aabb3, aabb3_exact_equals)
+B_REDUCE2(aabb3, aabb3_equals)
+
+// bvh.h, over bench_bvh_bounds. Rays start inside the grid at (1, 1, 1).
+BENCH(bvh_create, bvh_free(bvh_create(bench_bvh_bounds, BENCH_BATCH, NULL)))
+BENCH(
+  bvh_raycast,
+  FEED(bvh_raycast(
+    bench_bvh, &bench_ones.vec3, &Y->vec3, &(float) { CHAIN(10.f) }, NULL, bench_bvh_ray,
+    &(bench_ray) { &bench_ones.vec3, &Y->vec3 }
+  ))
+)
+BENCH(
+  bvh_occluded,
+  FEED(bvh_occluded(
+    bench_bvh, &bench_ones.vec3, &Y->vec3, CHAIN(10.f), bench_bvh_ray, &(bench_ray) { &bench_ones.vec3, &Y->vec3 }
+  ))
+)
+BENCH(
+  bvh_query_aabb,
+  FEED(bvh_query_aabb(bench_bvh, &bench_aabb3s[1][it % BENCH_BATCH], bench_indices, BENCH_BATCH))
+)
+
+// frustum.h
+BENCH(frustum_from_mat4, frustum_from_mat4(&X->frustum, &Y->mat4))
+BENCH(frustum_intersects_sphere, FEED(frustum_intersects_sphere(&bench_frustum, &X->vec3, CHAIN(1.f))))
+BENCH(frustum_intersects_aabb, FEED(frustum_intersects_aabb(&bench_frustum, &X->vec3, &Y->vec3)))
+BENCH_BATCH_CASE(
+  frustum_cull_spheres,
+  bench_floats[0][0] += (float) frustum_cull_spheres(
+    bench_indices, &bench_frustum, bench_floats[0], bench_floats[1], bench_floats[2], bench_floats[3], n
+  ) * S->zero
+)
+BENCH_BATCH_CASE(
+  frustum_cull_aabbs,
+  bench_floats[0][0] += (float) frustum_cull_aabbs(
+    bench_indices,
+    &bench_frustum,
+    bench_floats[0],
+    bench_floats[1],
+    bench_floats[2],
+    bench_floats[4],
+    bench_floats[5],
+    bench_floats[6],
+    n
+  ) * S->zero
+)
+
+// hierarchy.h
+BENCH(hierarchy_create, hierarchy_free(hierarchy_create(BENCH_BATCH)))
+BENCH(
+  hierarchy_add,
+  if (bench_hierarchy_scratch->count == BENCH_BATCH) {
+    hierarchy_clear(bench_hierarchy_scratch);
+  }
+  FEED(hierarchy_add(bench_hierarchy_scratch, bench_hierarchy_scratch->count == 0 ? -1 : 0))
+)
+BENCH(
+  hierarchy_set_local,
+  hierarchy_set_local(bench_hierarchy, it % BENCH_BATCH, &Y->quat, &X->vec3, &bench_ones.vec3)
+)
+BENCH(hierarchy_mark_dirty, hierarchy_mark_dirty(bench_hierarchy, it % BENCH_BATCH))
+// Marking the last node updates one leaf, marking the root updates all BENCH_BATCH nodes
+BENCH_BATCH_CASE(
+  hierarchy_update,
+  hierarchy_mark_dirty(bench_hierarchy, BENCH_BATCH - n);
+  FEED(hierarchy_update(bench_hierarchy, bench_indices))
+)
+
+// parallel.h, bench_pool has one thread per CPU. At BENCH_BATCH elements the wrappers fit in one
+// chunk and run inline, so they measure the dispatch overhead; mmath_parallel_for splits into
+// single-element chunks and measures waking the workers.
+BENCH(mmath_pool_create, mmath_pool_destroy(mmath_pool_create(1)))
+BENCH(mmath_pool_set_grain, mmath_pool_set_grain(bench_pool, mmath_pool_grain(bench_pool)))
+BENCH_BATCH_CASE(mmath_parallel_for, mmath_parallel_for(bench_pool, n, 1, bench_parallel_scale, bench_floats[0]))
+BENCH_BATCH_CASE(
+  mmath_parallel_vec3_transform_mat4_batch,
+  mmath_parallel_vec3_transform_mat4_batch(
+    bench_pool, bench_vec3s[0], sizeof(vec3), bench_vec3s[0], sizeof(vec3), n, &Y->mat4
+  )
+)
+BENCH_BATCH_CASE(
+  mmath_parallel_mat4_multiply_batch,
+  mmath_parallel_mat4_multiply_batch(bench_pool, bench_mat4s[1], &bench_mat4s[0][0], bench_mat4s[1], n)
+)
+BENCH_BATCH_CASE(
+  mmath_parallel_mat4_from_rotation_translation_scale_batch,
+  mmath_parallel_mat4_from_rotation_translation_scale_batch(
+    bench_pool, bench_mat4s[1], bench_quats[0], bench_vec3s[0], bench_vec3s[1], &Y->mat4, n
+  )
+)
+BENCH_BATCH_CASE(
+  mmath_parallel_skin_lbs,
+  mmath_parallel_skin_lbs(
+    bench_pool,
+    &(mmath_skin_desc) {
+      .count = n,
+      .influences = 4,
+      .joints = bench_joints,
+      .weights = bench_weights,
+      .positions = bench_vec3s[0],
+      .position_stride = sizeof(vec3),
+      .out_positions = bench_vec3s[0],
+      .out_position_stride = sizeof(vec3),
+    },
+    bench_mat4s[0]
+  )
+)
+BENCH_BATCH_CASE(
+  mmath_parallel_skin_dqs,
+  mmath_parallel_skin_dqs(
+    bench_pool,
+    &(mmath_skin_desc) {
+      .count = n,
+      .influences = 4,
+      .joints = bench_joints,
+      .weights = bench_weights,
+      .positions = bench_vec3s[0],
+      .position_stride = sizeof(vec3),
+      .out_positions = bench_vec3s[0],
+      .out_position_stride = sizeof(vec3),
+    },
+    bench_quat2s
+  )
+)
+BENCH_BATCH_CASE(
+  mmath_parallel_hierarchy_update,
+  hierarchy_mark_dirty(bench_hierarchy, BENCH_BATCH - n);
+  FEED(mmath_parallel_hierarchy_update(bench_pool, bench_hierarchy, bench_indices))
+)
+BENCH_BATCH_CASE(
+  mmath_parallel_frustum_cull_spheres,
+  bench_floats[0][0] += (float) mmath_parallel_frustum_cull_spheres(
+    bench_pool, bench_indices, &bench_frustum, bench_floats[0], bench_floats[1], bench_floats[2], bench_floats[3], n
+  ) * S->zero
+)
+BENCH_BATCH_CASE(
+  mmath_parallel_frustum_cull_aabbs,
+  bench_floats[0][0] += (float) mmath_parallel_frustum_cull_aabbs(
+    bench_pool,
+    bench_indices,
+    &bench_frustum,
+    bench_floats[0],
+    bench_floats[1],
+    bench_floats[2],
+    bench_floats[4],
+    bench_floats[5],
+    bench_floats[6],
+    n
+  ) * S->zero
+)
+
+// ray3.h
+B_CREATE(ray3)
+B_CLONE(ray3)
+BENCH(ray3_from_values, ray3_free(ray3_from_values(&X->vec3, &Y->vec3)))
+B_UNARY(ray3, ray3_copy)
+BENCH(ray3_set, ray3_set(&X->ray3, &X->vec3, &Y->vec3))
+BENCH(ray3_at, ray3_at(&X->vec3, &Y->ray3, CHAIN(.5f)))
+BENCH(
+  ray3_intersect_triangle,
+  FEED(ray3_intersect_triangle(
+    &bench_ray3s[it & 7], &bench_triangle[0], &bench_triangle[1], &bench_triangle[2], &(float) { CHAIN(10.f) }, &X->vec2
+  ))
+)
+BENCH(ray3_packet_set, ray3_packet_set(&bench_ray3_packet, it & 7, &bench_ray3s[it & 7]))
+BENCH(
+  ray3_triangle_packet_set,
+  ray3_triangle_packet_set(&bench_triangle_packet, it & 7, &bench_triangle[0], &bench_triangle[1], &bench_triangle[2])
+)
+// 8 lanes per call, bench_packet_hit keeps the distances of the first hits so every call hits again
+BENCH(
+  ray3_packet_intersect_triangle,
+  FEED(ray3_packet_intersect_triangle(
+    &bench_packet_hit, &bench_ray3_packet, 8, &bench_triangle[0], &bench_triangle[1], &bench_triangle[2]
+  ))
+)
+BENCH(
+  ray3_intersect_triangle_packet,
+  FEED(ray3_intersect_triangle_packet(&bench_ray3s[it & 7], &bench_triangle_packet, 8, &(float) { CHAIN(10.f) }, &X->vec2))
+)
+
+// skin.h
+BENCH_BATCH_CASE(
+  mmath_skin_dqs,
+  mmath_skin_dqs(
+    &(mmath_skin_desc) {
+      .count = n,
+      .influences = 4,
+      .joints = bench_joints,
+      .weights = bench_weights,
+      .positions = bench_vec3s[0],
+      .position_stride = sizeof(vec3),
+      .out_positions = bench_vec3s[0],
+      .out_position_stride = sizeof(vec3),
+      .normals = bench_vec3s[1],
+      .normal_stride = sizeof(vec3),
+      .out_normals = bench_vec3s[1],
+      .out_normal_stride = sizeof(vec3),
+      .tangents = bench_vec4s,
+      .tangent_stride = sizeof(vec4),
+      .out_tangents = bench_vec4s,
+      .out_tangent_stride = sizeof(vec4),
+    },
+    bench_quat2s
+  )
+)
+BENCH_BATCH_CASE(
+  mmath_skin_lbs,
+  mmath_skin_lbs(
+    &(mmath_skin_desc) {
+      .count = n,
+      .influences = 4,
+      .joints = bench_joints,
+      .weights = bench_weights,
+      .positions = bench_vec3s[0],
+      .position_stride = sizeof(vec3),
+      .out_positions = bench_vec3s[0],
+      .out_position_stride = sizeof(vec3),
+      .normals = bench_vec3s[1],
+      .normal_stride = sizeof(vec3),
+      .out_normals = bench_vec3s[1],
+      .out_normal_stride = sizeof(vec3),
+      .tangents = bench_vec4s,
+      .tangent_stride = sizeof(vec4),
+      .out_tangents = bench_vec4s,
+      .out_tangent_stride = sizeof(vec4),
+    },
+    bench_mat4s[0]
+  )
+)
+
+// xform.h, on the rigid slot matrices
+#define XX (&bench_xforms[0][it & S->mask])
+#define XY (&bench_xforms[1][it & S->mask])
+BENCH(xform_identity, xform_identity(XX); FEED(XX->matrix.data[0]))
+BENCH(xform_from_mat4, xform_from_mat4(XX, &X->mat4); FEED(XX->matrix.data[0]))
+BENCH(xform_from_translation, xform_from_translation(XX, &X->vec4); FEED(XX->matrix.data[12]))
+BENCH(xform_from_scaling, xform_from_scaling(XX, &X->vec4); FEED(XX->matrix.data[0]))
+BENCH(xform_from_rotation, xform_from_rotation(XX, CHAIN(.1f), &Y->vec3); FEED(XX->matrix.data[0]))
+BENCH(xform_from_quat, xform_from_quat(XX, &X->quat); FEED(XX->matrix.data[0]))
+BENCH(xform_from_rotation_translation, xform_from_rotation_translation(XX, &Y->quat, &X->vec3); FEED(XX->matrix.data[0]))
+BENCH(
+  xform_from_rotation_translation_scale,
+  xform_from_rotation_translation_scale(XX, &Y->quat, &X->vec3, &bench_ones.vec3);
+  FEED(XX->matrix.data[0])
+)
+BENCH(xform_look_at, xform_look_at(XX, &X->vec3, &Y->vec3, &Z->vec3); FEED(XX->matrix.data[0]))
+BENCH(xform_ortho, xform_ortho(XX, CHAIN(-1.f), 1.f, -1.f, 1.f, .1f, 100.f); FEED(XX->matrix.data[0]))
+BENCH(xform_perspective, xform_perspective(XX, CHAIN(1.f), 1.f, .1f, 100.f); FEED(XX->matrix.data[0]))
+BENCH(xform_frustum, xform_frustum(XX, CHAIN(-1.f), 1.f, -1.f, 1.f, .1f, 100.f); FEED(XX->matrix.data[0]))
+BENCH(xform_copy, xform_copy(XX, XX))
+BENCH(xform_multiply, xform_multiply(XX, XX, XY))
+BENCH(xform_invert, xform_invert(XX, XX))
+BENCH(xform_transform_point, xform_transform_point(&X->vec3, &X->vec3, XY))
+#undef XX
+#undef XY
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #if defined(_MSC_VER)
     //  Microsoft
@@ -19,26 +20,50 @@
     #pragma warning Unknown dynamic link import/export semantics.
 #endif
 
-typedef union mat2 mat2;
-typedef union mat2d mat2d;
-typedef union mat3 mat3;
-typedef union mat4 mat4;
+// Defining MMATH_INLINE before including mmath turns the small vector and quaternion
+// operations (see mmath/*_inline.h) into static inline functions in the caller.
+// The library is always built with MMATH_BUILD and keeps exporting them.
+#if defined(MMATH_INLINE) && !defined(MMATH_BUILD)
+    #define MMATH_INLINE_API static inline
+#else
+    #define MMATH_INLINE_API MMATH_EXPORT
+#endif
+
+#if defined(_MSC_VER)
+    #define MMATH_ALIGNED(n) __declspec(align(n))
+#else
+    #define MMATH_ALIGNED(n) __attribute__((aligned(n)))
+#endif
+
+#include "mmath/types.h"
 
-typedef union quat quat;
-typedef union quat2 quat2;
+typedef union aabb3 aabb3;
+typedef struct bvh bvh;
+typedef struct frustum frustum;
+typedef struct hierarchy hierarchy;
+typedef union ray3 ray3;
+typedef struct ray3_packet ray3_packet;
+typedef struct ray3_triangle_packet ray3_triangle_packet;
+typedef struct ray3_packet_hit ray3_packet_hit;
+typedef struct mmath_skin_desc mmath_skin_desc;
+typedef struct xform xform;
+typedef struct mmath_pool mmath_pool;
 
-typedef union vec2 vec2;
-typedef union vec3 vec3;
-typedef union vec4 vec4;
+typedef struct vec3_soa vec3_soa;
+typedef struct vec4_soa vec4_soa;
+typedef struct quat_soa quat_soa;
 
 #define MMATH_EPSILON 0.000001f
 
+#include "mmath/alloc.h"
 #include "mmath/common.h"
+#include "mmath/rng.h"
 
 #include "mmath/mat2.h"
 #include "mmath/mat2d.h"
 #include "mmath/mat3.h"
 #include "mmath/mat4.h"
+#include "mmath/mat3x4.h"
 
 #include "mmath/quat.h"
 #include "mmath/quat2.h"
@@ -47,4 +72,16 @@ typedef union vec4 vec4;
 #include "mmath/vec3.h"
 #include "mmath/vec4.h"
 
+#include "mmath/soa.h"
+
+#include "mmath/aabb3.h"
+#include "mmath/bvh.h"
+#include "mmath/frustum.h"
+#include "mmath/hierarchy.h"
+#include "mmath/ray3.h"
+#include "mmath/skin.h"
+#include "mmath/xform.h"
+
+#include "mmath/parallel.h"
+
 #endif // MMATH_H
@@ -0,0 +1,46 @@
+#ifndef MMATH_AABB3_H
+#define MMATH_AABB3_H
+
+#include "mmath.h"
+
+#pragma pack(push,1)
+typedef union aabb3 {
+  float data[6];
+  struct { vec3 min, max; };
+} aabb3;
+#pragma pack(pop)
+
+MMATH_EXPORT aabb3 *aabb3_create();
+MMATH_EXPORT void aabb3_free(aabb3 *a);
+MMATH_EXPORT aabb3 *aabb3_clone(const aabb3 *a);
+MMATH_EXPORT aabb3 *aabb3_from_values(const vec3 *min, const vec3 *max);
+MMATH_EXPORT aabb3 *aabb3_copy(aabb3 *out, const aabb3 *a);
+MMATH_EXPORT aabb3 *aabb3_set(aabb3 *out, const vec3 *min, const vec3 *max);
+
+// An empty box has min = +inf and max = -inf, so expanding or uniting it yields the other operand
+MMATH_EXPORT aabb3 *aabb3_empty(aabb3 *out);
+MMATH_EXPORT bool aabb3_is_empty(const aabb3 *a);
+
+MMATH_EXPORT aabb3 *aabb3_union(aabb3 *out, const aabb3 *a, const aabb3 *b);
+// The result is empty (see aabb3_is_empty) when the boxes do not overlap
+MMATH_EXPORT aabb3 *aabb3_intersect(aabb3 *out, const aabb3 *a, const aabb3 *b);
+MMATH_EXPORT aabb3 *aabb3_expand(aabb3 *out, const aabb3 *a, const vec3 *p);
+MMATH_EXPORT aabb3 *aabb3_inflate(aabb3 *out, const aabb3 *a, float amount);
+
+MMATH_EXPORT vec3 *aabb3_center(vec3 *out, const aabb3 *a);
+MMATH_EXPORT vec3 *aabb3_extents(vec3 *out, const aabb3 *a);
+MMATH_EXPORT float aabb3_surface_area(const aabb3 *a);
+
+MMATH_EXPORT bool aabb3_contains_point(const aabb3 *a, const vec3 *p);
+MMATH_EXPORT bool aabb3_intersects(const aabb3 *a, const aabb3 *b);
+
+// Bounds of an affine transform of the box: the center goes through m, the half extents
+// through the absolute values of its upper 3x3. Empty boxes are not supported.
+MMATH_EXPORT aabb3 *aabb3_transform_mat4(aabb3 *out, const aabb3 *a, const mat4 *m);
+// out[i] = aabb3_transform_mat4(a[i], m[i])
+MMATH_EXPORT void aabb3_transform_mat4_batch(aabb3 *out, const aabb3 *a, const mat4 *m, size_t count);
+
+MMATH_EXPORT bool aabb3_exact_equals(const aabb3 *a, const aabb3 *b);
+MMATH_EXPORT bool aabb3_equals(const aabb3 *a, const aabb3 *b);
+
+#endif // MMATH_AABB3_H
@@ -0,0 +1,31 @@
+#ifndef MMATH_ALLOC_H
+#define MMATH_ALLOC_H
+
+#include "mmath.h"
+
+typedef struct mmath_allocator {
+  void *(*alloc)(size_t size, size_t alignment, void *user);
+  void (*free)(void *ptr, size_t size, size_t alignment, void *user);
+  void *user;
+} mmath_allocator;
+
+typedef struct mmath_arena mmath_arena;
+
+// Replaces the allocator used by every *_create/*_free. Passing NULL restores malloc/free.
+// Must be called before anything is allocated, objects have to be freed by the allocator that created them.
+MMATH_EXPORT void mmath_set_allocator(const mmath_allocator *allocator);
+
+// A bump arena with free lists per size class (16/32/48/64 bytes) and alignment.
+// Between mmath_arena_begin and mmath_arena_end, every *_create on the calling thread is served
+// from the arena and *_free on arena memory recycles it. mmath_arena_reset releases everything
+// in O(1). An arena must only be active on one thread at a time, and its objects must not be
+// freed after mmath_arena_end; reset or destroy the arena instead.
+// Containers that grow or own arrays (hierarchy, bvh, the soa streams and mmath_pool) always
+// use the allocator, with or without an active arena.
+MMATH_EXPORT mmath_arena *mmath_arena_create(size_t block_size);
+MMATH_EXPORT void mmath_arena_destroy(mmath_arena *arena);
+MMATH_EXPORT void mmath_arena_begin(mmath_arena *arena);
+MMATH_EXPORT void mmath_arena_end();
+MMATH_EXPORT void mmath_arena_reset(mmath_arena *arena);
+
+#endif // MMATH_ALLOC_H
@@ -0,0 +1,61 @@
+#ifndef MMATH_BVH_H
+#define MMATH_BVH_H
+
+#include "mmath.h"
+
+// A bounding volume hierarchy over primitive bounds, built with a binned surface area heuristic.
+// Nodes are stored depth first in one array: the left child of an interior node directly follows
+// it and offset is the index of the right child, a leaf covers indices[offset, offset + count).
+typedef struct bvh_node {
+  vec3 min;
+  uint32_t offset;
+  vec3 max;
+  uint32_t count; // 0 for interior nodes
+} bvh_node;
+
+typedef struct bvh {
+  size_t count;
+  size_t node_count;
+  bvh_node *nodes;
+
+  // Primitive indices and their bounds in leaf order
+  uint32_t *indices;
+  aabb3 *bounds;
+} bvh;
+
+// Returns NULL when out of memory. With a pool, the subtrees below the first few splits are
+// built in parallel. The result is the same either way.
+MMATH_EXPORT bvh *bvh_create(const aabb3 *bounds, size_t count, mmath_pool *pool);
+MMATH_EXPORT void bvh_free(bvh *b);
+
+// Tests the ray against primitive `index`. On a hit closer than *t, stores its distance in *t
+// and returns true.
+typedef bool (*bvh_ray_fn)(uint32_t index, float *t, void *user);
+
+// Closest hit along origin + t * direction with t in [0, *t]. Only the primitives whose leaf
+// boxes the ray enters are passed to fn. On a hit, *t is its distance and *hit (if not NULL)
+// the primitive index.
+MMATH_EXPORT bool bvh_raycast(
+  const bvh *b,
+  const vec3 *origin,
+  const vec3 *direction,
+  float *t,
+  uint32_t *hit,
+  bvh_ray_fn fn,
+  void *user
+);
+// Stops at the first hit within [0, t], for shadow and line of sight rays
+MMATH_EXPORT bool bvh_occluded(
+  const bvh *b,
+  const vec3 *origin,
+  const vec3 *direction,
+  float t,
+  bvh_ray_fn fn,
+  void *user
+);
+
+// Writes the indices of the primitives whose bounds overlap box to out, up to capacity of them,
+// and returns how many overlap in total
+MMATH_EXPORT size_t bvh_query_aabb(const bvh *b, const aabb3 *box, uint32_t *out, size_t capacity);
+
+#endif // MMATH_BVH_H
@@ -3,6 +3,22 @@
 
 #include "mmath.h"
 
+typedef enum mmath_backend {
+  MMATH_BACKEND_SCALAR = 0,
+  MMATH_BACKEND_SSE41,
+  MMATH_BACKEND_AVX2
+} mmath_backend;
+
+// Uniform in [0, 1), drawn from the generator of the calling thread (see mmath/rng.h)
 MMATH_EXPORT float mmath_random();
 
+// s[i] = sin(x[i]), c[i] = cos(x[i]). At most 2 ulp of error for |x| <= 128,
+// larger inputs fall back to libm. Either output may be NULL.
+MMATH_EXPORT void mmath_sincosf_batch(float *s, float *c, const float *x, size_t count);
+
+// Kernel set picked at load time from CPUID. Can be lowered (never raised) by setting
+// the MMATH_BACKEND environment variable to "scalar", "sse4.1" or "avx2".
+MMATH_EXPORT mmath_backend mmath_get_backend();
+MMATH_EXPORT const char *mmath_backend_name(mmath_backend backend);
+
 #endif // MMATH_COMMON_H
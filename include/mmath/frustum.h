@@ -0,0 +1,43 @@
+#ifndef MMATH_FRUSTUM_H
+#define MMATH_FRUSTUM_H
+
+#include "mmath.h"
+
+// Six planes (x, y, z, w) with normals pointing inside, a point p is inside a plane when
+// dot(plane.xyz, p) + plane.w >= 0. Planes are ordered left, right, bottom, top, near, far.
+typedef struct frustum {
+  vec4 planes[6];
+} frustum;
+
+// Extracts the planes of a view-projection matrix with OpenGL clip space (z in [-w, w]),
+// as produced by mat4_perspective/mat4_ortho. Planes are normalized.
+MMATH_EXPORT frustum *frustum_from_mat4(frustum *out, const mat4 *m);
+
+MMATH_EXPORT bool frustum_intersects_sphere(const frustum *f, const vec3 *center, float radius);
+MMATH_EXPORT bool frustum_intersects_aabb(const frustum *f, const vec3 *min, const vec3 *max);
+
+// Batch culling over SoA inputs. Indices of the objects that are at least partially inside
+// are written to `out` in ascending order, which must have room for `count` entries.
+// Returns the number of visible objects.
+MMATH_EXPORT size_t frustum_cull_spheres(
+  uint32_t *out,
+  const frustum *f,
+  const float *x,
+  const float *y,
+  const float *z,
+  const float *radius,
+  size_t count
+);
+MMATH_EXPORT size_t frustum_cull_aabbs(
+  uint32_t *out,
+  const frustum *f,
+  const float *min_x,
+  const float *min_y,
+  const float *min_z,
+  const float *max_x,
+  const float *max_y,
+  const float *max_z,
+  size_t count
+);
+
+#endif // MMATH_FRUSTUM_H
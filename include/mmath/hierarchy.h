@@ -0,0 +1,43 @@
+#ifndef MMATH_HIERARCHY_H
+#define MMATH_HIERARCHY_H
+
+#include "mmath.h"
+
+// A transform hierarchy stored as parallel arrays in breadth-first order: every node comes
+// after its parent and depths never decrease, so one linear pass updates all world matrices.
+// The local TRS arrays may be written directly as long as the node is marked dirty afterwards.
+typedef struct hierarchy {
+  size_t count;
+  size_t capacity;
+
+  int32_t *parents; // -1 for roots
+  uint32_t *depths;
+  quat *rotations;
+  vec3 *translations;
+  vec3 *scales;
+  mat4 *worlds;
+  uint8_t *dirty;
+
+  // Lowest dirty index, count when nothing is dirty
+  size_t first_dirty;
+} hierarchy;
+
+MMATH_EXPORT hierarchy *hierarchy_create(size_t capacity);
+MMATH_EXPORT void hierarchy_free(hierarchy *h);
+MMATH_EXPORT void hierarchy_clear(hierarchy *h);
+
+// Appends a node with an identity local transform and returns its index. Returns -1 if the
+// parent does not exist or the node would break the breadth-first order (its depth would be
+// lower than the depth of the last node).
+MMATH_EXPORT int32_t hierarchy_add(hierarchy *h, int32_t parent);
+
+MMATH_EXPORT void hierarchy_set_local(hierarchy *h, size_t index, const quat *r, const vec3 *t, const vec3 *s);
+MMATH_EXPORT void hierarchy_mark_dirty(hierarchy *h, size_t index);
+
+// Recomputes the world matrices of the dirty nodes and their descendants and clears the
+// dirty flags. Writes the updated indices in ascending order to `updated` when it is not NULL
+// (it must have room for h->count entries) and returns how many nodes were updated.
+// mmath_parallel_hierarchy_update does the same on a thread pool.
+MMATH_EXPORT size_t hierarchy_update(hierarchy *h, uint32_t *updated);
+
+#endif // MMATH_HIERARCHY_H
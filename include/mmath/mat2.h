@@ -3,17 +3,10 @@
 
 #include "mmath.h"
 
-#pragma pack(push,1)
-typedef union mat2 {
-  float data[4];
-  struct {
-    float m00, m01, m10, m11;
-  };
-} mat2;
-#pragma pack(pop)
-
 MMATH_EXPORT mat2 *mat2_create();
 MMATH_EXPORT void mat2_free(mat2 *a);
+MMATH_EXPORT mat2a *mat2a_create();
+MMATH_EXPORT void mat2a_free(mat2a *a);
 MMATH_EXPORT mat2 *mat2_clone(const mat2 *a);
 MMATH_EXPORT mat2 *mat2_from_values(float m00, float m01, float m10, float m11);
 
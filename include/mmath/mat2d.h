@@ -3,17 +3,10 @@
 
 #include "mmath.h"
 
-#pragma pack(push,1)
-typedef union mat2d {
-  float data[6];
-  struct {
-    float a, b, c, d, tx, ty;
-  };
-} mat2d;
-#pragma pack(pop)
-
 MMATH_EXPORT mat2d *mat2d_create();
 MMATH_EXPORT void mat2d_free(mat2d *a);
+MMATH_EXPORT mat2da *mat2da_create();
+MMATH_EXPORT void mat2da_free(mat2da *a);
 MMATH_EXPORT mat2d *mat2d_clone(const mat2d *a);
 MMATH_EXPORT mat2d *mat2d_from_values(float a, float b, float c, float d, float tx, float ty);
 
@@ -3,17 +3,10 @@
 
 #include "mmath.h"
 
-#pragma pack(push,1)
-typedef union mat3 {
-  float data[9];
-  struct {
-    float m00, m01, m02, m10, m11, m12, m20, m21, m22;
-  };
-} mat3;
-#pragma pack(pop)
-
 MMATH_EXPORT mat3 *mat3_create();
 MMATH_EXPORT void mat3_free(mat3 *a);
+MMATH_EXPORT mat3a *mat3a_create();
+MMATH_EXPORT void mat3a_free(mat3a *a);
 MMATH_EXPORT mat3 *mat3_clone(const mat3 *a);
 MMATH_EXPORT mat3 *mat3_from_values(
   float m00,
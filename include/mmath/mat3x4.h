@@ -0,0 +1,64 @@
+#ifndef MMATH_MAT3X4_H
+#define MMATH_MAT3X4_H
+
+#include "mmath.h"
+
+MMATH_EXPORT mat3x4 *mat3x4_create();
+MMATH_EXPORT void mat3x4_free(mat3x4 *a);
+MMATH_EXPORT mat3x4a *mat3x4a_create();
+MMATH_EXPORT void mat3x4a_free(mat3x4a *a);
+MMATH_EXPORT mat3x4 *mat3x4_clone(const mat3x4 *a);
+
+MMATH_EXPORT mat3x4 *mat3x4_copy(mat3x4 *out, const mat3x4 *a);
+MMATH_EXPORT mat3x4 *mat3x4_identity(mat3x4 *out);
+
+// Drops the bottom row, which is assumed to be (0, 0, 0, 1). See mat4_from_mat3x4 for the other way.
+MMATH_EXPORT mat3x4 *mat3x4_from_mat4(mat3x4 *out, const mat4 *a);
+MMATH_EXPORT mat3x4 *mat3x4_from_rotation_translation_scale(
+  mat3x4 *out,
+  const quat *q,
+  const vec3 *v,
+  const vec3 *s
+);
+
+MMATH_EXPORT mat3x4 *mat3x4_multiply(mat3x4 *out, const mat3x4 *a, const mat3x4 *b);
+// Returns NULL when the upper 3x3 is singular
+MMATH_EXPORT mat3x4 *mat3x4_invert(mat3x4 *out, const mat3x4 *a);
+
+MMATH_EXPORT vec3 *mat3x4_transform_point(vec3 *out, const vec3 *a, const mat3x4 *m);
+// Ignores the translation, for directions and offsets
+MMATH_EXPORT vec3 *mat3x4_transform_vector(vec3 *out, const vec3 *a, const mat3x4 *m);
+
+// Batch versions, out[i] = f(a[i], b[i]). mat3x4_invert_batch reports singular elements like mat4_invert_batch.
+MMATH_EXPORT mat3x4 *mat3x4_from_mat4_batch(mat3x4 *out, const mat4 *a, size_t count);
+MMATH_EXPORT mat3x4 *mat3x4_from_rotation_translation_scale_batch(
+  mat3x4 *out,
+  const quat *q,
+  const vec3 *v,
+  const vec3 *s,
+  size_t count
+);
+MMATH_EXPORT mat3x4 *mat3x4_multiply_batch(mat3x4 *out, const mat3x4 *a, const mat3x4 *b, size_t count);
+MMATH_EXPORT size_t mat3x4_invert_batch(mat3x4 *out, const mat3x4 *a, size_t count, uint32_t *failed);
+// Transforms every point by the same matrix, strides are in bytes as in vec3_transform_mat4_batch
+MMATH_EXPORT vec3 *mat3x4_transform_point_batch(
+  vec3 *out,
+  size_t out_stride,
+  const vec3 *a,
+  size_t a_stride,
+  size_t count,
+  const mat3x4 *m
+);
+MMATH_EXPORT vec3 *mat3x4_transform_vector_batch(
+  vec3 *out,
+  size_t out_stride,
+  const vec3 *a,
+  size_t a_stride,
+  size_t count,
+  const mat3x4 *m
+);
+
+MMATH_EXPORT bool mat3x4_exact_equals(const mat3x4 *a, const mat3x4 *b);
+MMATH_EXPORT bool mat3x4_equals(const mat3x4 *a, const mat3x4 *b);
+
+#endif // MMATH_MAT3X4_H
@@ -3,17 +3,10 @@
 
 #include "mmath.h"
 
-#pragma pack(push,1)
-typedef union mat4 {
-  float data[16];
-  struct {
-    float m00, m01, m02, m03, m10, m11, m12, m13, m20, m21, m22, m23, m30, m31, m32, m33;
-  };
-} mat4;
-#pragma pack(pop)
-
 MMATH_EXPORT mat4 *mat4_create();
 MMATH_EXPORT void mat4_free(mat4 *a);
+MMATH_EXPORT mat4a *mat4a_create();
+MMATH_EXPORT void mat4a_free(mat4a *a);
 MMATH_EXPORT mat4 *mat4_clone(const mat4 *a);
 MMATH_EXPORT mat4 *mat4_from_values(
   float m00,
@@ -58,9 +51,32 @@ MMATH_EXPORT mat4 *mat4_set(
 
 MMATH_EXPORT mat4 *mat4_transpose(mat4 *out, const mat4 *a);
 MMATH_EXPORT mat4 *mat4_invert(mat4 *out, const mat4 *a);
+// Inverse of a matrix whose bottom row is (0, 0, 0, 1), returns NULL when the upper 3x3 is singular
+MMATH_EXPORT mat4 *mat4_invert_affine(mat4 *out, const mat4 *a);
+// Inverse of a rotation + translation, the upper 3x3 must be orthonormal
+MMATH_EXPORT mat4 *mat4_invert_rigid(mat4 *out, const mat4 *a);
+// out[i] = inverse of a[i]. Singular elements leave out[i] unchanged and set bit (i % 32) of
+// failed[i / 32], failed may be NULL and otherwise holds (count + 31) / 32 words.
+// Returns the number of singular elements.
+MMATH_EXPORT size_t mat4_invert_batch(mat4 *out, const mat4 *a, size_t count, uint32_t *failed);
+MMATH_EXPORT size_t mat4_invert_affine_batch(mat4 *out, const mat4 *a, size_t count, uint32_t *failed);
+MMATH_EXPORT mat4 *mat4_invert_rigid_batch(mat4 *out, const mat4 *a, size_t count);
 MMATH_EXPORT mat4 *mat4_adjoint(mat4 *out, const mat4 *a);
 MMATH_EXPORT float mat4_determinant(const mat4 *a);
 MMATH_EXPORT mat4 *mat4_multiply(mat4 *out, const mat4 *a, const mat4 *b);
+// out[i] = a * b[i], e.g. view-projection times every model matrix
+MMATH_EXPORT mat4 *mat4_multiply_batch(mat4 *out, const mat4 *a, const mat4 *b, size_t count);
+// out[i] = a[i] * b[i]
+MMATH_EXPORT mat4 *mat4_multiply_pairs_batch(mat4 *out, const mat4 *a, const mat4 *b, size_t count);
+// out[i] = a[indices[i]] * b[i], out must not overlap a.
+// All three may run in place on b and write large results with streaming stores.
+MMATH_EXPORT mat4 *mat4_multiply_indexed_batch(
+  mat4 *out,
+  const mat4 *a,
+  const uint32_t *indices,
+  const mat4 *b,
+  size_t count
+);
 
 MMATH_EXPORT mat4 *mat4_translate(mat4 *out, const mat4 *a, const vec4 *v);
 MMATH_EXPORT mat4 *mat4_rotate(mat4 *out, const mat4 *a, float angle, const vec3 *axis);
@@ -74,13 +90,35 @@ MMATH_EXPORT mat4 *mat4_from_rotation(mat4 *out, float angle, const vec3 *axis);
 MMATH_EXPORT mat4 *mat4_from_rotation_x(mat4 *out, float angle);
 MMATH_EXPORT mat4 *mat4_from_rotation_y(mat4 *out, float angle);
 MMATH_EXPORT mat4 *mat4_from_rotation_z(mat4 *out, float angle);
+// out[i] = mat4_from_rotation_*(angles[i])
+MMATH_EXPORT mat4 *mat4_from_rotation_x_batch(mat4 *out, const float *angles, size_t count);
+MMATH_EXPORT mat4 *mat4_from_rotation_y_batch(mat4 *out, const float *angles, size_t count);
+MMATH_EXPORT mat4 *mat4_from_rotation_z_batch(mat4 *out, const float *angles, size_t count);
 MMATH_EXPORT mat4 *mat4_from_scaling(mat4 *out, const vec4 *v);
 MMATH_EXPORT mat4 *mat4_from_rotation_translation(mat4 *out, const quat *q, const vec3 *v);
 MMATH_EXPORT mat4 *mat4_from_quat2(mat4 *out, const quat2 *a);
+// Expands with the bottom row (0, 0, 0, 1)
+MMATH_EXPORT mat4 *mat4_from_mat3x4(mat4 *out, const mat3x4 *a);
+MMATH_EXPORT mat4 *mat4_from_mat3x4_batch(mat4 *out, const mat3x4 *a, size_t count);
 
 MMATH_EXPORT vec3 *mat4_get_translation(vec3 *out, const mat4 *m);
 MMATH_EXPORT quat *mat4_get_rotation(quat *out, const mat4 *m);
 MMATH_EXPORT vec3 *mat4_get_scaling(vec3 *out, const mat4 *m);
+// Splits the upper 3x3 into rotation * shear * scale in one pass, the shear matrix being unit upper
+// triangular with (xy, xz, yz) above the diagonal. Unlike mat4_get_rotation the rotation has the
+// scale and shear removed. A reflection makes all three scales negative. shear may be NULL.
+// Returns false and writes nothing when the upper 3x3 is singular.
+MMATH_EXPORT bool mat4_decompose(quat *r, vec3 *t, vec3 *s, vec3 *shear, const mat4 *m);
+// Reports singular elements like mat4_invert_batch
+MMATH_EXPORT size_t mat4_decompose_batch(
+  quat *r,
+  vec3 *t,
+  vec3 *s,
+  vec3 *shear,
+  const mat4 *m,
+  size_t count,
+  uint32_t *failed
+);
 
 MMATH_EXPORT mat4 *mat4_from_rotation_translation_scale(
   mat4 *out,
@@ -88,6 +126,25 @@ MMATH_EXPORT mat4 *mat4_from_rotation_translation_scale(
   const vec3 *v,
   const vec3 *s
 );
+// out[i] = parent * TRS(q[i], v[i], s[i]) in one pass, parent may be NULL. The parent is shared,
+// e.g. the model matrix of a skinned mesh, per-node parents are what hierarchy_update is for.
+MMATH_EXPORT mat4 *mat4_from_rotation_translation_scale_batch(
+  mat4 *out,
+  const quat *q,
+  const vec3 *v,
+  const vec3 *s,
+  const mat4 *parent,
+  size_t count
+);
+// Same with the inputs split into x/y/z(/w) arrays, as in quat_slerp_batch_soa
+MMATH_EXPORT mat4 *mat4_from_rotation_translation_scale_batch_soa(
+  mat4 *out,
+  const float *const q[4],
+  const float *const v[3],
+  const float *const s[3],
+  const mat4 *parent,
+  size_t count
+);
 MMATH_EXPORT mat4 *mat4_from_rotation_translation_scale_origin(
   mat4 *out,
   const quat *q,
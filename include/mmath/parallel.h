@@ -0,0 +1,86 @@
+#ifndef MMATH_PARALLEL_H
+#define MMATH_PARALLEL_H
+
+#include "mmath.h"
+
+// A work-stealing thread pool for splitting batch calls across cores. Builds without thread
+// support (MMATH_ENABLE_THREADS=OFF or no pthreads) keep the API with a pool of one thread.
+typedef struct mmath_pool mmath_pool;
+
+// Processes elements [begin, end) of a parallel_for
+typedef void (*mmath_parallel_fn)(size_t begin, size_t end, void *user);
+
+// threads counts the calling thread, which takes part in every parallel_for, so threads - 1
+// workers are started. 0 uses one thread per online CPU. Returns NULL when out of memory.
+MMATH_EXPORT mmath_pool *mmath_pool_create(size_t threads);
+MMATH_EXPORT void mmath_pool_destroy(mmath_pool *pool);
+MMATH_EXPORT size_t mmath_pool_threads(const mmath_pool *pool);
+
+// Elements per chunk for calls that pass a grain of 0, including the mmath_parallel_* batch
+// wrappers. The default of 0 sizes the wrappers' chunks to about 32 KiB of input and output
+// and splits other calls into 8 chunks per thread.
+MMATH_EXPORT void mmath_pool_set_grain(mmath_pool *pool, size_t grain);
+MMATH_EXPORT size_t mmath_pool_grain(const mmath_pool *pool);
+
+// Calls fn over [0, count) in chunks of at most grain elements (0 for the pool default) and
+// returns once all of them are done. Idle threads steal chunks from busy ones.
+// With a NULL or single-thread pool, or when called from inside fn, the chunks run on the
+// calling thread without allocating. Calls from several threads on one pool are serialized.
+MMATH_EXPORT void mmath_parallel_for(mmath_pool *pool, size_t count, size_t grain, mmath_parallel_fn fn, void *user);
+
+// Batch kernels split with mmath_parallel_for, same arguments as the functions they wrap
+MMATH_EXPORT vec3 *mmath_parallel_vec3_transform_mat4_batch(
+  mmath_pool *pool,
+  vec3 *out,
+  size_t out_stride,
+  const vec3 *a,
+  size_t a_stride,
+  size_t count,
+  const mat4 *m
+);
+MMATH_EXPORT mat4 *mmath_parallel_mat4_multiply_batch(
+  mmath_pool *pool,
+  mat4 *out,
+  const mat4 *a,
+  const mat4 *b,
+  size_t count
+);
+MMATH_EXPORT mat4 *mmath_parallel_mat4_from_rotation_translation_scale_batch(
+  mmath_pool *pool,
+  mat4 *out,
+  const quat *q,
+  const vec3 *v,
+  const vec3 *s,
+  const mat4 *parent,
+  size_t count
+);
+MMATH_EXPORT void mmath_parallel_skin_lbs(mmath_pool *pool, const mmath_skin_desc *desc, const mat4 *palette);
+MMATH_EXPORT void mmath_parallel_skin_dqs(mmath_pool *pool, const mmath_skin_desc *desc, const quat2 *bones);
+// Same results as hierarchy_update. Nodes wait only for their own parents to be written instead
+// of for the whole level above, so consecutive levels overlap.
+MMATH_EXPORT size_t mmath_parallel_hierarchy_update(mmath_pool *pool, hierarchy *h, uint32_t *updated);
+// Chunks are culled in parallel and compacted afterwards, so out is in ascending order as well
+MMATH_EXPORT size_t mmath_parallel_frustum_cull_spheres(
+  mmath_pool *pool,
+  uint32_t *out,
+  const frustum *f,
+  const float *x,
+  const float *y,
+  const float *z,
+  const float *radius,
+  size_t count
+);
+MMATH_EXPORT size_t mmath_parallel_frustum_cull_aabbs(
+  mmath_pool *pool,
+  uint32_t *out,
+  const frustum *f,
+  const float *min_x,
+  const float *min_y,
+  const float *min_z,
+  const float *max_x,
+  const float *max_y,
+  const float *max_z,
+  size_t count
+);
+
+#endif // MMATH_PARALLEL_H
@@ -3,11 +3,52 @@
 
 #include "mmath.h"
 
-#pragma pack(push,1)
-typedef union quat2 {
-  float data[8];
-  struct { float x1, y1, z1, w1, x2, y2, z2, w2; };
-} quat2;
-#pragma pack(pop)
+MMATH_EXPORT quat2 *quat2_create();
+MMATH_EXPORT void quat2_free(quat2 *a);
+MMATH_EXPORT quat2a *quat2a_create();
+MMATH_EXPORT void quat2a_free(quat2a *a);
+MMATH_EXPORT quat2 *quat2_clone(const quat2 *a);
+MMATH_EXPORT quat2 *quat2_from_values(float x1, float y1, float z1, float w1, float x2, float y2, float z2, float w2);
+MMATH_EXPORT quat2 *quat2_from_rotation_translation_values(float x1, float y1, float z1, float w1, float x2, float y2, float z2);
+MMATH_EXPORT quat2 *quat2_from_rotation_translation(quat2 *out, const quat *q, const vec3 *t);
+MMATH_EXPORT quat2 *quat2_from_translation(quat2 *out, const vec3 *t);
+MMATH_EXPORT quat2 *quat2_from_rotation(quat2 *out, const quat *q);
+MMATH_EXPORT quat2 *quat2_from_mat4(quat2 *out, const mat4 *a);
+MMATH_EXPORT quat2 *quat2_copy(quat2 *out, const quat2 *a);
+MMATH_EXPORT quat2 *quat2_identity(quat2 *out);
+MMATH_EXPORT quat2 *quat2_set(quat2 *out, float x1, float y1, float z1, float w1, float x2, float y2, float z2, float w2);
+
+MMATH_EXPORT quat *quat2_get_real(quat *out, const quat2 *a);
+MMATH_EXPORT quat *quat2_get_dual(quat *out, const quat2 *a);
+MMATH_EXPORT quat2 *quat2_set_real(quat2 *out, const quat *q);
+MMATH_EXPORT quat2 *quat2_set_dual(quat2 *out, const quat *q);
+MMATH_EXPORT vec3 *quat2_get_translation(vec3 *out, const quat2 *a);
+
+MMATH_EXPORT quat2 *quat2_translate(quat2 *out, const quat2 *a, const vec3 *v);
+MMATH_EXPORT quat2 *quat2_rotate_x(quat2 *out, const quat2 *a, float angle);
+MMATH_EXPORT quat2 *quat2_rotate_y(quat2 *out, const quat2 *a, float angle);
+MMATH_EXPORT quat2 *quat2_rotate_z(quat2 *out, const quat2 *a, float angle);
+MMATH_EXPORT quat2 *quat2_rotate_by_quat_append(quat2 *out, const quat2 *a, const quat *q);
+MMATH_EXPORT quat2 *quat2_rotate_by_quat_prepend(quat2 *out, const quat *q, const quat2 *a);
+MMATH_EXPORT quat2 *quat2_rotate_around_axis(quat2 *out, const quat2 *a, const vec3 *axis, float angle);
+
+MMATH_EXPORT quat2 *quat2_add(quat2 *out, const quat2 *a, const quat2 *b);
+MMATH_EXPORT quat2 *quat2_multiply(quat2 *out, const quat2 *a, const quat2 *b);
+MMATH_EXPORT quat2 *quat2_scale(quat2 *out, const quat2 *a, float b);
+
+MMATH_EXPORT float quat2_dot(const quat2 *a, const quat2 *b);
+MMATH_EXPORT quat2 *quat2_lerp(quat2 *out, const quat2 *a, const quat2 *b, float t);
+// Screw linear interpolation, constant speed along the shortest screw motion from a to b
+MMATH_EXPORT quat2 *quat2_sclerp(quat2 *out, const quat2 *a, const quat2 *b, float t);
+
+MMATH_EXPORT quat2 *quat2_invert(quat2 *out, const quat2 *a);
+MMATH_EXPORT quat2 *quat2_conjugate(quat2 *out, const quat2 *a);
+
+MMATH_EXPORT float quat2_length(const quat2 *a);
+MMATH_EXPORT float quat2_length_squared(const quat2 *a);
+MMATH_EXPORT quat2 *quat2_normalize(quat2 *out, const quat2 *a);
+
+MMATH_EXPORT bool quat2_exact_equals(const quat2 *a, const quat2 *b);
+MMATH_EXPORT bool quat2_equals(const quat2 *a, const quat2 *b);
 
 #endif // MMATH_QUAT2_H
@@ -0,0 +1,117 @@
+#ifndef MMATH_QUAT_INLINE_H
+#define MMATH_QUAT_INLINE_H
+
+// Compiled into src/mmath/quat.c, or into the caller when MMATH_INLINE is defined
+
+#include <math.h>
+#include <string.h>
+
+#include "mmath/quat.h"
+
+MMATH_INLINE_API quat *quat_copy(quat *out, const quat *a) {
+  memcpy(out->data, a->data, sizeof(a->data));
+  return out;
+}
+
+MMATH_INLINE_API quat *quat_identity(quat *out) {
+  return quat_set(out, 0.f, 0.f, 0.f, 1.f);
+}
+
+MMATH_INLINE_API quat *quat_set(quat *out, float x, float y, float z, float w) {
+  out->x = x;
+  out->y = y;
+  out->z = z;
+  out->w = w;
+  return out;
+}
+
+MMATH_INLINE_API quat *quat_multiply(quat *out, const quat *a, const quat *b) {
+  float ax = a->x;
+  float ay = a->y;
+  float az = a->z;
+  float aw = a->w;
+  float bx = b->x;
+  float by = b->y;
+  float bz = b->z;
+  float bw = b->w;
+
+  out->x = ax * bw + aw * bx + ay * bz - az * by;
+  out->y = ay * bw + aw * by + az * bx - ax * bz;
+  out->z = az * bw + aw * bz + ax * by - ay * bx;
+  out->w = aw * bw - ax * bx - ay * by - az * bz;
+  return out;
+}
+
+MMATH_INLINE_API quat *quat_add(quat *out, const quat *a, const quat *b) {
+  out->x = a->x + b->x;
+  out->y = a->y + b->y;
+  out->z = a->z + b->z;
+  out->w = a->w + b->w;
+  return out;
+}
+
+MMATH_INLINE_API quat *quat_scale(quat *out, const quat *a, float b) {
+  out->x = a->x * b;
+  out->y = a->y * b;
+  out->z = a->z * b;
+  out->w = a->w * b;
+  return out;
+}
+
+MMATH_INLINE_API float quat_dot(const quat *a, const quat *b) {
+  return a->x * b->x + a->y * b->y + a->z * b->z + a->w * b->w;
+}
+
+MMATH_INLINE_API quat *quat_lerp(quat *out, const quat *a, const quat *b, float t) {
+  float x = a->x;
+  float y = a->y;
+  float z = a->z;
+  float w = a->w;
+
+  out->x = x + t * (b->x - x);
+  out->y = y + t * (b->y - y);
+  out->z = z + t * (b->z - z);
+  out->w = w + t * (b->w - w);
+  return out;
+}
+
+MMATH_INLINE_API float quat_length(const quat *a) {
+  return sqrtf(quat_length_squared(a));
+}
+
+MMATH_INLINE_API float quat_length_squared(const quat *a) {
+  float x = a->x;
+  float y = a->y;
+  float z = a->z;
+  float w = a->w;
+
+  return x * x + y * y + z * z + w * w;
+}
+
+MMATH_INLINE_API quat *quat_normalize(quat *out, const quat *a) {
+  float x = a->x;
+  float y = a->y;
+  float z = a->z;
+  float w = a->w;
+
+  float len = x * x + y * y + z * z + w * w;
+  if (len > 0) {
+    len = 1.f / sqrtf(len);
+  }
+
+  out->x = x * len;
+  out->y = y * len;
+  out->z = z * len;
+  out->w = w * len;
+  return out;
+}
+
+MMATH_INLINE_API quat *quat_conjugate(quat *out, const quat *a) {
+  out->x = -a->x;
+  out->y = -a->y;
+  out->z = -a->z;
+  out->w =  a->w;
+  return out;
+}
+
+#endif // MMATH_QUAT_INLINE_H
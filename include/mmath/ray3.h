@@ -0,0 +1,87 @@
+#ifndef MMATH_RAY3_H
+#define MMATH_RAY3_H
+
+#include "mmath.h"
+
+// Points origin + t * direction, direction does not have to be normalized
+#pragma pack(push,1)
+typedef union ray3 {
+  float data[6];
+  struct { vec3 origin, direction; };
+} ray3;
+#pragma pack(pop)
+
+// Up to 8 rays or triangles with one array per component, lane i of each array belongs to ray
+// (or triangle) i. The packet tests below take a count of 1 to 8 and ignore the lanes past it.
+// 8 lanes run as two 4-wide SSE2 halves whatever mmath_get_backend() reports, an AVX2 version
+// measured slower, so counts of 4 or less do half the work.
+typedef struct MMATH_ALIGNED(32) ray3_packet {
+  float origin[3][8];
+  float direction[3][8];
+} ray3_packet;
+
+// A vertex and the two edges leaving it, which is what the intersection test works with
+typedef struct MMATH_ALIGNED(32) ray3_triangle_packet {
+  float vertex[3][8];
+  float edge1[3][8];
+  float edge2[3][8];
+} ray3_triangle_packet;
+
+typedef struct MMATH_ALIGNED(32) ray3_packet_hit {
+  float t[8];
+  float u[8];
+  float v[8];
+} ray3_packet_hit;
+
+// ray3_create returns a zeroed ray
+MMATH_EXPORT ray3 *ray3_create();
+MMATH_EXPORT void ray3_free(ray3 *a);
+MMATH_EXPORT ray3 *ray3_clone(const ray3 *a);
+MMATH_EXPORT ray3 *ray3_from_values(const vec3 *origin, const vec3 *direction);
+MMATH_EXPORT ray3 *ray3_copy(ray3 *out, const ray3 *a);
+MMATH_EXPORT ray3 *ray3_set(ray3 *out, const vec3 *origin, const vec3 *direction);
+MMATH_EXPORT vec3 *ray3_at(vec3 *out, const ray3 *a, float t);
+
+// Moller-Trumbore, both faces count and rays in the plane of the triangle miss. On a hit with
+// t in [0, *t], stores t in *t and the barycentrics (u, v) of b and c in *uv (if not NULL), so
+// the hit point is (1 - u - v) * a + u * b + v * c.
+MMATH_EXPORT bool ray3_intersect_triangle(
+  const ray3 *r,
+  const vec3 *a,
+  const vec3 *b,
+  const vec3 *c,
+  float *t,
+  vec2 *uv
+);
+
+MMATH_EXPORT ray3_packet *ray3_packet_set(ray3_packet *out, size_t lane, const ray3 *r);
+MMATH_EXPORT ray3_triangle_packet *ray3_triangle_packet_set(
+  ray3_triangle_packet *out,
+  size_t lane,
+  const vec3 *a,
+  const vec3 *b,
+  const vec3 *c
+);
+
+// Tests count rays against one triangle. hit->t holds the maximum distance of each ray and the
+// rays that hit within it get their t, u and v lanes updated, so a packet can be run over a
+// list of triangles to find the closest hits. Returns a mask with bit i set when ray i hit.
+MMATH_EXPORT uint32_t ray3_packet_intersect_triangle(
+  ray3_packet_hit *hit,
+  const ray3_packet *rays,
+  size_t count,
+  const vec3 *a,
+  const vec3 *b,
+  const vec3 *c
+);
+// Tests one ray against count triangles, same as ray3_intersect_triangle with the closest of
+// them. Returns the lane of the triangle that was hit (the lowest one on a tie) or -1.
+MMATH_EXPORT int ray3_intersect_triangle_packet(
+  const ray3 *r,
+  const ray3_triangle_packet *triangles,
+  size_t count,
+  float *t,
+  vec2 *uv
+);
+
+#endif // MMATH_RAY3_H
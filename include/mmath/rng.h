@@ -0,0 +1,32 @@
+#ifndef MMATH_RNG_H
+#define MMATH_RNG_H
+
+#include "mmath.h"
+
+// xoshiro128** generator. The state is plain data, so it can live on the stack or inside
+// other objects; it must not be shared between threads without external locking.
+typedef struct mmath_rng {
+  uint32_t s[4];
+} mmath_rng;
+
+MMATH_EXPORT mmath_rng *mmath_rng_create(uint64_t seed);
+MMATH_EXPORT void mmath_rng_free(mmath_rng *rng);
+// Expands the seed with splitmix64, any value including 0 is fine
+MMATH_EXPORT mmath_rng *mmath_rng_seed(mmath_rng *rng, uint64_t seed);
+
+// Generator of the calling thread, used by mmath_random and the *_random functions.
+// Each thread starts from a different seed unless mmath_random_seed is called.
+MMATH_EXPORT mmath_rng *mmath_rng_thread();
+MMATH_EXPORT void mmath_random_seed(uint64_t seed);
+
+MMATH_EXPORT uint32_t mmath_rng_next(mmath_rng *rng);
+// Uniform in [0, 1)
+MMATH_EXPORT float mmath_rng_float(mmath_rng *rng);
+
+MMATH_EXPORT void mmath_rng_fill_float(mmath_rng *rng, float *out, size_t count);
+// Uniformly distributed points on the unit sphere
+MMATH_EXPORT void mmath_rng_fill_unit_vec3(mmath_rng *rng, vec3 *out, size_t count);
+// Uniformly distributed unit quaternions (rotations)
+MMATH_EXPORT void mmath_rng_fill_unit_quat(mmath_rng *rng, quat *out, size_t count);
+
+#endif // MMATH_RNG_H
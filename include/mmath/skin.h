@@ -0,0 +1,40 @@
+#ifndef MMATH_SKIN_H
+#define MMATH_SKIN_H
+
+#include "mmath.h"
+
+// Vertex streams for the skinning kernels. Strides are in bytes, so interleaved vertex
+// buffers work directly. Normal and tangent streams are optional, set them to NULL to skip them.
+// Tangents carry the bitangent sign in w, which is copied through unchanged.
+typedef struct mmath_skin_desc {
+  size_t count;
+
+  // Per vertex, `influences` joint indices into the bone palette and their weights
+  size_t influences;
+  const uint16_t *joints;
+  const float *weights;
+
+  const vec3 *positions;
+  size_t position_stride;
+  vec3 *out_positions;
+  size_t out_position_stride;
+
+  const vec3 *normals;
+  size_t normal_stride;
+  vec3 *out_normals;
+  size_t out_normal_stride;
+
+  const vec4 *tangents;
+  size_t tangent_stride;
+  vec4 *out_tangents;
+  size_t out_tangent_stride;
+} mmath_skin_desc;
+
+// Dual quaternion skinning, blends up to 4 unit bone dual quaternions per vertex
+MMATH_EXPORT void mmath_skin_dqs(const mmath_skin_desc *desc, const quat2 *bones);
+
+// Linear blend skinning, blends up to 8 affine bone matrices per vertex.
+// Normals and tangents go through the blended upper 3x3 and are renormalized.
+MMATH_EXPORT void mmath_skin_lbs(const mmath_skin_desc *desc, const mat4 *palette);
+
+#endif // MMATH_SKIN_H
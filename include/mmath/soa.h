@@ -0,0 +1,80 @@
+#ifndef MMATH_SOA_H
+#define MMATH_SOA_H
+
+#include "mmath.h"
+
+// Streams of vectors stored as one array per component. Each array is 32-byte aligned and padded
+// to a multiple of 8 floats, and data[] aliases the named arrays so a stream can be passed to
+// the *_batch_soa functions (e.g. quat_slerp_batch_soa(out->data, ...)). Streams assembled by
+// hand from other arrays must keep that alignment.
+//
+// The operations below process a->count elements (the first input), out and the other inputs
+// must hold at least that many. out may be one of the inputs.
+typedef struct vec3_soa {
+  union {
+    float *data[3];
+    struct { float *x, *y, *z; };
+  };
+  size_t count;
+} vec3_soa;
+
+typedef struct vec4_soa {
+  union {
+    float *data[4];
+    struct { float *x, *y, *z, *w; };
+  };
+  size_t count;
+} vec4_soa;
+
+typedef struct quat_soa {
+  union {
+    float *data[4];
+    struct { float *x, *y, *z, *w; };
+  };
+  size_t count;
+} quat_soa;
+
+// Returns NULL when out of memory. The arrays are zeroed.
+MMATH_EXPORT vec3_soa *vec3_soa_create(size_t count);
+MMATH_EXPORT void vec3_soa_free(vec3_soa *a);
+MMATH_EXPORT vec4_soa *vec4_soa_create(size_t count);
+MMATH_EXPORT void vec4_soa_free(vec4_soa *a);
+MMATH_EXPORT quat_soa *quat_soa_create(size_t count);
+MMATH_EXPORT void quat_soa_free(quat_soa *a);
+
+MMATH_EXPORT vec3 *vec3_soa_get(vec3 *out, const vec3_soa *a, size_t index);
+MMATH_EXPORT void vec3_soa_set(vec3_soa *out, size_t index, const vec3 *a);
+MMATH_EXPORT vec4 *vec4_soa_get(vec4 *out, const vec4_soa *a, size_t index);
+MMATH_EXPORT void vec4_soa_set(vec4_soa *out, size_t index, const vec4 *a);
+MMATH_EXPORT quat *quat_soa_get(quat *out, const quat_soa *a, size_t index);
+MMATH_EXPORT void quat_soa_set(quat_soa *out, size_t index, const quat *a);
+
+// AoS <-> SoA conversion, from_* reads out->count elements
+MMATH_EXPORT vec3_soa *vec3_soa_from_vec3(vec3_soa *out, const vec3 *a);
+MMATH_EXPORT vec3 *vec3_soa_to_vec3(vec3 *out, const vec3_soa *a);
+MMATH_EXPORT vec4_soa *vec4_soa_from_vec4(vec4_soa *out, const vec4 *a);
+MMATH_EXPORT vec4 *vec4_soa_to_vec4(vec4 *out, const vec4_soa *a);
+MMATH_EXPORT quat_soa *quat_soa_from_quat(quat_soa *out, const quat *a);
+MMATH_EXPORT quat *quat_soa_to_quat(quat *out, const quat_soa *a);
+
+// Same results as the vec3_* functions of the same name, element by element
+MMATH_EXPORT vec3_soa *vec3_soa_add(vec3_soa *out, const vec3_soa *a, const vec3_soa *b);
+MMATH_EXPORT vec3_soa *vec3_soa_scale_and_add(vec3_soa *out, const vec3_soa *a, const vec3_soa *b, float scale);
+// out[i] = dot(a[i], b[i]), out holds a->count floats
+MMATH_EXPORT float *vec3_soa_dot(float *out, const vec3_soa *a, const vec3_soa *b);
+MMATH_EXPORT vec3_soa *vec3_soa_cross(vec3_soa *out, const vec3_soa *a, const vec3_soa *b);
+MMATH_EXPORT vec3_soa *vec3_soa_normalize(vec3_soa *out, const vec3_soa *a);
+MMATH_EXPORT vec3_soa *vec3_soa_lerp(vec3_soa *out, const vec3_soa *a, const vec3_soa *b, float t);
+MMATH_EXPORT vec3_soa *vec3_soa_transform_mat4(vec3_soa *out, const vec3_soa *a, const mat4 *m);
+
+MMATH_EXPORT vec4_soa *vec4_soa_add(vec4_soa *out, const vec4_soa *a, const vec4_soa *b);
+MMATH_EXPORT vec4_soa *vec4_soa_scale_and_add(vec4_soa *out, const vec4_soa *a, const vec4_soa *b, float scale);
+MMATH_EXPORT float *vec4_soa_dot(float *out, const vec4_soa *a, const vec4_soa *b);
+MMATH_EXPORT vec4_soa *vec4_soa_normalize(vec4_soa *out, const vec4_soa *a);
+MMATH_EXPORT vec4_soa *vec4_soa_lerp(vec4_soa *out, const vec4_soa *a, const vec4_soa *b, float t);
+MMATH_EXPORT vec4_soa *vec4_soa_transform_mat4(vec4_soa *out, const vec4_soa *a, const mat4 *m);
+
+MMATH_EXPORT quat_soa *quat_soa_multiply(quat_soa *out, const quat_soa *a, const quat_soa *b);
+MMATH_EXPORT quat_soa *quat_soa_normalize(quat_soa *out, const quat_soa *a);
+
+#endif // MMATH_SOA_H
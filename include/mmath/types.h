@@ -0,0 +1,179 @@
+#ifndef MMATH_TYPES_H
+#define MMATH_TYPES_H
+
+// The vector, matrix and quaternion types. mmath.h includes this before any other header, so
+// every type is complete wherever it is used by value, whichever header a user includes first.
+#if !defined(MMATH_H)
+#error "Include mmath.h or one of the mmath/*.h headers instead"
+#endif
+
+// Each packed type has an aligned companion with the same field layout. It holds the packed
+// type as its m (matrices), q (quaternions) or v (vectors) member, so &a->m can be passed to
+// every mat4_* function without copying.
+
+#pragma pack(push,1)
+typedef union mat2 {
+  float data[4];
+  struct {
+    float m00, m01, m10, m11;
+  };
+} mat2;
+#pragma pack(pop)
+
+typedef union MMATH_ALIGNED(16) mat2a {
+  mat2 m;
+  float data[4];
+  struct {
+    float m00, m01, m10, m11;
+  };
+} mat2a;
+
+#pragma pack(push,1)
+typedef union mat2d {
+  float data[6];
+  struct {
+    float a, b, c, d, tx, ty;
+  };
+} mat2d;
+#pragma pack(pop)
+
+typedef union MMATH_ALIGNED(16) mat2da {
+  mat2d m;
+  float data[6];
+  struct {
+    float a, b, c, d, tx, ty;
+  };
+} mat2da;
+
+#pragma pack(push,1)
+typedef union mat3 {
+  float data[9];
+  struct {
+    float m00, m01, m02, m10, m11, m12, m20, m21, m22;
+  };
+} mat3;
+#pragma pack(pop)
+
+typedef union MMATH_ALIGNED(16) mat3a {
+  mat3 m;
+  float data[9];
+  struct {
+    float m00, m01, m02, m10, m11, m12, m20, m21, m22;
+  };
+} mat3a;
+
+#pragma pack(push,1)
+typedef union mat4 {
+  float data[16];
+  struct {
+    float m00, m01, m02, m03, m10, m11, m12, m13, m20, m21, m22, m23, m30, m31, m32, m33;
+  };
+} mat4;
+#pragma pack(pop)
+
+typedef union MMATH_ALIGNED(32) mat4a {
+  mat4 m;
+  float data[16];
+  struct {
+    float m00, m01, m02, m03, m10, m11, m12, m13, m20, m21, m22, m23, m30, m31, m32, m33;
+  };
+} mat4a;
+
+// An affine transform stored as the top three rows of a mat4, the bottom row is implicitly (0, 0, 0, 1).
+// Unlike mat4 it is row-major: row r is data[4 * r] .. data[4 * r + 3] and ends with the translation,
+// which is the float3x4 / mat3x4 row layout GPUs expect for instance and bone matrices.
+#pragma pack(push,1)
+typedef union mat3x4 {
+  float data[12];
+  struct {
+    float m00, m01, m02, m03, m10, m11, m12, m13, m20, m21, m22, m23;
+  };
+} mat3x4;
+#pragma pack(pop)
+
+typedef union MMATH_ALIGNED(16) mat3x4a {
+  mat3x4 m;
+  float data[12];
+  struct {
+    float m00, m01, m02, m03, m10, m11, m12, m13, m20, m21, m22, m23;
+  };
+} mat3x4a;
+
+#pragma pack(push,1)
+typedef union quat {
+  float data[4];
+  struct { float x, y, z, w; };
+} quat;
+#pragma pack(pop)
+
+typedef union MMATH_ALIGNED(16) quata {
+  quat q;
+  float data[4];
+  struct { float x, y, z, w; };
+} quata;
+
+#pragma pack(push,1)
+typedef union quat2 {
+  float data[8];
+  struct { float x1, y1, z1, w1, x2, y2, z2, w2; };
+} quat2;
+#pragma pack(pop)
+
+typedef union MMATH_ALIGNED(32) quat2a {
+  quat2 q;
+  float data[8];
+  struct { float x1, y1, z1, w1, x2, y2, z2, w2; };
+} quat2a;
+
+#pragma pack(push,1)
+typedef union vec2 {
+  float data[2];
+  struct { float x, y; };
+  struct { float r, g; };
+  struct { float s, t; };
+} vec2;
+#pragma pack(pop)
+
+typedef union MMATH_ALIGNED(8) vec2a {
+  vec2 v;
+  float data[2];
+  struct { float x, y; };
+  struct { float r, g; };
+  struct { float s, t; };
+} vec2a;
+
+#pragma pack(push,1)
+typedef union vec3 {
+  float data[3];
+  struct { float x, y, z; };
+  struct { float r, g, b; };
+  struct { float s, t, p; };
+} vec3;
+#pragma pack(pop)
+
+typedef union MMATH_ALIGNED(16) vec3a {
+  vec3 v;
+  float data[3];
+  struct { float x, y, z; };
+  struct { float r, g, b; };
+  struct { float s, t, p; };
+} vec3a;
+
+#pragma pack(push,1)
+typedef union vec4 {
+  float data[4];
+  struct { float x, y, z, w; };
+  struct { float r, g, b, a; };
+  struct { float s, t, p, q; };
+} vec4;
+#pragma pack(pop)
+
+typedef union MMATH_ALIGNED(16) vec4a {
+  vec4 v;
+  float data[4];
+  struct { float x, y, z, w; };
+  struct { float r, g, b, a; };
+  struct { float s, t, p, q; };
+} vec4a;
+
+#endif // MMATH_TYPES_H
@@ -3,50 +3,43 @@
 
 #include "mmath.h"
 
-#pragma pack(push,1)
-typedef union vec2 {
-  float data[2];
-  struct { float x, y; };
-  struct { float r, g; };
-  struct { float s, t; };
-} vec2;
-#pragma pack(pop)
-
 MMATH_EXPORT vec2 *vec2_create();
 MMATH_EXPORT void vec2_free(vec2 *a);
+MMATH_EXPORT vec2a *vec2a_create();
+MMATH_EXPORT void vec2a_free(vec2a *a);
 MMATH_EXPORT vec2 *vec2_clone(const vec2 *a);
 MMATH_EXPORT vec2 *vec2_from_values(float x, float y);
-MMATH_EXPORT vec2 *vec2_copy(vec2 *out, const vec2 *a);
-MMATH_EXPORT vec2 *vec2_zero(vec2 *out);
-MMATH_EXPORT vec2 *vec2_set(vec2 *out, float x, float y);
+MMATH_INLINE_API vec2 *vec2_copy(vec2 *out, const vec2 *a);
+MMATH_INLINE_API vec2 *vec2_zero(vec2 *out);
+MMATH_INLINE_API vec2 *vec2_set(vec2 *out, float x, float y);
 
-MMATH_EXPORT vec2 *vec2_add(vec2 *out, const vec2 *a, const vec2 *b);
-MMATH_EXPORT vec2 *vec2_subtract(vec2 *out, const vec2 *a, const vec2 *b);
-MMATH_EXPORT vec2 *vec2_multiply(vec2 *out, const vec2 *a, const vec2 *b);
-MMATH_EXPORT vec2 *vec2_divide(vec2 *out, const vec2 *a, const vec2 *b);
+MMATH_INLINE_API vec2 *vec2_add(vec2 *out, const vec2 *a, const vec2 *b);
+MMATH_INLINE_API vec2 *vec2_subtract(vec2 *out, const vec2 *a, const vec2 *b);
+MMATH_INLINE_API vec2 *vec2_multiply(vec2 *out, const vec2 *a, const vec2 *b);
+MMATH_INLINE_API vec2 *vec2_divide(vec2 *out, const vec2 *a, const vec2 *b);
 
 MMATH_EXPORT vec2 *vec2_ceil(vec2 *out, const vec2 *a);
 MMATH_EXPORT vec2 *vec2_floor(vec2 *out, const vec2 *a);
 MMATH_EXPORT vec2 *vec2_round(vec2 *out, const vec2 *a);
 
-MMATH_EXPORT vec2 *vec2_min(vec2 *out, const vec2 *a, const vec2 *b);
-MMATH_EXPORT vec2 *vec2_max(vec2 *out, const vec2 *a, const vec2 *b);
+MMATH_INLINE_API vec2 *vec2_min(vec2 *out, const vec2 *a, const vec2 *b);
+MMATH_INLINE_API vec2 *vec2_max(vec2 *out, const vec2 *a, const vec2 *b);
 
-MMATH_EXPORT vec2 *vec2_scale(vec2 *out, const vec2 *a, float b);
-MMATH_EXPORT vec2 *vec2_scale_and_add(vec2 *out, const vec2 *a, const vec2 *b, float scale);
+MMATH_INLINE_API vec2 *vec2_scale(vec2 *out, const vec2 *a, float b);
+MMATH_INLINE_API vec2 *vec2_scale_and_add(vec2 *out, const vec2 *a, const vec2 *b, float scale);
 
-MMATH_EXPORT float vec2_distance(const vec2 *a, const vec2 *b);
-MMATH_EXPORT float vec2_distance_squared(const vec2 *a, const vec2 *b);
-MMATH_EXPORT float vec2_length(const vec2 *a);
-MMATH_EXPORT float vec2_length_squared(const vec2 *a);
+MMATH_INLINE_API float vec2_distance(const vec2 *a, const vec2 *b);
+MMATH_INLINE_API float vec2_distance_squared(const vec2 *a, const vec2 *b);
+MMATH_INLINE_API float vec2_length(const vec2 *a);
+MMATH_INLINE_API float vec2_length_squared(const vec2 *a);
 
-MMATH_EXPORT vec2 *vec2_negate(vec2 *out, const vec2 *a);
-MMATH_EXPORT vec2 *vec2_inverse(vec2 *out, const vec2 *a);
-MMATH_EXPORT vec2 *vec2_normalize(vec2 *out, const vec2 *a);
+MMATH_INLINE_API vec2 *vec2_negate(vec2 *out, const vec2 *a);
+MMATH_INLINE_API vec2 *vec2_inverse(vec2 *out, const vec2 *a);
+MMATH_INLINE_API vec2 *vec2_normalize(vec2 *out, const vec2 *a);
 
-MMATH_EXPORT float vec2_dot(const vec2 *a, const vec2 *b);
+MMATH_INLINE_API float vec2_dot(const vec2 *a, const vec2 *b);
 MMATH_EXPORT vec3 *vec2_cross(vec3 *out, const vec2 *a, const vec2 *b);
-MMATH_EXPORT vec2 *vec2_lerp(vec2 *out, const vec2 *a, const vec2 *b, float t);
+MMATH_INLINE_API vec2 *vec2_lerp(vec2 *out, const vec2 *a, const vec2 *b, float t);
 
 MMATH_EXPORT vec2 *vec2_random(vec2 *out, float scale);
 
@@ -61,4 +54,8 @@ MMATH_EXPORT float vec2_angle(const vec2 *a, const vec2 *b);
 MMATH_EXPORT bool vec2_exact_equals(const vec2 *a, const vec2 *b);
 MMATH_EXPORT bool vec2_equals(const vec2 *a, const vec2 *b);
 
+#if defined(MMATH_INLINE) && !defined(MMATH_BUILD)
+#include "mmath/vec2_inline.h"
+#endif
+
 #endif // MMATH_VEC2_H
@@ -0,0 +1,141 @@
+#ifndef MMATH_VEC2_INLINE_H
+#define MMATH_VEC2_INLINE_H
+
+// Compiled into src/mmath/vec2.c, or into the caller when MMATH_INLINE is defined
+
+#include <math.h>
+
+#include "mmath/vec2.h"
+
+MMATH_INLINE_API vec2 *vec2_copy(vec2 *out, const vec2 *a) {
+  out->x = a->x;
+  out->y = a->y;
+  return out;
+}
+
+MMATH_INLINE_API vec2 *vec2_zero(vec2 *out) {
+  return vec2_set(out, 0.f, 0.f);
+}
+
+MMATH_INLINE_API vec2 *vec2_set(vec2 *out, float x, float y) {
+  out->x = x;
+  out->y = y;
+  return out;
+}
+
+MMATH_INLINE_API vec2 *vec2_add(vec2 *out, const vec2 *a, const vec2 *b) {
+  out->x = a->x + b->x;
+  out->y = a->y + b->y;
+  return out;
+}
+
+MMATH_INLINE_API vec2 *vec2_subtract(vec2 *out, const vec2 *a, const vec2 *b) {
+  out->x = a->x - b->x;
+  out->y = a->y - b->y;
+  return out;
+}
+
+MMATH_INLINE_API vec2 *vec2_multiply(vec2 *out, const vec2 *a, const vec2 *b) {
+  out->x = a->x * b->x;
+  out->y = a->y * b->y;
+  return out;
+}
+
+MMATH_INLINE_API vec2 *vec2_divide(vec2 *out, const vec2 *a, const vec2 *b) {
+  out->x = a->x / b->x;
+  out->y = a->y / b->y;
+  return out;
+}
+
+MMATH_INLINE_API vec2 *vec2_min(vec2 *out, const vec2 *a, const vec2 *b) {
+  out->x = fminf(a->x, b->x);
+  out->y = fminf(a->y, b->y);
+  return out;
+}
+
+MMATH_INLINE_API vec2 *vec2_max(vec2 *out, const vec2 *a, const vec2 *b) {
+  out->x = fmaxf(a->x, b->x);
+  out->y = fmaxf(a->y, b->y);
+  return out;
+}
+
+MMATH_INLINE_API vec2 *vec2_scale(vec2 *out, const vec2 *a, float b) {
+  out->x = a->x * b;
+  out->y = a->y * b;
+  return out;
+}
+
+MMATH_INLINE_API vec2 *vec2_scale_and_add(vec2 *out, const vec2 *a, const vec2 *b, float scale) {
+  out->x = a->x + (b->x * scale);
+  out->y = a->y + (b->y * scale);
+  return out;
+}
+
+MMATH_INLINE_API float vec2_distance(const vec2 *a, const vec2 *b) {
+  float dx = a->x - b->x;
+  float dy = a->y - b->y;
+
+  return sqrtf(dx * dx + dy * dy);
+}
+
+MMATH_INLINE_API float vec2_distance_squared(const vec2 *a, const vec2 *b) {
+  float dx = a->x - b->x;
+  float dy = a->y - b->y;
+
+  return dx * dx + dy * dy;
+}
+
+MMATH_INLINE_API float vec2_length(const vec2 *a) {
+  float dx = a->x;
+  float dy = a->y;
+
+  return sqrtf(dx * dx + dy * dy);
+}
+
+MMATH_INLINE_API float vec2_length_squared(const vec2 *a) {
+  float dx = a->x;
+  float dy = a->y;
+
+  return dx * dx + dy * dy;
+}
+
+MMATH_INLINE_API vec2 *vec2_negate(vec2 *out, const vec2 *a) {
+  out->x = -a->x;
+  out->y = -a->y;
+  return out;
+}
+
+MMATH_INLINE_API vec2 *vec2_inverse(vec2 *out, const vec2 *a) {
+  out->x = 1.f / a->x;
+  out->y = 1.f / a->y;
+  return out;
+}
+
+MMATH_INLINE_API vec2 *vec2_normalize(vec2 *out, const vec2 *a) {
+  float x = a->x;
+  float y = a->y;
+
+  float len = x * x + y * y;
+  if (len > 0) {
+    len = 1.f / sqrtf(len);
+  }
+
+  out->x = a->x * len;
+  out->y = a->y * len;
+  return out;
+}
+
+MMATH_INLINE_API float vec2_dot(const vec2 *a, const vec2 *b) {
+  return a->x * b->x + a->y * b->y;
+}
+
+MMATH_INLINE_API vec2 *vec2_lerp(vec2 *out, const vec2 *a, const vec2 *b, float t) {
+  float x = a->x;
+  float y = a->y;
+
+  out->x = x + t * (b->x - x);
+  out->y = y + t * (b->y - y);
+  return out;
+}
+
+#endif // MMATH_VEC2_INLINE_H
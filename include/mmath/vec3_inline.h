@@ -0,0 +1,175 @@
+#ifndef MMATH_VEC3_INLINE_H
+#define MMATH_VEC3_INLINE_H
+
+// Compiled into src/mmath/vec3.c, or into the caller when MMATH_INLINE is defined
+
+#include <math.h>
+
+#include "mmath/vec3.h"
+
+MMATH_INLINE_API vec3 *vec3_copy(vec3 *out, const vec3 *a) {
+  out->x = a->x;
+  out->y = a->y;
+  out->z = a->z;
+  return out;
+}
+
+MMATH_INLINE_API vec3 *vec3_zero(vec3 *out) {
+  return vec3_set(out, 0.f, 0.f, 0.f);
+}
+
+MMATH_INLINE_API vec3 *vec3_set(vec3 *out, float x, float y, float z) {
+  out->x = x;
+  out->y = y;
+  out->z = z;
+  return out;
+}
+
+MMATH_INLINE_API vec3 *vec3_add(vec3 *out, const vec3 *a, const vec3 *b) {
+  out->x = a->x + b->x;
+  out->y = a->y + b->y;
+  out->z = a->z + b->z;
+  return out;
+}
+
+MMATH_INLINE_API vec3 *vec3_subtract(vec3 *out, const vec3 *a, const vec3 *b) {
+  out->x = a->x - b->x;
+  out->y = a->y - b->y;
+  out->z = a->z - b->z;
+  return out;
+}
+
+MMATH_INLINE_API vec3 *vec3_multiply(vec3 *out, const vec3 *a, const vec3 *b) {
+  out->x = a->x * b->x;
+  out->y = a->y * b->y;
+  out->z = a->z * b->z;
+  return out;
+}
+
+MMATH_INLINE_API vec3 *vec3_divide(vec3 *out, const vec3 *a, const vec3 *b) {
+  out->x = a->x / b->x;
+  out->y = a->y / b->y;
+  out->z = a->z / b->z;
+  return out;
+}
+
+MMATH_INLINE_API vec3 *vec3_min(vec3 *out, const vec3 *a, const vec3 *b) {
+  out->x = fminf(a->x, b->x);
+  out->y = fminf(a->y, b->y);
+  out->z = fminf(a->z, b->z);
+  return out;
+}
+
+MMATH_INLINE_API vec3 *vec3_max(vec3 *out, const vec3 *a, const vec3 *b) {
+  out->x = fmaxf(a->x, b->x);
+  out->y = fmaxf(a->y, b->y);
+  out->z = fmaxf(a->z, b->z);
+  return out;
+}
+
+MMATH_INLINE_API vec3 *vec3_scale(vec3 *out, const vec3 *a, float b) {
+  out->x = a->x * b;
+  out->y = a->y * b;
+  out->z = a->z * b;
+  return out;
+}
+
+MMATH_INLINE_API vec3 *vec3_scale_and_add(vec3 *out, const vec3 *a, const vec3 *b, float scale) {
+  out->x = a->x + (b->x * scale);
+  out->y = a->y + (b->y * scale);
+  out->z = a->z + (b->z * scale);
+  return out;
+}
+
+MMATH_INLINE_API float vec3_distance(const vec3 *a, const vec3 *b) {
+  float dx = a->x - b->x;
+  float dy = a->y - b->y;
+  float dz = a->z - b->z;
+
+  return sqrtf(dx * dx + dy * dy + dz * dz);
+}
+
+MMATH_INLINE_API float vec3_distance_squared(const vec3 *a, const vec3 *b) {
+  float dx = a->x - b->x;
+  float dy = a->y - b->y;
+  float dz = a->z - b->z;
+
+  return dx * dx + dy * dy + dz * dz;
+}
+
+MMATH_INLINE_API float vec3_length(const vec3 *a) {
+  float dx = a->x;
+  float dy = a->y;
+  float dz = a->z;
+
+  return sqrtf(dx * dx + dy * dy + dz * dz);
+}
+
+MMATH_INLINE_API float vec3_length_squared(const vec3 *a) {
+  float dx = a->x;
+  float dy = a->y;
+  float dz = a->z;
+
+  return dx * dx + dy * dy + dz * dz;
+}
+
+MMATH_INLINE_API vec3 *vec3_negate(vec3 *out, const vec3 *a) {
+  out->x = -a->x;
+  out->y = -a->y;
+  out->z = -a->z;
+  return out;
+}
+
+MMATH_INLINE_API vec3 *vec3_inverse(vec3 *out, const vec3 *a) {
+  out->x = 1.f / a->x;
+  out->y = 1.f / a->y;
+  out->z = 1.f / a->z;
+  return out;
+}
+
+MMATH_INLINE_API vec3 *vec3_normalize(vec3 *out, const vec3 *a) {
+  float x = a->x;
+  float y = a->y;
+  float z = a->z;
+
+  float len = x * x + y * y + z * z;
+  if (len > 0) {
+    len = 1.f / sqrtf(len);
+  }
+
+  out->x = a->x * len;
+  out->y = a->y * len;
+  out->z = a->z * len;
+  return out;
+}
+
+MMATH_INLINE_API float vec3_dot(const vec3 *a, const vec3 *b) {
+  return a->x * b->x + a->y * b->y + a->z * b->z;
+}
+
+MMATH_INLINE_API vec3 *vec3_lerp(vec3 *out, const vec3 *a, const vec3 *b, float t) {
+  float x = a->x;
+  float y = a->y;
+  float z = a->z;
+
+  out->x = x + t * (b->x - x);
+  out->y = y + t * (b->y - y);
+  out->z = z + t * (b->z - z);
+  return out;
+}
+
+MMATH_INLINE_API vec3 *vec3_cross(vec3 *out, const vec3 *a, const vec3 *b) {
+  float ax = a->x;
+  float ay = a->y;
+  float az = a->z;
+  float bx = b->x;
+  float by = b->y;
+  float bz = b->z;
+
+  out->x = ay * bz - az * by;
+  out->y = az * bx - ax * bz;
+  out->z = ax * by - ay * bx;
+  return out;
+}
+
+#endif // MMATH_VEC3_INLINE_H
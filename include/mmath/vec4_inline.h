@@ -0,0 +1,181 @@
+#ifndef MMATH_VEC4_INLINE_H
+#define MMATH_VEC4_INLINE_H
+
+// Compiled into src/mmath/vec4.c, or into the caller when MMATH_INLINE is defined
+
+#include <math.h>
+
+#include "mmath/vec4.h"
+
+MMATH_INLINE_API vec4 *vec4_copy(vec4 *out, const vec4 *a) {
+  out->x = a->x;
+  out->y = a->y;
+  out->z = a->z;
+  out->w = a->w;
+  return out;
+}
+
+MMATH_INLINE_API vec4 *vec4_zero(vec4 *out) {
+  return vec4_set(out, 0.f, 0.f, 0.f, 0.f);
+}
+
+MMATH_INLINE_API vec4 *vec4_set(vec4 *out, float x, float y, float z, float w) {
+  out->x = x;
+  out->y = y;
+  out->z = z;
+  out->w = w;
+  return out;
+}
+
+MMATH_INLINE_API vec4 *vec4_add(vec4 *out, const vec4 *a, const vec4 *b) {
+  out->x = a->x + b->x;
+  out->y = a->y + b->y;
+  out->z = a->z + b->z;
+  out->w = a->w + b->w;
+  return out;
+}
+
+MMATH_INLINE_API vec4 *vec4_subtract(vec4 *out, const vec4 *a, const vec4 *b) {
+  out->x = a->x - b->x;
+  out->y = a->y - b->y;
+  out->z = a->z - b->z;
+  out->w = a->w - b->w;
+  return out;
+}
+
+MMATH_INLINE_API vec4 *vec4_multiply(vec4 *out, const vec4 *a, const vec4 *b) {
+  out->x = a->x * b->x;
+  out->y = a->y * b->y;
+  out->z = a->z * b->z;
+  out->w = a->w * b->w;
+  return out;
+}
+
+MMATH_INLINE_API vec4 *vec4_divide(vec4 *out, const vec4 *a, const vec4 *b) {
+  out->x = a->x / b->x;
+  out->y = a->y / b->y;
+  out->z = a->z / b->z;
+  out->w = a->w / b->w;
+  return out;
+}
+
+MMATH_INLINE_API vec4 *vec4_min(vec4 *out, const vec4 *a, const vec4 *b) {
+  out->x = fminf(a->x, b->x);
+  out->y = fminf(a->y, b->y);
+  out->z = fminf(a->z, b->z);
+  out->w = fminf(a->w, b->w);
+  return out;
+}
+
+MMATH_INLINE_API vec4 *vec4_max(vec4 *out, const vec4 *a, const vec4 *b) {
+  out->x = fmaxf(a->x, b->x);
+  out->y = fmaxf(a->y, b->y);
+  out->z = fmaxf(a->z, b->z);
+  out->w = fmaxf(a->z, b->w);
+  return out;
+}
+
+MMATH_INLINE_API vec4 *vec4_scale(vec4 *out, const vec4 *a, float b) {
+  out->x = a->x * b;
+  out->y = a->y * b;
+  out->z = a->z * b;
+  out->w = a->w * b;
+  return out;
+}
+
+MMATH_INLINE_API vec4 *vec4_scale_and_add(vec4 *out, const vec4 *a, const vec4 *b, float scale) {
+  out->x = a->x + (b->x * scale);
+  out->y = a->y + (b->y * scale);
+  out->z = a->z + (b->z * scale);
+  out->w = a->w + (b->w * scale);
+  return out;
+}
+
+MMATH_INLINE_API float vec4_distance(const vec4 *a, const vec4 *b) {
+  float dx = a->x - b->x;
+  float dy = a->y - b->y;
+  float dz = a->z - b->z;
+  float dw = a->w - b->w;
+
+  return sqrtf(dx * dx + dy * dy + dz * dz + dw * dw);
+}
+
+MMATH_INLINE_API float vec4_distance_squared(const vec4 *a, const vec4 *b) {
+  float dx = a->x - b->x;
+  float dy = a->y - b->y;
+  float dz = a->z - b->z;
+  float dw = a->w - b->w;
+
+  return dx * dx + dy * dy + dz * dz + dw * dw;
+}
+
+MMATH_INLINE_API float vec4_length(const vec4 *a) {
+  float dx = a->x;
+  float dy = a->y;
+  float dz = a->z;
+  float dw = a->w;
+
+  return sqrtf(dx * dx + dy * dy + dz * dz + dw * dw);
+}
+
+MMATH_INLINE_API float vec4_length_squared(const vec4 *a) {
+  float dx = a->x;
+  float dy = a->y;
+  float dz = a->z;
+  float dw = a->w;
+
+  return dx * dx + dy * dy + dz * dz + dw * dw;
+}
+
+MMATH_INLINE_API vec4 *vec4_negate(vec4 *out, const vec4 *a) {
+  out->x = -a->x;
+  out->y = -a->y;
+  out->z = -a->z;
+  out->w = -a->w;
+  return out;
+}
+
+MMATH_INLINE_API vec4 *vec4_inverse(vec4 *out, const vec4 *a) {
+  out->x = 1.f / a->x;
+  out->y = 1.f / a->y;
+  out->z = 1.f / a->z;
+  out->w = 1.f / a->w;
+  return out;
+}
+
+MMATH_INLINE_API vec4 *vec4_normalize(vec4 *out, const vec4 *a) {
+  float x = a->x;
+  float y = a->y;
+  float z = a->z;
+  float w = a->w;
+
+  float len = x * x + y * y + z * z + w * w;
+  if (len > 0) {
+    len = 1.f / sqrtf(len);
+  }
+
+  out->x = a->x * len;
+  out->y = a->y * len;
+  out->z = a->z * len;
+  out->w = a->w * len;
+  return out;
+}
+
+MMATH_INLINE_API float vec4_dot(const vec4 *a, const vec4 *b) {
+  return a->x * b->x + a->y * b->y + a->z * b->z + a->w * b->w;
+}
+
+MMATH_INLINE_API vec4 *vec4_lerp(vec4 *out, const vec4 *a, const vec4 *b, float t) {
+  float x = a->x;
+  float y = a->y;
+  float z = a->z;
+  float w = a->w;
+
+  out->x = x + t * (b->x - x);
+  out->y = y + t * (b->y - y);
+  out->z = z + t * (b->z - z);
+  out->w = w + t * (b->w - w);
+  return out;
+}
+
+#endif // MMATH_VEC4_INLINE_H
@@ -0,0 +1,52 @@
+#ifndef MMATH_XFORM_H
+#define MMATH_XFORM_H
+
+#include "mmath.h"
+
+// What a transform is known to be, from cheapest to most general. Every kind is also
+// one of the kinds after it, except that scale + translation is not rigid.
+typedef enum xform_kind {
+  MMATH_XFORM_IDENTITY = 0,
+  // Only the translation column differs from identity
+  MMATH_XFORM_TRANSLATION,
+  // Diagonal upper 3x3 and a translation
+  MMATH_XFORM_SCALE_TRANSLATION,
+  // Orthonormal upper 3x3 and a translation
+  MMATH_XFORM_RIGID,
+  // Bottom row (0, 0, 0, 1)
+  MMATH_XFORM_AFFINE,
+  MMATH_XFORM_PROJECTIVE
+} xform_kind;
+
+// A mat4 tagged with its kind, so multiply/invert/transform_point can skip the work the
+// general mat4 functions do for it. The builders below set the tag, writing to matrix directly
+// requires updating kind too (or calling xform_from_mat4).
+typedef struct xform {
+  mat4 matrix;
+  xform_kind kind;
+} xform;
+
+MMATH_EXPORT xform *xform_identity(xform *out);
+// Classifies an arbitrary matrix, rigid allows for rounding in the rotation
+MMATH_EXPORT xform *xform_from_mat4(xform *out, const mat4 *m);
+
+// Same arguments as the mat4_* builders of the same name
+MMATH_EXPORT xform *xform_from_translation(xform *out, const vec4 *v);
+MMATH_EXPORT xform *xform_from_scaling(xform *out, const vec4 *v);
+MMATH_EXPORT xform *xform_from_rotation(xform *out, float angle, const vec3 *axis);
+MMATH_EXPORT xform *xform_from_quat(xform *out, const quat *q);
+MMATH_EXPORT xform *xform_from_rotation_translation(xform *out, const quat *q, const vec3 *v);
+MMATH_EXPORT xform *xform_from_rotation_translation_scale(xform *out, const quat *q, const vec3 *v, const vec3 *s);
+MMATH_EXPORT xform *xform_look_at(xform *out, const vec3 *eye, const vec3 *center, const vec3 *up);
+MMATH_EXPORT xform *xform_ortho(xform *out, float left, float right, float bottom, float top, float near, float far);
+MMATH_EXPORT xform *xform_perspective(xform *out, float fovy, float aspect, float near, float far);
+MMATH_EXPORT xform *xform_frustum(xform *out, float left, float right, float bottom, float top, float near, float far);
+
+MMATH_EXPORT xform *xform_copy(xform *out, const xform *a);
+MMATH_EXPORT xform *xform_multiply(xform *out, const xform *a, const xform *b);
+// Returns NULL when a is singular
+MMATH_EXPORT xform *xform_invert(xform *out, const xform *a);
+// Same result as vec3_transform_mat4, including the perspective divide of projective transforms
+MMATH_EXPORT vec3 *xform_transform_point(vec3 *out, const vec3 *a, const xform *x);
+
+#endif // MMATH_XFORM_H
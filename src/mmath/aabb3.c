@@ -0,0 +1,179 @@
+#include "mmath/aabb3.h"
+#include "mmath_private.h"
+
+aabb3 *aabb3_create() {
+  aabb3 *out = mmath_alloc(sizeof(aabb3), _Alignof(aabb3));
+  return aabb3_empty(out);
+}
+
+void aabb3_free(aabb3 *a) {
+  mmath_free(a, sizeof(aabb3), _Alignof(aabb3));
+}
+
+aabb3 *aabb3_clone(const aabb3 *a) {
+  aabb3 *out = mmath_alloc(sizeof(aabb3), _Alignof(aabb3));
+  return aabb3_copy(out, a);
+}
+
+aabb3 *aabb3_from_values(const vec3 *min, const vec3 *max) {
+  aabb3 *out = mmath_alloc(sizeof(aabb3), _Alignof(aabb3));
+  return aabb3_set(out, min, max);
+}
+
+aabb3 *aabb3_copy(aabb3 *out, const aabb3 *a) {
+  vec3_copy(&out->min, &a->min);
+  vec3_copy(&out->max, &a->max);
+  return out;
+}
+
+aabb3 *aabb3_set(aabb3 *out, const vec3 *min, const vec3 *max) {
+  vec3_copy(&out->min, min);
+  vec3_copy(&out->max, max);
+  return out;
+}
+
+aabb3 *aabb3_empty(aabb3 *out) {
+  vec3_set(&out->min, INFINITY, INFINITY, INFINITY);
+  vec3_set(&out->max, -INFINITY, -INFINITY, -INFINITY);
+  return out;
+}
+
+bool aabb3_is_empty(const aabb3 *a) {
+  return a->min.x > a->max.x || a->min.y > a->max.y || a->min.z > a->max.z;
+}
+
+aabb3 *aabb3_union(aabb3 *out, const aabb3 *a, const aabb3 *b) {
+  vec3_min(&out->min, &a->min, &b->min);
+  vec3_max(&out->max, &a->max, &b->max);
+  return out;
+}
+
+aabb3 *aabb3_intersect(aabb3 *out, const aabb3 *a, const aabb3 *b) {
+  vec3_max(&out->min, &a->min, &b->min);
+  vec3_min(&out->max, &a->max, &b->max);
+  return out;
+}
+
+aabb3 *aabb3_expand(aabb3 *out, const aabb3 *a, const vec3 *p) {
+  vec3_min(&out->min, &a->min, p);
+  vec3_max(&out->max, &a->max, p);
+  return out;
+}
+
+aabb3 *aabb3_inflate(aabb3 *out, const aabb3 *a, float amount) {
+  vec3_set(&out->min, a->min.x - amount, a->min.y - amount, a->min.z - amount);
+  vec3_set(&out->max, a->max.x + amount, a->max.y + amount, a->max.z + amount);
+  return out;
+}
+
+vec3 *aabb3_center(vec3 *out, const aabb3 *a) {
+  out->x = (a->min.x + a->max.x) * 0.5f;
+  out->y = (a->min.y + a->max.y) * 0.5f;
+  out->z = (a->min.z + a->max.z) * 0.5f;
+  return out;
+}
+
+vec3 *aabb3_extents(vec3 *out, const aabb3 *a) {
+  out->x = (a->max.x - a->min.x) * 0.5f;
+  out->y = (a->max.y - a->min.y) * 0.5f;
+  out->z = (a->max.z - a->min.z) * 0.5f;
+  return out;
+}
+
+float aabb3_surface_area(const aabb3 *a) {
+  float x = a->max.x - a->min.x;
+  float y = a->max.y - a->min.y;
+  float z = a->max.z - a->min.z;
+  return 2.f * (x * y + y * z + z * x);
+}
+
+bool aabb3_contains_point(const aabb3 *a, const vec3 *p) {
+  return p->x >= a->min.x && p->x <= a->max.x &&
+    p->y >= a->min.y && p->y <= a->max.y &&
+    p->z >= a->min.z && p->z <= a->max.z
+  ;
+}
+
+bool aabb3_intersects(const aabb3 *a, const aabb3 *b) {
+  return a->min.x <= b->max.x && a->max.x >= b->min.x &&
+    a->min.y <= b->max.y && a->max.y >= b->min.y &&
+    a->min.z <= b->max.z && a->max.z >= b->min.z
+  ;
+}
+
+#if defined(MMATH_SSE2)
+
+static inline void aabb3_transform_mat4_sse2(aabb3 *out, const aabb3 *a, const mat4 *m) {
+  const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  const __m128 half = _mm_set1_ps(0.5f);
+
+  // (min.x, min.y, min.z, max.x) and (min.z, max.x, max.y, max.z), both loads stay inside the box
+  __m128 lo = _mm_loadu_ps(&a->data[0]);
+  __m128 hi = _mm_loadu_ps(&a->data[2]);
+  hi = _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(3, 3, 2, 1));
+
+  __m128 c = _mm_mul_ps(_mm_add_ps(lo, hi), half);
+  __m128 e = _mm_mul_ps(_mm_sub_ps(hi, lo), half);
+
+  __m128 m0 = _mm_loadu_ps(&m->data[0]);
+  __m128 m1 = _mm_loadu_ps(&m->data[4]);
+  __m128 m2 = _mm_loadu_ps(&m->data[8]);
+  __m128 m3 = _mm_loadu_ps(&m->data[12]);
+
+  __m128 center = _mm_add_ps(
+    _mm_add_ps(_mm_mul_ps(m0, _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0))), _mm_mul_ps(m1, _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1)))),
+    _mm_add_ps(_mm_mul_ps(m2, _mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2))), m3)
+  );
+  __m128 extent = _mm_add_ps(
+    _mm_add_ps(
+      _mm_mul_ps(_mm_and_ps(m0, abs_mask), _mm_shuffle_ps(e, e, _MM_SHUFFLE(0, 0, 0, 0))),
+      _mm_mul_ps(_mm_and_ps(m1, abs_mask), _mm_shuffle_ps(e, e, _MM_SHUFFLE(1, 1, 1, 1)))
+    ),
+    _mm_mul_ps(_mm_and_ps(m2, abs_mask), _mm_shuffle_ps(e, e, _MM_SHUFFLE(2, 2, 2, 2)))
+  );
+
+  __m128 min = _mm_sub_ps(center, extent);
+  __m128 max = _mm_add_ps(center, extent);
+
+  // Same overlapping layout as the loads, the second store rewrites min.z with the same value
+  __m128 t = _mm_shuffle_ps(min, max, _MM_SHUFFLE(0, 0, 2, 2));
+  _mm_storeu_ps(&out->data[0], _mm_shuffle_ps(min, t, _MM_SHUFFLE(2, 0, 1, 0)));
+  _mm_storeu_ps(&out->data[2], _mm_shuffle_ps(t, max, _MM_SHUFFLE(2, 1, 2, 0)));
+}
+
+#endif
+
+aabb3 *aabb3_transform_mat4(aabb3 *out, const aabb3 *a, const mat4 *m) {
+#if defined(MMATH_SSE2)
+  aabb3_transform_mat4_sse2(out, a, m);
+#else
+  vec3 c, e;
+  int i;
+
+  aabb3_center(&c, a);
+  aabb3_extents(&e, a);
+
+  for (i = 0; i < 3; ++i) {
+    float center = m->data[i] * c.x + m->data[4 + i] * c.y + m->data[8 + i] * c.z + m->data[12 + i];
+    float extent = fabsf(m->data[i]) * e.x + fabsf(m->data[4 + i]) * e.y + fabsf(m->data[8 + i]) * e.z;
+    out->min.data[i] = center - extent;
+    out->max.data[i] = center + extent;
+  }
+#endif
+  return out;
+}
+
+void aabb3_transform_mat4_batch(aabb3 *out, const aabb3 *a, const mat4 *m, size_t count) {
+  size_t i;
+  for (i = 0; i < count; ++i) {
+    aabb3_transform_mat4(&out[i], &a[i], &m[i]);
+  }
+}
+
+bool aabb3_exact_equals(const aabb3 *a, const aabb3 *b) {
+  return vec3_exact_equals(&a->min, &b->min) && vec3_exact_equals(&a->max, &b->max);
+}
+
+bool aabb3_equals(const aabb3 *a, const aabb3 *b) {
+  return vec3_equals(&a->min, &b->min) && vec3_equals(&a->max, &b->max);
+}
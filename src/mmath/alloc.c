@@ -0,0 +1,336 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "mmath/alloc.h"
+#include "mmath_private.h"
+
+#define MMATH_ARENA_CLASS_SIZE 16
+#define MMATH_ARENA_CLASSES 4
+// Free lists are kept per alignment of 16, 32 and 64 bytes, so a freed object is only handed
+// out again to a request with the same alignment
+#define MMATH_ARENA_ALIGNS 3
+#define MMATH_ARENA_BLOCK_ALIGN 64
+
+typedef struct mmath_arena_block {
+  struct mmath_arena_block *next;
+  size_t size;
+  unsigned char *data;
+} mmath_arena_block;
+
+typedef struct mmath_arena_free {
+  struct mmath_arena_free *next;
+} mmath_arena_free;
+
+struct mmath_arena {
+  mmath_allocator allocator;
+  size_t block_size;
+  mmath_arena_block *blocks;
+  mmath_arena_block *current;
+  unsigned char *cursor;
+  unsigned char *end;
+  mmath_arena_free *free_lists[MMATH_ARENA_ALIGNS][MMATH_ARENA_CLASSES];
+
+  // The blocks sorted by address, so mmath_free can find the owner with a binary search
+  mmath_arena_block **sorted;
+  size_t block_count;
+  size_t block_capacity;
+};
+
+static void *mmath_default_alloc(size_t size, size_t alignment, void *user) {
+  (void) user;
+
+  if (alignment <= _Alignof(max_align_t)) {
+    return malloc(size);
+  }
+
+#if defined(_MSC_VER)
+  return _aligned_malloc(size, alignment);
+#else
+  void *ptr;
+  if (posix_memalign(&ptr, alignment, size) != 0) {
+    return NULL;
+  }
+  return ptr;
+#endif
+}
+
+static void mmath_default_free(void *ptr, size_t size, size_t alignment, void *user) {
+  (void) size;
+  (void) user;
+
+#if defined(_MSC_VER)
+  if (alignment > _Alignof(max_align_t)) {
+    _aligned_free(ptr);
+    return;
+  }
+#else
+  (void) alignment;
+#endif
+  free(ptr);
+}
+
+static mmath_allocator mmath_allocator_current = {
+  mmath_default_alloc,
+  mmath_default_free,
+  NULL
+};
+
+static MMATH_THREAD_LOCAL mmath_arena *mmath_arena_active;
+
+void mmath_set_allocator(const mmath_allocator *allocator) {
+  if (allocator == NULL) {
+    mmath_allocator_current.alloc = mmath_default_alloc;
+    mmath_allocator_current.free = mmath_default_free;
+    mmath_allocator_current.user = NULL;
+  } else {
+    mmath_allocator_current = *allocator;
+  }
+}
+
+static size_t mmath_arena_class(size_t size) {
+  return (size + MMATH_ARENA_CLASS_SIZE - 1) / MMATH_ARENA_CLASS_SIZE;
+}
+
+// Returns MMATH_ARENA_ALIGNS for alignments that are not recycled
+static size_t mmath_arena_align(size_t alignment) {
+  if (alignment <= MMATH_ARENA_CLASS_SIZE) {
+    return 0;
+  }
+  if (alignment <= 2 * MMATH_ARENA_CLASS_SIZE) {
+    return 1;
+  }
+  if (alignment <= MMATH_ARENA_BLOCK_ALIGN) {
+    return 2;
+  }
+  return MMATH_ARENA_ALIGNS;
+}
+
+static bool mmath_arena_block_contains(const mmath_arena_block *block, const unsigned char *p) {
+  return p >= block->data && p < block->data + block->size;
+}
+
+static bool mmath_arena_owns(const mmath_arena *arena, const void *ptr) {
+  const unsigned char *p = (const unsigned char *) ptr;
+  size_t low = 0, high = arena->block_count;
+
+  if (arena->current != NULL && mmath_arena_block_contains(arena->current, p)) {
+    return true;
+  }
+
+  // Finds the last block starting at or before p
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+
+    if ((uintptr_t) arena->sorted[mid] <= (uintptr_t) p) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low > 0 && mmath_arena_block_contains(arena->sorted[low - 1], p);
+}
+
+static bool mmath_arena_insert_block(mmath_arena *arena, mmath_arena_block *block) {
+  size_t i;
+
+  if (arena->block_count == arena->block_capacity) {
+    size_t capacity = arena->block_capacity > 0 ? arena->block_capacity * 2 : 8;
+    mmath_arena_block **sorted = arena->allocator.alloc(
+      capacity * sizeof(mmath_arena_block *),
+      _Alignof(mmath_arena_block *),
+      arena->allocator.user
+    );
+    if (sorted == NULL) {
+      return false;
+    }
+    if (arena->sorted != NULL) {
+      memcpy(sorted, arena->sorted, arena->block_count * sizeof(mmath_arena_block *));
+      arena->allocator.free(
+        arena->sorted,
+        arena->block_capacity * sizeof(mmath_arena_block *),
+        _Alignof(mmath_arena_block *),
+        arena->allocator.user
+      );
+    }
+    arena->sorted = sorted;
+    arena->block_capacity = capacity;
+  }
+
+  for (i = arena->block_count; i > 0 && (uintptr_t) arena->sorted[i - 1] > (uintptr_t) block; --i) {
+    arena->sorted[i] = arena->sorted[i - 1];
+  }
+  arena->sorted[i] = block;
+  ++arena->block_count;
+  return true;
+}
+
+static void mmath_arena_use_block(mmath_arena *arena, mmath_arena_block *block) {
+  arena->current = block;
+  arena->cursor = block->data;
+  arena->end = block->data + block->size;
+}
+
+static void *mmath_arena_alloc(mmath_arena *arena, size_t size, size_t alignment) {
+  size_t cls = mmath_arena_class(size), align = mmath_arena_align(alignment);
+  uintptr_t cursor;
+  mmath_arena_block *block;
+
+  if (cls <= MMATH_ARENA_CLASSES) {
+    if (align < MMATH_ARENA_ALIGNS && arena->free_lists[align][cls - 1] != NULL) {
+      mmath_arena_free *node = arena->free_lists[align][cls - 1];
+      arena->free_lists[align][cls - 1] = node->next;
+      return node;
+    }
+    size = cls * MMATH_ARENA_CLASS_SIZE;
+  }
+  if (alignment < MMATH_ARENA_CLASS_SIZE) {
+    alignment = MMATH_ARENA_CLASS_SIZE;
+  }
+
+  for (;;) {
+    if (arena->current != NULL) {
+      cursor = ((uintptr_t) arena->cursor + alignment - 1) & ~(uintptr_t) (alignment - 1);
+      if (cursor + size <= (uintptr_t) arena->end) {
+        arena->cursor = (unsigned char *) (cursor + size);
+        return (void *) cursor;
+      }
+    }
+
+    // Blocks kept from before a reset are reused before allocating a new one
+    if (arena->current != NULL && arena->current->next != NULL) {
+      mmath_arena_use_block(arena, arena->current->next);
+      continue;
+    }
+
+    size_t block_size = arena->block_size;
+    if (block_size < size + alignment) {
+      block_size = size + alignment;
+    }
+
+    // The block header sits in front of its data, padded to keep the data aligned
+    block = arena->allocator.alloc(
+      MMATH_ARENA_BLOCK_ALIGN + block_size,
+      MMATH_ARENA_BLOCK_ALIGN,
+      arena->allocator.user
+    );
+    if (block == NULL) {
+      return NULL;
+    }
+    block->data = (unsigned char *) block + MMATH_ARENA_BLOCK_ALIGN;
+    block->size = block_size;
+    block->next = NULL;
+    if (!mmath_arena_insert_block(arena, block)) {
+      arena->allocator.free(
+        block,
+        MMATH_ARENA_BLOCK_ALIGN + block_size,
+        MMATH_ARENA_BLOCK_ALIGN,
+        arena->allocator.user
+      );
+      return NULL;
+    }
+
+    if (arena->current != NULL) {
+      arena->current->next = block;
+    } else {
+      arena->blocks = block;
+    }
+    mmath_arena_use_block(arena, block);
+  }
+}
+
+static void mmath_arena_release(mmath_arena *arena, void *ptr, size_t size, size_t alignment) {
+  size_t cls = mmath_arena_class(size), align = mmath_arena_align(alignment);
+
+  if (cls <= MMATH_ARENA_CLASSES && align < MMATH_ARENA_ALIGNS) {
+    mmath_arena_free *node = (mmath_arena_free *) ptr;
+    node->next = arena->free_lists[align][cls - 1];
+    arena->free_lists[align][cls - 1] = node;
+  }
+}
+
+mmath_arena *mmath_arena_create(size_t block_size) {
+  mmath_arena *arena = mmath_allocator_current.alloc(
+    sizeof(mmath_arena),
+    _Alignof(mmath_arena),
+    mmath_allocator_current.user
+  );
+  if (arena == NULL) {
+    return NULL;
+  }
+
+  memset(arena, 0, sizeof(mmath_arena));
+  arena->allocator = mmath_allocator_current;
+  arena->block_size = block_size > 0 ? block_size : 64 * 1024;
+  return arena;
+}
+
+void mmath_arena_destroy(mmath_arena *arena) {
+  mmath_arena_block *block = arena->blocks;
+  mmath_allocator allocator = arena->allocator;
+
+  if (mmath_arena_active == arena) {
+    mmath_arena_active = NULL;
+  }
+
+  while (block != NULL) {
+    mmath_arena_block *next = block->next;
+    allocator.free(block, MMATH_ARENA_BLOCK_ALIGN + block->size, MMATH_ARENA_BLOCK_ALIGN, allocator.user);
+    block = next;
+  }
+  if (arena->sorted != NULL) {
+    allocator.free(
+      arena->sorted,
+      arena->block_capacity * sizeof(mmath_arena_block *),
+      _Alignof(mmath_arena_block *),
+      allocator.user
+    );
+  }
+
+  allocator.free(arena, sizeof(mmath_arena), _Alignof(mmath_arena), allocator.user);
+}
+
+void mmath_arena_begin(mmath_arena *arena) {
+  mmath_arena_active = arena;
+}
+
+void mmath_arena_end() {
+  mmath_arena_active = NULL;
+}
+
+void mmath_arena_reset(mmath_arena *arena) {
+  memset(arena->free_lists, 0, sizeof(arena->free_lists));
+
+  if (arena->blocks != NULL) {
+    mmath_arena_use_block(arena, arena->blocks);
+  }
+}
+
+void *mmath_alloc(size_t size, size_t alignment) {
+  if (mmath_arena_active != NULL) {
+    return mmath_arena_alloc(mmath_arena_active, size, alignment);
+  }
+  return mmath_alloc_global(size, alignment);
+}
+
+void mmath_free(void *ptr, size_t size, size_t alignment) {
+  if (ptr == NULL) {
+    return;
+  }
+
+  if (mmath_arena_active != NULL && mmath_arena_owns(mmath_arena_active, ptr)) {
+    mmath_arena_release(mmath_arena_active, ptr, size, alignment);
+    return;
+  }
+
+  mmath_free_global(ptr, size, alignment);
+}
+
+void *mmath_alloc_global(size_t size, size_t alignment) {
+  return mmath_allocator_current.alloc(size, alignment, mmath_allocator_current.user);
+}
+
+void mmath_free_global(void *ptr, size_t size, size_t alignment) {
+  if (ptr == NULL) {
+    return;
+  }
+  mmath_allocator_current.free(ptr, size, alignment, mmath_allocator_current.user);
+}
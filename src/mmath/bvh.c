@@ -0,0 +1,689 @@
+#include "mmath/bvh.h"
+#include "mmath_private.h"
+
+#define MMATH_BVH_ALIGN 32
+#define MMATH_BVH_BINS 16
+#define MMATH_BVH_MAX_LEAF 8
+// Bounds the traversal stacks, deeper subtrees are cut off into leaves
+#define MMATH_BVH_MAX_DEPTH 64
+// Cost of visiting a node relative to testing a primitive
+#define MMATH_BVH_TRAVERSAL_COST 1.f
+#define MMATH_BVH_TASKS_PER_THREAD 4
+
+// Bounds being accumulated, kept out of the packed aabb3 layout so they can stay in registers
+typedef struct bvh_box {
+#if defined(MMATH_SSE2)
+  __m128 min;
+  __m128 max;
+#else
+  float min[3];
+  float max[3];
+#endif
+} bvh_box;
+
+typedef struct bvh_bin {
+  bvh_box bounds;
+  size_t count;
+} bvh_bin;
+
+// The best split of a node, bins are numbered along axis and [0, split) go left
+typedef struct bvh_split {
+  size_t axis;
+  size_t split;
+  size_t bin_count;
+  float min;
+  float scale;
+  float cost;
+  aabb3 bounds[2];
+} bvh_split;
+
+typedef struct bvh_task {
+  size_t node;
+  size_t begin;
+  size_t end;
+  size_t depth;
+  aabb3 bounds;
+  aabb3 centroids;
+} bvh_task;
+
+// A subtree over n primitives takes at most 2n - 1 nodes, so each child gets that many slots
+// in `nodes` up front and subtrees can be built independently. The slots left unused by
+// leaves with several primitives are dropped when the nodes are compacted.
+// Partitioning moves the bounds and centroids along with the indices, so every pass over a
+// range reads memory in order.
+typedef struct bvh_builder {
+  uint32_t *indices;
+  aabb3 *bounds;
+  vec3 *centroids;
+  bvh_node *nodes;
+
+  // Parallel builds stop splitting at task_depth and record the subtrees there
+  size_t task_depth;
+  bvh_task *tasks;
+  size_t task_count;
+} bvh_builder;
+
+static inline void bvh_box_empty(bvh_box *out) {
+#if defined(MMATH_SSE2)
+  out->min = _mm_set1_ps(INFINITY);
+  out->max = _mm_set1_ps(-INFINITY);
+#else
+  int k;
+
+  for (k = 0; k < 3; ++k) {
+    out->min[k] = INFINITY;
+    out->max[k] = -INFINITY;
+  }
+#endif
+}
+
+static inline void bvh_box_grow(bvh_box *out, const aabb3 *a) {
+#if defined(MMATH_SSE2)
+  // (min.x, min.y, min.z, max.x) and (min.z, max.x, max.y, max.z), both loads stay inside the box
+  __m128 hi = _mm_loadu_ps(&a->data[2]);
+  out->min = _mm_min_ps(out->min, _mm_loadu_ps(&a->data[0]));
+  out->max = _mm_max_ps(out->max, _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(3, 3, 2, 1)));
+#else
+  int k;
+
+  for (k = 0; k < 3; ++k) {
+    out->min[k] = a->min.data[k] < out->min[k] ? a->min.data[k] : out->min[k];
+    out->max[k] = a->max.data[k] > out->max[k] ? a->max.data[k] : out->max[k];
+  }
+#endif
+}
+
+static inline void bvh_box_union(bvh_box *out, const bvh_box *a) {
+#if defined(MMATH_SSE2)
+  out->min = _mm_min_ps(out->min, a->min);
+  out->max = _mm_max_ps(out->max, a->max);
+#else
+  int k;
+
+  for (k = 0; k < 3; ++k) {
+    out->min[k] = a->min[k] < out->min[k] ? a->min[k] : out->min[k];
+    out->max[k] = a->max[k] > out->max[k] ? a->max[k] : out->max[k];
+  }
+#endif
+}
+
+// Half the surface area, the SAH only compares ratios of areas
+static inline float bvh_box_half_area(const bvh_box *a) {
+#if defined(MMATH_SSE2)
+  __m128 e = _mm_sub_ps(a->max, a->min);
+  __m128 p = _mm_mul_ps(e, _mm_shuffle_ps(e, e, _MM_SHUFFLE(3, 0, 2, 1)));
+  p = _mm_add_ss(_mm_add_ss(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1))), _mm_movehl_ps(p, p));
+  return _mm_cvtss_f32(p);
+#else
+  float x = a->max[0] - a->min[0];
+  float y = a->max[1] - a->min[1];
+  float z = a->max[2] - a->min[2];
+  return x * y + y * z + z * x;
+#endif
+}
+
+static inline void bvh_box_store(aabb3 *out, const bvh_box *a) {
+#if defined(MMATH_SSE2)
+  float max[4];
+
+  // The min row spills into max.x, which the copy of the max row overwrites
+  _mm_storeu_ps(&out->data[0], a->min);
+  _mm_storeu_ps(max, a->max);
+  memcpy(&out->data[3], max, sizeof(vec3));
+#else
+  memcpy(&out->data[0], a->min, sizeof(vec3));
+  memcpy(&out->data[3], a->max, sizeof(vec3));
+#endif
+}
+
+// aabb3_expand without the call, for the centroid bounds of the partition
+static inline void bvh_grow_point(aabb3 *out, const vec3 *p) {
+  int k;
+
+  for (k = 0; k < 3; ++k) {
+    out->min.data[k] = p->data[k] < out->min.data[k] ? p->data[k] : out->min.data[k];
+    out->max.data[k] = p->data[k] > out->max.data[k] ? p->data[k] : out->max.data[k];
+  }
+}
+
+static inline void bvh_swap(bvh_builder *b, size_t i, size_t j) {
+  uint32_t index = b->indices[i];
+  aabb3 bounds = b->bounds[i];
+  vec3 centroid = b->centroids[i];
+
+  b->indices[i] = b->indices[j];
+  b->indices[j] = index;
+  b->bounds[i] = b->bounds[j];
+  b->bounds[j] = bounds;
+  b->centroids[i] = b->centroids[j];
+  b->centroids[j] = centroid;
+}
+
+static inline size_t bvh_bin_index(float c, float min, float scale, size_t bin_count) {
+  int bin = (int) ((c - min) * scale);
+  return bin <= 0 ? 0 : (size_t) bin < bin_count ? (size_t) bin : bin_count - 1;
+}
+
+static void bvh_range_bounds(const bvh_builder *b, aabb3 *out, size_t begin, size_t end) {
+  bvh_box box;
+
+  bvh_box_empty(&box);
+  for (; begin < end; ++begin) {
+    bvh_box_grow(&box, &b->bounds[begin]);
+  }
+  bvh_box_store(out, &box);
+}
+
+// Bins the centroids in [begin, end) along all three axes at once and sweeps the planes between
+// the bins from both sides. Costs are half surface area times primitive count, relative to the
+// node. Returns false when no plane separates the centroids.
+static bool bvh_find_split(
+  const bvh_builder *b,
+  bvh_split *out,
+  size_t begin,
+  size_t end,
+  const aabb3 *bounds,
+  const aabb3 *centroids
+) {
+  bvh_bin bins[3][MMATH_BVH_BINS];
+  float right_costs[MMATH_BVH_BINS], mins[3], scales[3], area;
+  size_t n = end - begin, axis, i, k;
+  bvh_box side;
+
+  // Small nodes get one bin per primitive, the fixed cost of the sweeps dominates near the leaves.
+  // Axes without extent get a scale of 0, which puts everything in the first bin and rules out
+  // every plane along them.
+  out->bin_count = n < MMATH_BVH_BINS ? n : MMATH_BVH_BINS;
+  out->cost = INFINITY;
+  for (axis = 0; axis < 3; ++axis) {
+    float extent = centroids->max.data[axis] - centroids->min.data[axis];
+
+    mins[axis] = centroids->min.data[axis];
+    scales[axis] = extent > 0.f ? (float) out->bin_count / extent : 0.f;
+    for (k = 0; k < out->bin_count; ++k) {
+      bvh_box_empty(&bins[axis][k].bounds);
+      bins[axis][k].count = 0;
+    }
+  }
+
+  for (i = begin; i < end; ++i) {
+    for (axis = 0; axis < 3; ++axis) {
+      bvh_bin *bin = &bins[axis][bvh_bin_index(b->centroids[i].data[axis], mins[axis], scales[axis], out->bin_count)];
+      bvh_box_grow(&bin->bounds, &b->bounds[i]);
+      ++bin->count;
+    }
+  }
+
+  for (axis = 0; axis < 3; ++axis) {
+    size_t count = 0;
+
+    bvh_box_empty(&side);
+    for (k = out->bin_count - 1; k > 0; --k) {
+      bvh_box_union(&side, &bins[axis][k].bounds);
+      count += bins[axis][k].count;
+      right_costs[k] = count != 0 ? bvh_box_half_area(&side) * (float) count : 0.f;
+    }
+
+    count = 0;
+    bvh_box_empty(&side);
+    for (k = 0; k + 1 < out->bin_count; ++k) {
+      float cost;
+
+      bvh_box_union(&side, &bins[axis][k].bounds);
+      count += bins[axis][k].count;
+      if (count == 0 || count == n) {
+        continue;
+      }
+
+      cost = bvh_box_half_area(&side) * (float) count + right_costs[k + 1];
+      if (cost < out->cost) {
+        out->cost = cost;
+        out->axis = axis;
+        out->split = k + 1;
+      }
+    }
+  }
+
+  if (out->cost == INFINITY) {
+    return false;
+  }
+
+  out->min = mins[out->axis];
+  out->scale = scales[out->axis];
+  for (i = 0; i < 2; ++i) {
+    bvh_box_empty(&side);
+    for (k = i == 0 ? 0 : out->split; k < (i == 0 ? out->split : out->bin_count); ++k) {
+      bvh_box_union(&side, &bins[out->axis][k].bounds);
+    }
+    bvh_box_store(&out->bounds[i], &side);
+  }
+
+  area = aabb3_surface_area(bounds) * .5f;
+  out->cost = MMATH_BVH_TRAVERSAL_COST + (area > 0.f ? out->cost / area : 0.f);
+  return true;
+}
+
+// bounds and centroids enclose the primitives and their centroids in [begin, end). The split
+// passes them on to the children, so each node takes one pass to bin and one to partition.
+static void bvh_build(
+  bvh_builder *b,
+  size_t node,
+  size_t begin,
+  size_t end,
+  size_t depth,
+  bool defer,
+  const aabb3 *bounds,
+  const aabb3 *centroids
+) {
+  bvh_node *out = &b->nodes[node];
+  bvh_split split;
+  aabb3 child_centroids[2];
+  size_t n = end - begin, mid, i;
+
+  vec3_copy(&out->min, &bounds->min);
+  vec3_copy(&out->max, &bounds->max);
+  out->offset = (uint32_t) begin;
+  out->count = (uint32_t) n;
+
+  if (n == 1 || depth + 1 >= MMATH_BVH_MAX_DEPTH) {
+    return;
+  }
+
+  if (!bvh_find_split(b, &split, begin, end, bounds, centroids)) {
+    // Every centroid is in the same place, only the leaf size limit forces a split
+    if (n <= MMATH_BVH_MAX_LEAF) {
+      return;
+    }
+    mid = begin + n / 2;
+    bvh_range_bounds(b, &split.bounds[0], begin, mid);
+    bvh_range_bounds(b, &split.bounds[1], mid, end);
+    aabb3_copy(&child_centroids[0], centroids);
+    aabb3_copy(&child_centroids[1], centroids);
+  } else {
+    if (n <= MMATH_BVH_MAX_LEAF && split.cost >= (float) n) {
+      return;
+    }
+
+    aabb3_empty(&child_centroids[0]);
+    aabb3_empty(&child_centroids[1]);
+    mid = begin;
+    for (i = end; mid < i;) {
+      const vec3 *c = &b->centroids[mid];
+
+      if (bvh_bin_index(c->data[split.axis], split.min, split.scale, split.bin_count) < split.split) {
+        bvh_grow_point(&child_centroids[0], c);
+        ++mid;
+      } else {
+        bvh_grow_point(&child_centroids[1], c);
+        bvh_swap(b, mid, --i);
+      }
+    }
+  }
+
+  out->offset = (uint32_t) (node + 2 * (mid - begin));
+  out->count = 0;
+
+  if (defer && depth + 1 == b->task_depth) {
+    bvh_task *tasks = &b->tasks[b->task_count];
+    tasks[0] = (bvh_task) { node + 1, begin, mid, depth + 1, split.bounds[0], child_centroids[0] };
+    tasks[1] = (bvh_task) { out->offset, mid, end, depth + 1, split.bounds[1], child_centroids[1] };
+    b->task_count += 2;
+  } else {
+    bvh_build(b, node + 1, begin, mid, depth + 1, defer, &split.bounds[0], &child_centroids[0]);
+    bvh_build(b, out->offset, mid, end, depth + 1, defer, &split.bounds[1], &child_centroids[1]);
+  }
+}
+
+static void bvh_build_tasks(size_t begin, size_t end, void *user) {
+  bvh_builder *b = (bvh_builder *) user;
+
+  for (; begin < end; ++begin) {
+    const bvh_task *task = &b->tasks[begin];
+    bvh_build(b, task->node, task->begin, task->end, task->depth, false, &task->bounds, &task->centroids);
+  }
+}
+
+static size_t bvh_count_nodes(const bvh_node *nodes, size_t node) {
+  if (nodes[node].count != 0) {
+    return 1;
+  }
+  return 1 + bvh_count_nodes(nodes, node + 1) + bvh_count_nodes(nodes, nodes[node].offset);
+}
+
+static size_t bvh_compact(bvh_node *out, size_t *next, const bvh_node *nodes, size_t node) {
+  size_t index = (*next)++;
+
+  out[index] = nodes[node];
+  if (nodes[node].count == 0) {
+    bvh_compact(out, next, nodes, node + 1);
+    out[index].offset = (uint32_t) bvh_compact(out, next, nodes, nodes[node].offset);
+  }
+  return index;
+}
+
+static void bvh_builder_free(bvh_builder *b, size_t count, size_t tasks) {
+  mmath_free_global(b->nodes, (2 * count - 1) * sizeof(bvh_node), MMATH_BVH_ALIGN);
+  mmath_free_global(b->centroids, count * sizeof(vec3), MMATH_BVH_ALIGN);
+  mmath_free_global(b->tasks, tasks * sizeof(bvh_task), _Alignof(bvh_task));
+}
+
+bvh *bvh_create(const aabb3 *bounds, size_t count, mmath_pool *pool) {
+  bvh *out = (bvh *) mmath_alloc_global(sizeof(bvh), _Alignof(bvh));
+  bvh_builder b;
+  aabb3 root_bounds, root_centroids;
+  size_t threads = pool != NULL ? mmath_pool_threads(pool) : 1;
+  size_t tasks = 0, next = 0, i;
+
+  if (out == NULL) {
+    return NULL;
+  }
+  memset(out, 0, sizeof(bvh));
+  if (count == 0) {
+    return out;
+  }
+  // Node indices are 32 bits
+  if (count > UINT32_MAX / 2) {
+    mmath_free_global(out, sizeof(bvh), _Alignof(bvh));
+    return NULL;
+  }
+
+  memset(&b, 0, sizeof(bvh_builder));
+  if (threads > 1) {
+    for (b.task_depth = 1; ((size_t) 1 << b.task_depth) < threads * MMATH_BVH_TASKS_PER_THREAD; ++b.task_depth) {
+    }
+    tasks = (size_t) 1 << b.task_depth;
+    b.tasks = (bvh_task *) mmath_alloc_global(tasks * sizeof(bvh_task), _Alignof(bvh_task));
+  }
+  b.centroids = (vec3 *) mmath_alloc_global(count * sizeof(vec3), MMATH_BVH_ALIGN);
+  b.nodes = (bvh_node *) mmath_alloc_global((2 * count - 1) * sizeof(bvh_node), MMATH_BVH_ALIGN);
+  out->count = count;
+  out->indices = (uint32_t *) mmath_alloc_global(count * sizeof(uint32_t), MMATH_BVH_ALIGN);
+  out->bounds = (aabb3 *) mmath_alloc_global(count * sizeof(aabb3), MMATH_BVH_ALIGN);
+
+  if ((threads > 1 && b.tasks == NULL) || b.centroids == NULL || b.nodes == NULL
+    || out->indices == NULL || out->bounds == NULL) {
+    bvh_builder_free(&b, count, tasks);
+    bvh_free(out);
+    return NULL;
+  }
+
+  b.indices = out->indices;
+  b.bounds = out->bounds;
+  aabb3_empty(&root_centroids);
+  for (i = 0; i < count; ++i) {
+    out->indices[i] = (uint32_t) i;
+    aabb3_copy(&out->bounds[i], &bounds[i]);
+    aabb3_center(&b.centroids[i], &bounds[i]);
+    bvh_grow_point(&root_centroids, &b.centroids[i]);
+  }
+  bvh_range_bounds(&b, &root_bounds, 0, count);
+  bvh_build(&b, 0, 0, count, 0, b.tasks != NULL, &root_bounds, &root_centroids);
+  if (b.task_count != 0) {
+    mmath_parallel_for(pool, b.task_count, 1, bvh_build_tasks, &b);
+  }
+
+  out->node_count = bvh_count_nodes(b.nodes, 0);
+  out->nodes = (bvh_node *) mmath_alloc_global(out->node_count * sizeof(bvh_node), MMATH_BVH_ALIGN);
+  if (out->nodes == NULL) {
+    out->node_count = 0;
+    bvh_builder_free(&b, count, tasks);
+    bvh_free(out);
+    return NULL;
+  }
+  bvh_compact(out->nodes, &next, b.nodes, 0);
+
+  bvh_builder_free(&b, count, tasks);
+  return out;
+}
+
+void bvh_free(bvh *b) {
+  if (b == NULL) {
+    return;
+  }
+
+  mmath_free_global(b->nodes, b->node_count * sizeof(bvh_node), MMATH_BVH_ALIGN);
+  mmath_free_global(b->indices, b->count * sizeof(uint32_t), MMATH_BVH_ALIGN);
+  mmath_free_global(b->bounds, b->count * sizeof(aabb3), MMATH_BVH_ALIGN);
+  mmath_free_global(b, sizeof(bvh), _Alignof(bvh));
+}
+
+// Ray traversal. Both children of a node are slab tested together, the nearer one is visited
+// first and the other one is pushed with its entry distance, so it is skipped once a closer
+// hit is found.
+typedef struct bvh_ray {
+#if defined(MMATH_SSE2)
+  __m128 origin[3];
+  __m128 inverse[3];
+#else
+  float origin[3];
+  float inverse[3];
+#endif
+} bvh_ray;
+
+typedef struct bvh_stack_entry {
+  uint32_t node;
+  float t;
+} bvh_stack_entry;
+
+static void bvh_ray_init(bvh_ray *ray, const vec3 *origin, const vec3 *direction) {
+  int k;
+
+  // Zero components give infinite inverses, so the slabs of that axis span everything or nothing
+  for (k = 0; k < 3; ++k) {
+#if defined(MMATH_SSE2)
+    ray->origin[k] = _mm_set1_ps(origin->data[k]);
+    ray->inverse[k] = _mm_set1_ps(1.f / direction->data[k]);
+#else
+    ray->origin[k] = origin->data[k];
+    ray->inverse[k] = 1.f / direction->data[k];
+#endif
+  }
+}
+
+// Returns a mask with bit 0 set when the ray enters a within [0, t] and bit 1 for b, and their
+// entry distances
+static inline int bvh_slab2(const bvh_ray *ray, const bvh_node *a, const bvh_node *b, float t, float *near) {
+#if defined(MMATH_SSE2)
+  // Rows (min, offset) and (max, count) of both nodes, transposed to (a.min, a.max, b.min, b.max)
+  // per axis. The fourth row is unused.
+  __m128 axes[4];
+  __m128 lo = _mm_setzero_ps(), hi = _mm_set1_ps(t);
+  float out[4];
+  int k;
+
+  axes[0] = _mm_loadu_ps(&a->min.data[0]);
+  axes[1] = _mm_loadu_ps(&a->max.data[0]);
+  axes[2] = _mm_loadu_ps(&b->min.data[0]);
+  axes[3] = _mm_loadu_ps(&b->max.data[0]);
+  _MM_TRANSPOSE4_PS(axes[0], axes[1], axes[2], axes[3]);
+
+  for (k = 0; k < 3; ++k) {
+    __m128 d = _mm_mul_ps(_mm_sub_ps(axes[k], ray->origin[k]), ray->inverse[k]);
+    __m128 swapped = _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1));
+    // A NaN from 0 * inf (the origin on a slab of an axis the ray is parallel to) loses
+    // against the running bounds
+    lo = _mm_max_ps(_mm_min_ps(d, swapped), lo);
+    hi = _mm_min_ps(_mm_max_ps(d, swapped), hi);
+  }
+
+  _mm_storeu_ps(out, lo);
+  near[0] = out[0];
+  near[1] = out[2];
+  k = _mm_movemask_ps(_mm_cmple_ps(lo, hi));
+  return (k & 1) | ((k >> 1) & 2);
+#else
+  const bvh_node *nodes[2];
+  int mask = 0, i, k;
+
+  nodes[0] = a;
+  nodes[1] = b;
+  for (i = 0; i < 2; ++i) {
+    float lo = 0.f, hi = t;
+
+    for (k = 0; k < 3; ++k) {
+      float d0 = (nodes[i]->min.data[k] - ray->origin[k]) * ray->inverse[k];
+      float d1 = (nodes[i]->max.data[k] - ray->origin[k]) * ray->inverse[k];
+      float d_min = d0 < d1 ? d0 : d1, d_max = d0 < d1 ? d1 : d0;
+      lo = d_min > lo ? d_min : lo;
+      hi = d_max < hi ? d_max : hi;
+    }
+    near[i] = lo;
+    mask |= (lo <= hi) << i;
+  }
+  return mask;
+#endif
+}
+
+static bool bvh_traverse(
+  const bvh *b,
+  const vec3 *origin,
+  const vec3 *direction,
+  float *t,
+  uint32_t *hit,
+  bool any,
+  bvh_ray_fn fn,
+  void *user
+) {
+  bvh_stack_entry stack[MMATH_BVH_MAX_DEPTH];
+  size_t top = 0, node = 0;
+  bvh_ray ray;
+  float near[2];
+  bool found = false;
+
+  if (b->node_count == 0) {
+    return false;
+  }
+  bvh_ray_init(&ray, origin, direction);
+  if (!(bvh_slab2(&ray, &b->nodes[0], &b->nodes[0], *t, near) & 1)) {
+    return false;
+  }
+
+  for (;;) {
+    const bvh_node *n = &b->nodes[node];
+
+    if (n->count == 0) {
+      size_t left = node + 1, right = n->offset;
+      int mask = bvh_slab2(&ray, &b->nodes[left], &b->nodes[right], *t, near);
+
+      if (mask == 3) {
+        if (near[0] <= near[1]) {
+          stack[top++] = (bvh_stack_entry) { (uint32_t) right, near[1] };
+          node = left;
+        } else {
+          stack[top++] = (bvh_stack_entry) { (uint32_t) left, near[0] };
+          node = right;
+        }
+        continue;
+      }
+      if (mask != 0) {
+        node = mask == 1 ? left : right;
+        continue;
+      }
+    } else {
+      size_t i;
+
+      for (i = n->offset; i < n->offset + n->count; ++i) {
+        if (fn(b->indices[i], t, user)) {
+          found = true;
+          if (hit != NULL) {
+            *hit = b->indices[i];
+          }
+          if (any) {
+            return true;
+          }
+        }
+      }
+    }
+
+    // Pop the next subtree the ray still enters before the closest hit
+    do {
+      if (top == 0) {
+        return found;
+      }
+      --top;
+    } while (stack[top].t > *t);
+    node = stack[top].node;
+  }
+}
+
+bool bvh_raycast(
+  const bvh *b,
+  const vec3 *origin,
+  const vec3 *direction,
+  float *t,
+  uint32_t *hit,
+  bvh_ray_fn fn,
+  void *user
+) {
+  return bvh_traverse(b, origin, direction, t, hit, false, fn, user);
+}
+
+bool bvh_occluded(
+  const bvh *b,
+  const vec3 *origin,
+  const vec3 *direction,
+  float t,
+  bvh_ray_fn fn,
+  void *user
+) {
+  return bvh_traverse(b, origin, direction, &t, NULL, true, fn, user);
+}
+
+static inline bool bvh_node_overlaps(const bvh_node *n, const aabb3 *box) {
+#if defined(MMATH_SSE2)
+  // Lane 3 holds offset and count, only the xyz lanes are checked
+  __m128 inside = _mm_and_ps(
+    _mm_cmple_ps(_mm_loadu_ps(&n->min.data[0]), _mm_set_ps(0.f, box->max.z, box->max.y, box->max.x)),
+    _mm_cmpge_ps(_mm_loadu_ps(&n->max.data[0]), _mm_set_ps(0.f, box->min.z, box->min.y, box->min.x))
+  );
+  return (_mm_movemask_ps(inside) & 7) == 7;
+#else
+  return n->min.x <= box->max.x && n->max.x >= box->min.x &&
+    n->min.y <= box->max.y && n->max.y >= box->min.y &&
+    n->min.z <= box->max.z && n->max.z >= box->min.z
+  ;
+#endif
+}
+
+size_t bvh_query_aabb(const bvh *b, const aabb3 *box, uint32_t *out, size_t capacity) {
+  uint32_t stack[MMATH_BVH_MAX_DEPTH];
+  size_t top = 0, n = 0, node = 0;
+
+  if (b->node_count == 0 || !bvh_node_overlaps(&b->nodes[0], box)) {
+    return 0;
+  }
+
+  for (;;) {
+    const bvh_node *current = &b->nodes[node];
+
+    if (current->count == 0) {
+      size_t left = node + 1, right = current->offset;
+      bool hit_left = bvh_node_overlaps(&b->nodes[left], box);
+      bool hit_right = bvh_node_overlaps(&b->nodes[right], box);
+
+      if (hit_left || hit_right) {
+        if (hit_left && hit_right) {
+          stack[top++] = (uint32_t) right;
+        }
+        node = hit_left ? left : right;
+        continue;
+      }
+    } else {
+      size_t i;
+
+      for (i = current->offset; i < current->offset + current->count; ++i) {
+        if (aabb3_intersects(&b->bounds[i], box)) {
+          if (n < capacity) {
+            out[n] = b->indices[i];
+          }
+          ++n;
+        }
+      }
+    }
+
+    if (top == 0) {
+      return n;
+    }
+    node = stack[--top];
+  }
+}
@@ -2,5 +2,134 @@
 #include "mmath_private.h"
 
 float mmath_random() {
-  return (float) rand() / (float) RAND_MAX;
+  return mmath_rng_float(mmath_rng_thread());
+}
+
+#if defined(MMATH_SSE2)
+
+static inline __m128 mmath_select_ps(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Four lanes of mmath_sincosf, returns false when a lane is out of range so the caller
+// can take the scalar path for the whole group
+static inline bool mmath_sincosf_sse2(__m128 *s, __m128 *c, __m128 x) {
+  __m128 abs_x = _mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+  if (_mm_movemask_ps(_mm_cmple_ps(abs_x, _mm_set1_ps(MMATH_SINCOS_MAX))) != 0xf) {
+    return false;
+  }
+
+  __m128i q = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(MMATH_SINCOS_2_PI)));
+  __m128 j = _mm_cvtepi32_ps(q);
+  __m128 r = _mm_sub_ps(x, _mm_mul_ps(j, _mm_set1_ps(MMATH_SINCOS_PI_2_A)));
+  r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(MMATH_SINCOS_PI_2_B)));
+  r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(MMATH_SINCOS_PI_2_C)));
+  r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(MMATH_SINCOS_PI_2_D)));
+  __m128 z = _mm_mul_ps(r, r);
+
+  __m128 sr = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f));
+  sr = _mm_sub_ps(_mm_mul_ps(sr, z), _mm_set1_ps(1.6666654611e-1f));
+  sr = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sr, z), r), r);
+
+  __m128 cr = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(1.388731625493765e-3f));
+  cr = _mm_add_ps(_mm_mul_ps(cr, z), _mm_set1_ps(4.166664568298827e-2f));
+  cr = _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(cr, z), z), _mm_mul_ps(_mm_set1_ps(.5f), z));
+  cr = _mm_add_ps(cr, _mm_set1_ps(1.f));
+
+  __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+  __m128 sin_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30));
+  __m128 cos_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+
+  *s = _mm_xor_ps(mmath_select_ps(swap, cr, sr), sin_sign);
+  *c = _mm_xor_ps(mmath_select_ps(swap, sr, cr), cos_sign);
+  return true;
+}
+
+#endif
+
+void mmath_sincosf_batch(float *s, float *c, const float *x, size_t count) {
+  size_t i = 0;
+
+#if defined(MMATH_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    __m128 vs, vc;
+    if (!mmath_sincosf_sse2(&vs, &vc, _mm_loadu_ps(&x[i]))) {
+      size_t k;
+      for (k = i; k < i + 4; ++k) {
+        float ks, kc;
+        mmath_sincosf(x[k], &ks, &kc);
+        if (s != NULL) {
+          s[k] = ks;
+        }
+        if (c != NULL) {
+          c[k] = kc;
+        }
+      }
+      continue;
+    }
+    if (s != NULL) {
+      _mm_storeu_ps(&s[i], vs);
+    }
+    if (c != NULL) {
+      _mm_storeu_ps(&c[i], vc);
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    float ks, kc;
+    mmath_sincosf(x[i], &ks, &kc);
+    if (s != NULL) {
+      s[i] = ks;
+    }
+    if (c != NULL) {
+      c[i] = kc;
+    }
+  }
+}
+
+static mmath_backend mmath_detect_backend() {
+#if defined(MMATH_HAVE_X86_SIMD)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return MMATH_BACKEND_AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return MMATH_BACKEND_SSE41;
+  }
+#endif
+  return MMATH_BACKEND_SCALAR;
+}
+
+mmath_backend mmath_get_backend() {
+  // Detection is idempotent, so racing first calls all store the same value
+  static int backend = -1;
+
+  if (backend < 0) {
+    mmath_backend detected = mmath_detect_backend();
+    const char *requested = getenv("MMATH_BACKEND");
+
+    if (requested != NULL) {
+      int i;
+      for (i = MMATH_BACKEND_SCALAR; i < (int) detected; ++i) {
+        if (strcmp(requested, mmath_backend_name((mmath_backend) i)) == 0) {
+          detected = (mmath_backend) i;
+          break;
+        }
+      }
+    }
+
+    backend = (int) detected;
+  }
+
+  return (mmath_backend) backend;
+}
+
+const char *mmath_backend_name(mmath_backend backend) {
+  switch (backend) {
+    case MMATH_BACKEND_SCALAR: return "scalar";
+    case MMATH_BACKEND_SSE41: return "sse4.1";
+    case MMATH_BACKEND_AVX2: return "avx2";
+  }
+  return "unknown";
 }
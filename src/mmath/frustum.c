@@ -0,0 +1,201 @@
+#include "mmath/frustum.h"
+#include "mmath_private.h"
+#include "frustum_simd.h"
+
+static void frustum_set_plane(vec4 *out, const mat4 *m, int row, float sign) {
+  float x = m->data[3] + sign * m->data[row];
+  float y = m->data[7] + sign * m->data[4 + row];
+  float z = m->data[11] + sign * m->data[8 + row];
+  float w = m->data[15] + sign * m->data[12 + row];
+  float len = x * x + y * y + z * z;
+
+  // An infinite far plane degenerates to (0, 0, 0, w > 0), which accepts everything as is
+  if (len > 0.f) {
+    len = 1.f / sqrtf(len);
+  } else {
+    len = 1.f;
+  }
+
+  out->x = x * len;
+  out->y = y * len;
+  out->z = z * len;
+  out->w = w * len;
+}
+
+frustum *frustum_from_mat4(frustum *out, const mat4 *m) {
+  frustum_set_plane(&out->planes[0], m, 0, 1.f);
+  frustum_set_plane(&out->planes[1], m, 0, -1.f);
+  frustum_set_plane(&out->planes[2], m, 1, 1.f);
+  frustum_set_plane(&out->planes[3], m, 1, -1.f);
+  frustum_set_plane(&out->planes[4], m, 2, 1.f);
+  frustum_set_plane(&out->planes[5], m, 2, -1.f);
+  return out;
+}
+
+static inline float frustum_plane_distance(const vec4 *p, float x, float y, float z) {
+  return p->x * x + p->y * y + p->z * z + p->w;
+}
+
+bool frustum_intersects_sphere(const frustum *f, const vec3 *center, float radius) {
+  int p;
+  for (p = 0; p < 6; ++p) {
+    if (frustum_plane_distance(&f->planes[p], center->x, center->y, center->z) < -radius) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool frustum_intersects_aabb(const frustum *f, const vec3 *min, const vec3 *max) {
+  int p;
+  for (p = 0; p < 6; ++p) {
+    const vec4 *plane = &f->planes[p];
+    float x = plane->x >= 0.f ? max->x : min->x;
+    float y = plane->y >= 0.f ? max->y : min->y;
+    float z = plane->z >= 0.f ? max->z : min->z;
+    if (frustum_plane_distance(plane, x, y, z) < 0.f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#if defined(MMATH_SSE2)
+
+// Appends the indices of the set lanes without branching on the mask
+static inline size_t frustum_compact4(uint32_t *out, size_t n, size_t i, int mask) {
+  out[n] = (uint32_t) i;
+  n += mask & 1;
+  out[n] = (uint32_t) i + 1;
+  n += (mask >> 1) & 1;
+  out[n] = (uint32_t) i + 2;
+  n += (mask >> 2) & 1;
+  out[n] = (uint32_t) i + 3;
+  n += (mask >> 3) & 1;
+  return n;
+}
+
+#endif
+
+size_t frustum_cull_spheres(
+  uint32_t *out,
+  const frustum *f,
+  const float *x,
+  const float *y,
+  const float *z,
+  const float *radius,
+  size_t count
+) {
+  size_t i = 0, n = 0;
+
+#if defined(MMATH_HAVE_X86_SIMD)
+  if (mmath_get_backend() >= MMATH_BACKEND_AVX2) {
+    i = count & ~(size_t) 7;
+    n = mmath_frustum_cull_spheres_avx2(out, f, x, y, z, radius, i);
+  }
+#endif
+
+#if defined(MMATH_SSE2)
+  {
+    __m128 px[6], py[6], pz[6], pw[6];
+    int p;
+
+    for (p = 0; p < 6; ++p) {
+      px[p] = _mm_set1_ps(f->planes[p].x);
+      py[p] = _mm_set1_ps(f->planes[p].y);
+      pz[p] = _mm_set1_ps(f->planes[p].z);
+      pw[p] = _mm_set1_ps(f->planes[p].w);
+    }
+
+    for (; i + 4 <= count; i += 4) {
+      __m128 cx = _mm_loadu_ps(&x[i]);
+      __m128 cy = _mm_loadu_ps(&y[i]);
+      __m128 cz = _mm_loadu_ps(&z[i]);
+      __m128 r = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&radius[i]));
+      __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+      // Same sums and test as frustum_intersects_sphere, so a NaN stays inside on every path
+      for (p = 0; p < 6; ++p) {
+        __m128 d = _mm_add_ps(
+          _mm_add_ps(_mm_add_ps(_mm_mul_ps(px[p], cx), _mm_mul_ps(py[p], cy)), _mm_mul_ps(pz[p], cz)),
+          pw[p]
+        );
+        inside = _mm_andnot_ps(_mm_cmplt_ps(d, r), inside);
+      }
+
+      n = frustum_compact4(out, n, i, _mm_movemask_ps(inside));
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    vec3 center = { { x[i], y[i], z[i] } };
+    if (frustum_intersects_sphere(f, &center, radius[i])) {
+      out[n++] = (uint32_t) i;
+    }
+  }
+  return n;
+}
+
+size_t frustum_cull_aabbs(
+  uint32_t *out,
+  const frustum *f,
+  const float *min_x,
+  const float *min_y,
+  const float *min_z,
+  const float *max_x,
+  const float *max_y,
+  const float *max_z,
+  size_t count
+) {
+  size_t i = 0, n = 0;
+
+#if defined(MMATH_HAVE_X86_SIMD)
+  if (mmath_get_backend() >= MMATH_BACKEND_AVX2) {
+    i = count & ~(size_t) 7;
+    n = mmath_frustum_cull_aabbs_avx2(out, f, min_x, min_y, min_z, max_x, max_y, max_z, i);
+  }
+#endif
+
+#if defined(MMATH_SSE2)
+  {
+    mmath_frustum_aabb_corners c;
+    __m128 px[6], py[6], pz[6], pw[6];
+    int p;
+
+    mmath_frustum_aabb_corners_init(&c, f, min_x, min_y, min_z, max_x, max_y, max_z);
+    for (p = 0; p < 6; ++p) {
+      px[p] = _mm_set1_ps(f->planes[p].x);
+      py[p] = _mm_set1_ps(f->planes[p].y);
+      pz[p] = _mm_set1_ps(f->planes[p].z);
+      pw[p] = _mm_set1_ps(f->planes[p].w);
+    }
+
+    for (; i + 4 <= count; i += 4) {
+      __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+      for (p = 0; p < 6; ++p) {
+        __m128 d = _mm_add_ps(
+          _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(px[p], _mm_loadu_ps(&c.x[p][i])), _mm_mul_ps(py[p], _mm_loadu_ps(&c.y[p][i]))),
+            _mm_mul_ps(pz[p], _mm_loadu_ps(&c.z[p][i]))
+          ),
+          pw[p]
+        );
+        inside = _mm_andnot_ps(_mm_cmplt_ps(d, _mm_setzero_ps()), inside);
+      }
+
+      n = frustum_compact4(out, n, i, _mm_movemask_ps(inside));
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    vec3 min = { { min_x[i], min_y[i], min_z[i] } };
+    vec3 max = { { max_x[i], max_y[i], max_z[i] } };
+    if (frustum_intersects_aabb(f, &min, &max)) {
+      out[n++] = (uint32_t) i;
+    }
+  }
+  return n;
+}
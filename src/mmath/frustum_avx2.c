@@ -0,0 +1,100 @@
+#include <immintrin.h>
+
+#include "mmath_private.h"
+#include "frustum_simd.h"
+
+static inline size_t frustum_compact8(uint32_t *out, size_t n, size_t i, int mask) {
+  int k;
+  for (k = 0; k < 8; ++k) {
+    out[n] = (uint32_t) (i + k);
+    n += (mask >> k) & 1;
+  }
+  return n;
+}
+
+static inline void frustum_load_planes(__m256 *px, __m256 *py, __m256 *pz, __m256 *pw, const frustum *f) {
+  int p;
+  for (p = 0; p < 6; ++p) {
+    px[p] = _mm256_set1_ps(f->planes[p].x);
+    py[p] = _mm256_set1_ps(f->planes[p].y);
+    pz[p] = _mm256_set1_ps(f->planes[p].z);
+    pw[p] = _mm256_set1_ps(f->planes[p].w);
+  }
+}
+
+size_t mmath_frustum_cull_spheres_avx2(
+  uint32_t *out,
+  const frustum *f,
+  const float *x,
+  const float *y,
+  const float *z,
+  const float *radius,
+  size_t count
+) {
+  __m256 px[6], py[6], pz[6], pw[6];
+  size_t i, n = 0;
+  int p;
+
+  frustum_load_planes(px, py, pz, pw, f);
+
+  for (i = 0; i < count; i += 8) {
+    __m256 cx = _mm256_loadu_ps(&x[i]);
+    __m256 cy = _mm256_loadu_ps(&y[i]);
+    __m256 cz = _mm256_loadu_ps(&z[i]);
+    __m256 r = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(&radius[i]));
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+    // No FMA here, the sums round like frustum_intersects_sphere so every path agrees
+    for (p = 0; p < 6; ++p) {
+      __m256 d = _mm256_add_ps(
+        _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px[p], cx), _mm256_mul_ps(py[p], cy)), _mm256_mul_ps(pz[p], cz)),
+        pw[p]
+      );
+      inside = _mm256_andnot_ps(_mm256_cmp_ps(d, r, _CMP_LT_OQ), inside);
+    }
+
+    n = frustum_compact8(out, n, i, _mm256_movemask_ps(inside));
+  }
+  return n;
+}
+
+size_t mmath_frustum_cull_aabbs_avx2(
+  uint32_t *out,
+  const frustum *f,
+  const float *min_x,
+  const float *min_y,
+  const float *min_z,
+  const float *max_x,
+  const float *max_y,
+  const float *max_z,
+  size_t count
+) {
+  mmath_frustum_aabb_corners c;
+  __m256 px[6], py[6], pz[6], pw[6];
+  size_t i, n = 0;
+  int p;
+
+  mmath_frustum_aabb_corners_init(&c, f, min_x, min_y, min_z, max_x, max_y, max_z);
+  frustum_load_planes(px, py, pz, pw, f);
+
+  for (i = 0; i < count; i += 8) {
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+    for (p = 0; p < 6; ++p) {
+      __m256 d = _mm256_add_ps(
+        _mm256_add_ps(
+          _mm256_add_ps(
+            _mm256_mul_ps(px[p], _mm256_loadu_ps(&c.x[p][i])),
+            _mm256_mul_ps(py[p], _mm256_loadu_ps(&c.y[p][i]))
+          ),
+          _mm256_mul_ps(pz[p], _mm256_loadu_ps(&c.z[p][i]))
+        ),
+        pw[p]
+      );
+      inside = _mm256_andnot_ps(_mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_LT_OQ), inside);
+    }
+
+    n = frustum_compact8(out, n, i, _mm256_movemask_ps(inside));
+  }
+  return n;
+}
@@ -0,0 +1,33 @@
+#ifndef MMATH_FRUSTUM_SIMD_H
+#define MMATH_FRUSTUM_SIMD_H
+
+// Helpers shared by the scalar, SSE2 and AVX2 culling loops
+
+#include "mmath/frustum.h"
+
+// Per plane SoA pointers to the AABB corner furthest along the plane normal
+typedef struct mmath_frustum_aabb_corners {
+  const float *x[6];
+  const float *y[6];
+  const float *z[6];
+} mmath_frustum_aabb_corners;
+
+static inline void mmath_frustum_aabb_corners_init(
+  mmath_frustum_aabb_corners *c,
+  const frustum *f,
+  const float *min_x,
+  const float *min_y,
+  const float *min_z,
+  const float *max_x,
+  const float *max_y,
+  const float *max_z
+) {
+  int p;
+  for (p = 0; p < 6; ++p) {
+    c->x[p] = f->planes[p].x >= 0.f ? max_x : min_x;
+    c->y[p] = f->planes[p].y >= 0.f ? max_y : min_y;
+    c->z[p] = f->planes[p].z >= 0.f ? max_z : min_z;
+  }
+}
+
+#endif // MMATH_FRUSTUM_SIMD_H
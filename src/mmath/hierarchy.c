@@ -0,0 +1,166 @@
+#include "mmath/hierarchy.h"
+#include "mmath_private.h"
+
+#define MMATH_HIERARCHY_ALIGN 32
+#define MMATH_HIERARCHY_ARRAYS 7
+
+static size_t hierarchy_arrays(hierarchy *h, void ***arrays, size_t *sizes) {
+  arrays[0] = (void **) &h->parents, sizes[0] = sizeof(*h->parents);
+  arrays[1] = (void **) &h->depths, sizes[1] = sizeof(*h->depths);
+  arrays[2] = (void **) &h->rotations, sizes[2] = sizeof(*h->rotations);
+  arrays[3] = (void **) &h->translations, sizes[3] = sizeof(*h->translations);
+  arrays[4] = (void **) &h->scales, sizes[4] = sizeof(*h->scales);
+  arrays[5] = (void **) &h->worlds, sizes[5] = sizeof(*h->worlds);
+  arrays[6] = (void **) &h->dirty, sizes[6] = sizeof(*h->dirty);
+  return MMATH_HIERARCHY_ARRAYS;
+}
+
+static bool hierarchy_reserve(hierarchy *h, size_t capacity) {
+  void **arrays[MMATH_HIERARCHY_ARRAYS];
+  void *grown[MMATH_HIERARCHY_ARRAYS];
+  size_t sizes[MMATH_HIERARCHY_ARRAYS];
+  size_t i, n;
+
+  if (capacity <= h->capacity) {
+    return true;
+  }
+
+  n = hierarchy_arrays(h, arrays, sizes);
+  for (i = 0; i < n; ++i) {
+    grown[i] = mmath_alloc_global(capacity * sizes[i], MMATH_HIERARCHY_ALIGN);
+    if (grown[i] == NULL) {
+      while (i-- > 0) {
+        mmath_free_global(grown[i], capacity * sizes[i], MMATH_HIERARCHY_ALIGN);
+      }
+      return false;
+    }
+  }
+
+  for (i = 0; i < n; ++i) {
+    if (*arrays[i] != NULL) {
+      memcpy(grown[i], *arrays[i], h->count * sizes[i]);
+      mmath_free_global(*arrays[i], h->capacity * sizes[i], MMATH_HIERARCHY_ALIGN);
+    }
+    *arrays[i] = grown[i];
+  }
+
+  h->capacity = capacity;
+  return true;
+}
+
+hierarchy *hierarchy_create(size_t capacity) {
+  hierarchy *h = (hierarchy *) mmath_alloc_global(sizeof(hierarchy), _Alignof(hierarchy));
+  if (h == NULL) {
+    return NULL;
+  }
+
+  memset(h, 0, sizeof(hierarchy));
+  if (capacity != 0 && !hierarchy_reserve(h, capacity)) {
+    mmath_free_global(h, sizeof(hierarchy), _Alignof(hierarchy));
+    return NULL;
+  }
+  return h;
+}
+
+void hierarchy_free(hierarchy *h) {
+  void **arrays[MMATH_HIERARCHY_ARRAYS];
+  size_t sizes[MMATH_HIERARCHY_ARRAYS];
+  size_t i, n;
+
+  if (h == NULL) {
+    return;
+  }
+
+  n = hierarchy_arrays(h, arrays, sizes);
+  for (i = 0; i < n; ++i) {
+    mmath_free_global(*arrays[i], h->capacity * sizes[i], MMATH_HIERARCHY_ALIGN);
+  }
+  mmath_free_global(h, sizeof(hierarchy), _Alignof(hierarchy));
+}
+
+void hierarchy_clear(hierarchy *h) {
+  h->count = 0;
+  h->first_dirty = 0;
+}
+
+int32_t hierarchy_add(hierarchy *h, int32_t parent) {
+  uint32_t depth = 0;
+  size_t index = h->count;
+
+  if (parent >= 0) {
+    if ((size_t) parent >= h->count) {
+      return -1;
+    }
+    depth = h->depths[parent] + 1;
+  }
+  if (index > 0 && depth < h->depths[index - 1]) {
+    return -1;
+  }
+  if (index >= (size_t) INT32_MAX) {
+    return -1;
+  }
+  if (index == h->capacity && !hierarchy_reserve(h, h->capacity < 16 ? 16 : h->capacity * 2)) {
+    return -1;
+  }
+
+  h->parents[index] = parent;
+  h->depths[index] = depth;
+  quat_identity(&h->rotations[index]);
+  vec3_zero(&h->translations[index]);
+  vec3_set(&h->scales[index], 1.f, 1.f, 1.f);
+  mat4_identity(&h->worlds[index]);
+  h->dirty[index] = 1;
+  h->count = index + 1;
+
+  if (h->first_dirty > index) {
+    h->first_dirty = index;
+  }
+  return (int32_t) index;
+}
+
+void hierarchy_set_local(hierarchy *h, size_t index, const quat *r, const vec3 *t, const vec3 *s) {
+  quat_copy(&h->rotations[index], r);
+  vec3_copy(&h->translations[index], t);
+  vec3_copy(&h->scales[index], s);
+  hierarchy_mark_dirty(h, index);
+}
+
+void hierarchy_mark_dirty(hierarchy *h, size_t index) {
+  h->dirty[index] = 1;
+  if (h->first_dirty > index) {
+    h->first_dirty = index;
+  }
+}
+
+size_t hierarchy_update(hierarchy *h, uint32_t *updated) {
+  size_t count = h->count;
+  size_t n = 0;
+  size_t i;
+
+  // Parents precede their children, so a dirty flag set while scanning reaches the whole subtree
+  for (i = h->first_dirty; i < count; ++i) {
+    int32_t parent = h->parents[i];
+
+    if (parent >= 0 && h->dirty[parent]) {
+      h->dirty[i] = 1;
+    }
+    if (!h->dirty[i]) {
+      continue;
+    }
+
+    mat4_from_rotation_translation_scale(&h->worlds[i], &h->rotations[i], &h->translations[i], &h->scales[i]);
+    if (parent >= 0) {
+      mat4_multiply(&h->worlds[i], &h->worlds[parent], &h->worlds[i]);
+    }
+    if (updated != NULL) {
+      updated[n] = (uint32_t) i;
+    }
+    ++n;
+  }
+
+  if (h->first_dirty < count) {
+    memset(&h->dirty[h->first_dirty], 0, count - h->first_dirty);
+  }
+  h->first_dirty = count;
+  return n;
+}
@@ -2,12 +2,22 @@
 #include "mmath_private.h"
 
 mat2 *mat2_create() {
-  mat2 *out = malloc(sizeof(mat2));
+  mat2 *out = mmath_alloc(sizeof(mat2), _Alignof(mat2));
   return mat2_identity(out);
 }
 
 void mat2_free(mat2 *a) {
-  free(a);
+  mmath_free(a, sizeof(mat2), _Alignof(mat2));
+}
+
+mat2a *mat2a_create() {
+  mat2a *out = mmath_alloc(sizeof(mat2a), _Alignof(mat2a));
+  mat2_identity(&out->m);
+  return out;
+}
+
+void mat2a_free(mat2a *a) {
+  mmath_free(a, sizeof(mat2a), _Alignof(mat2a));
 }
 
 mat2 *mat2_clone(const mat2 *a) {
@@ -106,8 +116,8 @@ mat2 *mat2_rotate(mat2 *out, const mat2 *a, float angle) {
   float a2 = a->data[2];
   float a3 = a->data[3];
 
-  float s = sinf(angle);
-  float c = cosf(angle);
+  float s, c;
+  mmath_sincosf(angle, &s, &c);
 
   out->data[0] = a0 *  c + a2 * s;
   out->data[1] = a1 *  c + a3 * s;
@@ -132,8 +142,8 @@ mat2 *mat2_scale(mat2 *out, const mat2 *a, const vec2 *v) {
 }
 
 mat2 *mat2_from_rotation(mat2 *out, float angle) {
-  float s = sinf(angle);
-  float c = cosf(angle);
+  float s, c;
+  mmath_sincosf(angle, &s, &c);
 
   out->data[0] =  c;
   out->data[1] =  s;
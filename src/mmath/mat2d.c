@@ -2,12 +2,22 @@
 #include "mmath_private.h"
 
 mat2d *mat2d_create() {
-  mat2d *out = malloc(sizeof(mat2d));
+  mat2d *out = mmath_alloc(sizeof(mat2d), _Alignof(mat2d));
   return mat2d_identity(out);
 }
 
 void mat2d_free(mat2d *a) {
-  free(a);
+  mmath_free(a, sizeof(mat2d), _Alignof(mat2d));
+}
+
+mat2da *mat2da_create() {
+  mat2da *out = mmath_alloc(sizeof(mat2da), _Alignof(mat2da));
+  mat2d_identity(&out->m);
+  return out;
+}
+
+void mat2da_free(mat2da *a) {
+  mmath_free(a, sizeof(mat2da), _Alignof(mat2da));
 }
 
 mat2d *mat2d_clone(const mat2d *a) {
@@ -92,8 +102,8 @@ mat2d *mat2d_rotate(mat2d *out, const mat2d *a, float angle) {
   float a4 = a->data[4];
   float a5 = a->data[5];
 
-  float s = sinf(angle);
-  float c = cosf(angle);
+  float s, c;
+  mmath_sincosf(angle, &s, &c);
 
   out->data[0] = a0 *  c + a2 * s;
   out->data[1] = a1 *  c + a3 * s;
@@ -143,8 +153,8 @@ mat2d *mat2d_translate(mat2d *out, const mat2d *a, const vec2 *v) {
 }
 
 mat2d *mat2d_from_rotation(mat2d *out, float angle) {
-  float s = sinf(angle);
-  float c = cosf(angle);
+  float s, c;
+  mmath_sincosf(angle, &s, &c);
 
   out->data[0] =  c;
   out->data[1] =  s;
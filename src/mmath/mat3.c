@@ -2,12 +2,22 @@
 #include "mmath_private.h"
 
 mat3 *mat3_create() {
-  mat3 *out = malloc(sizeof(mat3));
+  mat3 *out = mmath_alloc(sizeof(mat3), _Alignof(mat3));
   return mat3_identity(out);
 }
 
 void mat3_free(mat3 *a) {
-  free(a);
+  mmath_free(a, sizeof(mat3), _Alignof(mat3));
+}
+
+mat3a *mat3a_create() {
+  mat3a *out = mmath_alloc(sizeof(mat3a), _Alignof(mat3a));
+  mat3_identity(&out->m);
+  return out;
+}
+
+void mat3a_free(mat3a *a) {
+  mmath_free(a, sizeof(mat3a), _Alignof(mat3a));
 }
 
 mat3 *mat3_clone(const mat3 *a) {
@@ -236,8 +246,8 @@ mat3 *mat3_rotate(mat3 *out, const mat3 *a, float angle) {
   float a20 = a->m20;
   float a21 = a->m21;
   float a22 = a->m22;
-  float s = sinf(angle);
-  float c = cosf(angle);
+  float s, c;
+  mmath_sincosf(angle, &s, &c);
 
   out->data[0] = c * a00 + s * a10;
   out->data[1] = c * a01 + s * a11;
@@ -287,8 +297,8 @@ mat3 *mat3_from_translation(mat3 *out, const vec2 *v) {
 }
 
 mat3 *mat3_from_rotation(mat3 *out, float angle) {
-  float s = sinf(angle);
-  float c = cosf(angle);
+  float s, c;
+  mmath_sincosf(angle, &s, &c);
 
   out->data[0] = c;
   out->data[1] = s;
@@ -0,0 +1,445 @@
+#include "mmath/mat3x4.h"
+#include "mmath_private.h"
+
+#if defined(MMATH_SSE2)
+#define MAT3X4_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps((v), (v), _MM_SHUFFLE(w, z, y, x))
+
+static inline __m128 mat3x4_cross_sse2(__m128 a, __m128 b) {
+  return _mm_sub_ps(
+    _mm_mul_ps(MAT3X4_SWIZZLE(a, 1, 2, 0, 3), MAT3X4_SWIZZLE(b, 2, 0, 1, 3)),
+    _mm_mul_ps(MAT3X4_SWIZZLE(a, 2, 0, 1, 3), MAT3X4_SWIZZLE(b, 1, 2, 0, 3))
+  );
+}
+
+// Row r of a * b, b is affine so its implicit bottom row only adds a's translation
+static inline __m128 mat3x4_row_sse2(__m128 a, const __m128 *b) {
+  __m128 r = _mm_mul_ps(MAT3X4_SWIZZLE(a, 0, 0, 0, 0), b[0]);
+  r = _mm_add_ps(r, _mm_mul_ps(MAT3X4_SWIZZLE(a, 1, 1, 1, 1), b[1]));
+  r = _mm_add_ps(r, _mm_mul_ps(MAT3X4_SWIZZLE(a, 2, 2, 2, 2), b[2]));
+  return _mm_add_ps(r, _mm_and_ps(a, _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1))));
+}
+#endif
+
+mat3x4 *mat3x4_create() {
+  mat3x4 *out = mmath_alloc(sizeof(mat3x4), _Alignof(mat3x4));
+  return mat3x4_identity(out);
+}
+
+void mat3x4_free(mat3x4 *a) {
+  mmath_free(a, sizeof(mat3x4), _Alignof(mat3x4));
+}
+
+mat3x4a *mat3x4a_create() {
+  mat3x4a *out = mmath_alloc(sizeof(mat3x4a), _Alignof(mat3x4a));
+  mat3x4_identity(&out->m);
+  return out;
+}
+
+void mat3x4a_free(mat3x4a *a) {
+  mmath_free(a, sizeof(mat3x4a), _Alignof(mat3x4a));
+}
+
+mat3x4 *mat3x4_clone(const mat3x4 *a) {
+  mat3x4 *out = mmath_alloc(sizeof(mat3x4), _Alignof(mat3x4));
+  return mat3x4_copy(out, a);
+}
+
+mat3x4 *mat3x4_copy(mat3x4 *out, const mat3x4 *a) {
+  memmove(out->data, a->data, sizeof(out->data));
+  return out;
+}
+
+mat3x4 *mat3x4_identity(mat3x4 *out) {
+  memset(out->data, 0, sizeof(out->data));
+  out->data[0] = 1.f;
+  out->data[5] = 1.f;
+  out->data[10] = 1.f;
+  return out;
+}
+
+mat3x4 *mat3x4_from_mat4(mat3x4 *out, const mat4 *a) {
+#if defined(MMATH_SSE2)
+  __m128 c0 = _mm_loadu_ps(&a->data[0]);
+  __m128 c1 = _mm_loadu_ps(&a->data[4]);
+  __m128 c2 = _mm_loadu_ps(&a->data[8]);
+  __m128 c3 = _mm_loadu_ps(&a->data[12]);
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  _mm_storeu_ps(&out->data[0], c0);
+  _mm_storeu_ps(&out->data[4], c1);
+  _mm_storeu_ps(&out->data[8], c2);
+#else
+  float a00 = a->data[0], a01 = a->data[1], a02 = a->data[2];
+  float a10 = a->data[4], a11 = a->data[5], a12 = a->data[6];
+  float a20 = a->data[8], a21 = a->data[9], a22 = a->data[10];
+  float a30 = a->data[12], a31 = a->data[13], a32 = a->data[14];
+
+  out->data[0] = a00;
+  out->data[1] = a10;
+  out->data[2] = a20;
+  out->data[3] = a30;
+  out->data[4] = a01;
+  out->data[5] = a11;
+  out->data[6] = a21;
+  out->data[7] = a31;
+  out->data[8] = a02;
+  out->data[9] = a12;
+  out->data[10] = a22;
+  out->data[11] = a32;
+#endif
+  return out;
+}
+
+mat3x4 *mat3x4_from_rotation_translation_scale(
+  mat3x4 *out,
+  const quat *q,
+  const vec3 *v,
+  const vec3 *s
+) {
+  float x = q->x, y = q->y, z = q->z, w = q->w;
+  float x2 = x + x;
+  float y2 = y + y;
+  float z2 = z + z;
+
+  float xx = x * x2;
+  float xy = x * y2;
+  float xz = x * z2;
+  float yy = y * y2;
+  float yz = y * z2;
+  float zz = z * z2;
+  float wx = w * x2;
+  float wy = w * y2;
+  float wz = w * z2;
+  float sx = s->x;
+  float sy = s->y;
+  float sz = s->z;
+
+  out->data[0] = (1.f - (yy + zz)) * sx;
+  out->data[1] = (xy - wz) * sy;
+  out->data[2] = (xz + wy) * sz;
+  out->data[3] = v->x;
+  out->data[4] = (xy + wz) * sx;
+  out->data[5] = (1.f - (xx + zz)) * sy;
+  out->data[6] = (yz - wx) * sz;
+  out->data[7] = v->y;
+  out->data[8] = (xz - wy) * sx;
+  out->data[9] = (yz + wx) * sy;
+  out->data[10] = (1.f - (xx + yy)) * sz;
+  out->data[11] = v->z;
+  return out;
+}
+
+mat3x4 *mat3x4_multiply(mat3x4 *out, const mat3x4 *a, const mat3x4 *b) {
+#if defined(MMATH_SSE2)
+  __m128 rows[3];
+  __m128 a0 = _mm_loadu_ps(&a->data[0]);
+  __m128 a1 = _mm_loadu_ps(&a->data[4]);
+  __m128 a2 = _mm_loadu_ps(&a->data[8]);
+
+  rows[0] = _mm_loadu_ps(&b->data[0]);
+  rows[1] = _mm_loadu_ps(&b->data[4]);
+  rows[2] = _mm_loadu_ps(&b->data[8]);
+
+  _mm_storeu_ps(&out->data[0], mat3x4_row_sse2(a0, rows));
+  _mm_storeu_ps(&out->data[4], mat3x4_row_sse2(a1, rows));
+  _mm_storeu_ps(&out->data[8], mat3x4_row_sse2(a2, rows));
+#else
+  float a00 = a->data[0], a01 = a->data[1], a02 = a->data[2], a03 = a->data[3];
+  float a10 = a->data[4], a11 = a->data[5], a12 = a->data[6], a13 = a->data[7];
+  float a20 = a->data[8], a21 = a->data[9], a22 = a->data[10], a23 = a->data[11];
+
+  float b00 = b->data[0], b01 = b->data[1], b02 = b->data[2], b03 = b->data[3];
+  float b10 = b->data[4], b11 = b->data[5], b12 = b->data[6], b13 = b->data[7];
+  float b20 = b->data[8], b21 = b->data[9], b22 = b->data[10], b23 = b->data[11];
+
+  out->data[0] = a00 * b00 + a01 * b10 + a02 * b20;
+  out->data[1] = a00 * b01 + a01 * b11 + a02 * b21;
+  out->data[2] = a00 * b02 + a01 * b12 + a02 * b22;
+  out->data[3] = a00 * b03 + a01 * b13 + a02 * b23 + a03;
+  out->data[4] = a10 * b00 + a11 * b10 + a12 * b20;
+  out->data[5] = a10 * b01 + a11 * b11 + a12 * b21;
+  out->data[6] = a10 * b02 + a11 * b12 + a12 * b22;
+  out->data[7] = a10 * b03 + a11 * b13 + a12 * b23 + a13;
+  out->data[8] = a20 * b00 + a21 * b10 + a22 * b20;
+  out->data[9] = a20 * b01 + a21 * b11 + a22 * b21;
+  out->data[10] = a20 * b02 + a21 * b12 + a22 * b22;
+  out->data[11] = a20 * b03 + a21 * b13 + a22 * b23 + a23;
+#endif
+  return out;
+}
+
+// The columns of the inverse upper 3x3 are the cross products of its rows divided by the determinant
+static inline bool mat3x4_invert_kernel(mat3x4 *out, const mat3x4 *a) {
+#if defined(MMATH_SSE2)
+  __m128 r0 = _mm_loadu_ps(&a->data[0]);
+  __m128 r1 = _mm_loadu_ps(&a->data[4]);
+  __m128 r2 = _mm_loadu_ps(&a->data[8]);
+
+  // The cross products are 0 in w, which also keeps the translation out of the determinant
+  __m128 c0 = mat3x4_cross_sse2(r1, r2);
+  __m128 c1 = mat3x4_cross_sse2(r2, r0);
+  __m128 c2 = mat3x4_cross_sse2(r0, r1);
+
+  __m128 d = _mm_mul_ps(r0, c0);
+  d = _mm_add_ps(d, MAT3X4_SWIZZLE(d, 1, 0, 3, 2));
+  d = _mm_add_ps(d, MAT3X4_SWIZZLE(d, 2, 3, 0, 1));
+
+  if (_mm_cvtss_f32(d) == 0.f) {
+    return false;
+  }
+
+  d = _mm_div_ps(_mm_set1_ps(1.f), d);
+  c0 = _mm_mul_ps(c0, d);
+  c1 = _mm_mul_ps(c1, d);
+  c2 = _mm_mul_ps(c2, d);
+
+  // -(inverse * t), transposed into the w lane of each row
+  __m128 t = _mm_setzero_ps();
+  t = _mm_sub_ps(t, _mm_mul_ps(c0, MAT3X4_SWIZZLE(r0, 3, 3, 3, 3)));
+  t = _mm_sub_ps(t, _mm_mul_ps(c1, MAT3X4_SWIZZLE(r1, 3, 3, 3, 3)));
+  t = _mm_sub_ps(t, _mm_mul_ps(c2, MAT3X4_SWIZZLE(r2, 3, 3, 3, 3)));
+
+  _MM_TRANSPOSE4_PS(c0, c1, c2, t);
+  _mm_storeu_ps(&out->data[0], c0);
+  _mm_storeu_ps(&out->data[4], c1);
+  _mm_storeu_ps(&out->data[8], c2);
+#else
+  float a00 = a->data[0], a01 = a->data[1], a02 = a->data[2], a03 = a->data[3];
+  float a10 = a->data[4], a11 = a->data[5], a12 = a->data[6], a13 = a->data[7];
+  float a20 = a->data[8], a21 = a->data[9], a22 = a->data[10], a23 = a->data[11];
+
+  float b00 = a11 * a22 - a12 * a21;
+  float b01 = a02 * a21 - a01 * a22;
+  float b02 = a01 * a12 - a02 * a11;
+  float b10 = a12 * a20 - a10 * a22;
+  float b11 = a00 * a22 - a02 * a20;
+  float b12 = a02 * a10 - a00 * a12;
+  float b20 = a10 * a21 - a11 * a20;
+  float b21 = a01 * a20 - a00 * a21;
+  float b22 = a00 * a11 - a01 * a10;
+
+  float det = a00 * b00 + a01 * b10 + a02 * b20;
+
+  if (det == 0.f) {
+    return false;
+  }
+
+  det = 1.f / det;
+  b00 *= det; b01 *= det; b02 *= det;
+  b10 *= det; b11 *= det; b12 *= det;
+  b20 *= det; b21 *= det; b22 *= det;
+
+  out->data[0] = b00;
+  out->data[1] = b01;
+  out->data[2] = b02;
+  out->data[3] = -(b00 * a03 + b01 * a13 + b02 * a23);
+  out->data[4] = b10;
+  out->data[5] = b11;
+  out->data[6] = b12;
+  out->data[7] = -(b10 * a03 + b11 * a13 + b12 * a23);
+  out->data[8] = b20;
+  out->data[9] = b21;
+  out->data[10] = b22;
+  out->data[11] = -(b20 * a03 + b21 * a13 + b22 * a23);
+#endif
+  return true;
+}
+
+mat3x4 *mat3x4_invert(mat3x4 *out, const mat3x4 *a) {
+  return mat3x4_invert_kernel(out, a) ? out : NULL;
+}
+
+vec3 *mat3x4_transform_point(vec3 *out, const vec3 *a, const mat3x4 *m) {
+  float x = a->x, y = a->y, z = a->z;
+  out->x = m->data[0] * x + m->data[1] * y + m->data[2] * z + m->data[3];
+  out->y = m->data[4] * x + m->data[5] * y + m->data[6] * z + m->data[7];
+  out->z = m->data[8] * x + m->data[9] * y + m->data[10] * z + m->data[11];
+  return out;
+}
+
+vec3 *mat3x4_transform_vector(vec3 *out, const vec3 *a, const mat3x4 *m) {
+  float x = a->x, y = a->y, z = a->z;
+  out->x = m->data[0] * x + m->data[1] * y + m->data[2] * z;
+  out->y = m->data[4] * x + m->data[5] * y + m->data[6] * z;
+  out->z = m->data[8] * x + m->data[9] * y + m->data[10] * z;
+  return out;
+}
+
+mat3x4 *mat3x4_from_mat4_batch(mat3x4 *out, const mat4 *a, size_t count) {
+  size_t i;
+
+  for (i = 0; i < count; ++i) {
+    mat3x4_from_mat4(&out[i], &a[i]);
+  }
+
+  return out;
+}
+
+mat3x4 *mat3x4_from_rotation_translation_scale_batch(
+  mat3x4 *out,
+  const quat *q,
+  const vec3 *v,
+  const vec3 *s,
+  size_t count
+) {
+  size_t i;
+
+  for (i = 0; i < count; ++i) {
+    mat3x4_from_rotation_translation_scale(&out[i], &q[i], &v[i], &s[i]);
+  }
+
+  return out;
+}
+
+mat3x4 *mat3x4_multiply_batch(mat3x4 *out, const mat3x4 *a, const mat3x4 *b, size_t count) {
+  size_t i;
+
+  for (i = 0; i < count; ++i) {
+    mat3x4_multiply(&out[i], &a[i], &b[i]);
+  }
+
+  return out;
+}
+
+size_t mat3x4_invert_batch(mat3x4 *out, const mat3x4 *a, size_t count, uint32_t *failed) {
+  size_t failures = 0;
+  size_t i, j;
+
+  for (i = 0; i < count; i += 32) {
+    size_t n = count - i < 32 ? count - i : 32;
+    uint32_t bits = 0;
+
+    for (j = 0; j < n; ++j) {
+      bits |= (uint32_t) !mat3x4_invert_kernel(&out[i + j], &a[i + j]) << j;
+    }
+    if (failed != NULL) {
+      failed[i / 32] = bits;
+    }
+    while (bits != 0) {
+      bits &= bits - 1;
+      ++failures;
+    }
+  }
+
+  return failures;
+}
+
+static vec3 *mat3x4_transform_batch(
+  vec3 *out,
+  size_t out_stride,
+  const vec3 *a,
+  size_t a_stride,
+  size_t count,
+  const mat3x4 *m,
+  float w
+) {
+  unsigned char *dst = (unsigned char *) out;
+  const unsigned char *src = (const unsigned char *) a;
+  size_t i = 0;
+
+#if defined(MMATH_SSE2)
+  // Packed arrays go 4 points at a time, transposed to x/y/z lanes and back
+  if (out_stride == sizeof(vec3) && a_stride == sizeof(vec3)) {
+    __m128 m00 = _mm_set1_ps(m->data[0]), m01 = _mm_set1_ps(m->data[1]), m02 = _mm_set1_ps(m->data[2]);
+    __m128 m10 = _mm_set1_ps(m->data[4]), m11 = _mm_set1_ps(m->data[5]), m12 = _mm_set1_ps(m->data[6]);
+    __m128 m20 = _mm_set1_ps(m->data[8]), m21 = _mm_set1_ps(m->data[9]), m22 = _mm_set1_ps(m->data[10]);
+    __m128 t0 = _mm_set1_ps(m->data[3] * w), t1 = _mm_set1_ps(m->data[7] * w), t2 = _mm_set1_ps(m->data[11] * w);
+
+    for (; i + 4 <= count; i += 4, dst += 4 * sizeof(vec3), src += 4 * sizeof(vec3)) {
+      // (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3)
+      __m128 p0 = _mm_loadu_ps((const float *) src);
+      __m128 p1 = _mm_loadu_ps((const float *) src + 4);
+      __m128 p2 = _mm_loadu_ps((const float *) src + 8);
+
+      __m128 x = _mm_shuffle_ps(p0, _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(1, 0, 3, 2)), _MM_SHUFFLE(3, 0, 3, 0));
+      __m128 y = _mm_shuffle_ps(
+        _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(0, 0, 1, 1)),
+        _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(2, 2, 3, 3)),
+        _MM_SHUFFLE(2, 0, 2, 0)
+      );
+      __m128 z = _mm_shuffle_ps(
+        _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 1, 2, 2)),
+        _mm_shuffle_ps(p2, p2, _MM_SHUFFLE(3, 3, 0, 0)),
+        _MM_SHUFFLE(2, 0, 2, 0)
+      );
+
+      __m128 ox = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_add_ps(_mm_mul_ps(m02, z), t0));
+      __m128 oy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_add_ps(_mm_mul_ps(m12, z), t1));
+      __m128 oz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_add_ps(_mm_mul_ps(m22, z), t2));
+
+      _mm_storeu_ps((float *) dst, _mm_shuffle_ps(
+        _mm_shuffle_ps(ox, oy, _MM_SHUFFLE(0, 0, 0, 0)),
+        _mm_shuffle_ps(oz, ox, _MM_SHUFFLE(1, 1, 0, 0)),
+        _MM_SHUFFLE(2, 0, 2, 0)
+      ));
+      _mm_storeu_ps((float *) dst + 4, _mm_shuffle_ps(
+        _mm_shuffle_ps(oy, oz, _MM_SHUFFLE(1, 1, 1, 1)),
+        _mm_shuffle_ps(ox, oy, _MM_SHUFFLE(2, 2, 2, 2)),
+        _MM_SHUFFLE(2, 0, 2, 0)
+      ));
+      _mm_storeu_ps((float *) dst + 8, _mm_shuffle_ps(
+        _mm_shuffle_ps(oz, ox, _MM_SHUFFLE(3, 3, 2, 2)),
+        _mm_shuffle_ps(oy, oz, _MM_SHUFFLE(3, 3, 3, 3)),
+        _MM_SHUFFLE(2, 0, 2, 0)
+      ));
+    }
+  }
+#endif
+
+  for (; i < count; ++i, dst += out_stride, src += a_stride) {
+    const vec3 *v = (const vec3 *) src;
+    vec3 *o = (vec3 *) dst;
+    float x = v->x, y = v->y, z = v->z;
+    o->x = m->data[0] * x + m->data[1] * y + m->data[2] * z + m->data[3] * w;
+    o->y = m->data[4] * x + m->data[5] * y + m->data[6] * z + m->data[7] * w;
+    o->z = m->data[8] * x + m->data[9] * y + m->data[10] * z + m->data[11] * w;
+  }
+
+  return out;
+}
+
+vec3 *mat3x4_transform_point_batch(
+  vec3 *out,
+  size_t out_stride,
+  const vec3 *a,
+  size_t a_stride,
+  size_t count,
+  const mat3x4 *m
+) {
+  return mat3x4_transform_batch(out, out_stride, a, a_stride, count, m, 1.f);
+}
+
+vec3 *mat3x4_transform_vector_batch(
+  vec3 *out,
+  size_t out_stride,
+  const vec3 *a,
+  size_t a_stride,
+  size_t count,
+  const mat3x4 *m
+) {
+  return mat3x4_transform_batch(out, out_stride, a, a_stride, count, m, 0.f);
+}
+
+bool mat3x4_exact_equals(const mat3x4 *a, const mat3x4 *b) {
+  int i;
+
+  for (i = 0; i < 12; ++i) {
+    if (a->data[i] != b->data[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool mat3x4_equals(const mat3x4 *a, const mat3x4 *b) {
+  int i;
+
+  for (i = 0; i < 12; ++i) {
+    float x = a->data[i], y = b->data[i];
+    if (!(fabsf(x - y) <= MMATH_EPSILON * fmaxf(1.f, fmaxf(fabsf(x), fabsf(y))))) {
+      return false;
+    }
+  }
+
+  return true;
+}
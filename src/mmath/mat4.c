@@ -2,12 +2,22 @@
 #include "mmath_private.h"
 
 mat4 *mat4_create() {
-  mat4 *out = malloc(sizeof(mat4));
+  mat4 *out = mmath_alloc(sizeof(mat4), _Alignof(mat4));
   return mat4_identity(out);
 }
 
 void mat4_free(mat4 *a) {
-  free(a);
+  mmath_free(a, sizeof(mat4), _Alignof(mat4));
+}
+
+mat4a *mat4a_create() {
+  mat4a *out = mmath_alloc(sizeof(mat4a), _Alignof(mat4a));
+  mat4_identity(&out->m);
+  return out;
+}
+
+void mat4a_free(mat4a *a) {
+  mmath_free(a, sizeof(mat4a), _Alignof(mat4a));
 }
 
 mat4 *mat4_clone(const mat4 *a) {
@@ -96,7 +106,7 @@ mat4 *mat4_set(
   return out;
 }
 
-mat4 *mat4_transpose(mat4 *out, const mat4 *a) {
+static mat4 *mat4_transpose_fallback(mat4 *out, const mat4 *a) {
   if (out == a) {
     float a01 = a->data[1];
     float a02 = a->data[2];
@@ -138,7 +148,7 @@ mat4 *mat4_transpose(mat4 *out, const mat4 *a) {
   return out;
 }
 
-mat4 *mat4_invert(mat4 *out, const mat4 *a) {
+static mat4 *mat4_invert_fallback(mat4 *out, const mat4 *a) {
   float a00 = a->data[0], a01 = a->data[1], a02 = a->data[2], a03 = a->data[3];
   float a10 = a->data[4], a11 = a->data[5], a12 = a->data[6], a13 = a->data[7];
   float a20 = a->data[8], a21 = a->data[9], a22 = a->data[10], a23 = a->data[11];
@@ -185,7 +195,7 @@ mat4 *mat4_invert(mat4 *out, const mat4 *a) {
   return out;
 }
 
-mat4 *mat4_adjoint(mat4 *out, const mat4 *a) {
+static mat4 *mat4_adjoint_fallback(mat4 *out, const mat4 *a) {
   float a00 = a->data[0], a01 = a->data[1], a02 = a->data[2], a03 = a->data[3];
   float a10 = a->data[4], a11 = a->data[5], a12 = a->data[6], a13 = a->data[7];
   float a20 = a->data[8], a21 = a->data[9], a22 = a->data[10], a23 = a->data[11];
@@ -233,7 +243,7 @@ float mat4_determinant(const mat4 *a) {
   return b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06;
 }
 
-mat4 *mat4_multiply(mat4 *out, const mat4 *a, const mat4 *b) {
+static mat4 *mat4_multiply_fallback(mat4 *out, const mat4 *a, const mat4 *b) {
   float a00 = a->data[0], a01 = a->data[1], a02 = a->data[2], a03 = a->data[3];
   float a10 = a->data[4], a11 = a->data[5], a12 = a->data[6], a13 = a->data[7];
   float a20 = a->data[8], a21 = a->data[9], a22 = a->data[10], a23 = a->data[11];
@@ -267,6 +277,293 @@ mat4 *mat4_multiply(mat4 *out, const mat4 *a, const mat4 *b) {
   return out;
 }
 
+// See mmath_mat4_multiply_batch_sse for the arguments
+static void mat4_multiply_batch_fallback(
+  mat4 *out,
+  const mat4 *a,
+  size_t a_step,
+  const uint32_t *indices,
+  const mat4 *b,
+  size_t count
+) {
+  size_t i;
+
+  for (i = 0; i < count; ++i) {
+    mat4_multiply_fallback(&out[i], indices != NULL ? &a[indices[i]] : &a[i * a_step], &b[i]);
+  }
+}
+
+static struct {
+  mat4 *(*transpose)(mat4 *out, const mat4 *a);
+  mat4 *(*invert)(mat4 *out, const mat4 *a);
+  mat4 *(*adjoint)(mat4 *out, const mat4 *a);
+  mat4 *(*multiply)(mat4 *out, const mat4 *a, const mat4 *b);
+  void (*multiply_batch)(
+    mat4 *out,
+    const mat4 *a,
+    size_t a_step,
+    const uint32_t *indices,
+    const mat4 *b,
+    size_t count
+  );
+} mat4_kernels = {
+  mat4_transpose_fallback,
+  mat4_invert_fallback,
+  mat4_adjoint_fallback,
+  mat4_multiply_fallback,
+  mat4_multiply_batch_fallback
+};
+
+#if defined(MMATH_HAVE_X86_SIMD)
+__attribute__((constructor)) static void mat4_select_kernels() {
+  switch (mmath_get_backend()) {
+    case MMATH_BACKEND_AVX2:
+      mat4_kernels.transpose = mmath_mat4_transpose_avx2;
+      mat4_kernels.invert = mmath_mat4_invert_avx2;
+      mat4_kernels.adjoint = mmath_mat4_adjoint_avx2;
+      mat4_kernels.multiply = mmath_mat4_multiply_avx2;
+      mat4_kernels.multiply_batch = mmath_mat4_multiply_batch_avx2;
+      break;
+    case MMATH_BACKEND_SSE41:
+      mat4_kernels.transpose = mmath_mat4_transpose_sse41;
+      mat4_kernels.invert = mmath_mat4_invert_sse41;
+      mat4_kernels.adjoint = mmath_mat4_adjoint_sse41;
+      mat4_kernels.multiply = mmath_mat4_multiply_sse41;
+      mat4_kernels.multiply_batch = mmath_mat4_multiply_batch_sse41;
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+mat4 *mat4_transpose(mat4 *out, const mat4 *a) {
+  return mat4_kernels.transpose(out, a);
+}
+
+mat4 *mat4_invert(mat4 *out, const mat4 *a) {
+  return mat4_kernels.invert(out, a);
+}
+
+mat4 *mat4_adjoint(mat4 *out, const mat4 *a) {
+  return mat4_kernels.adjoint(out, a);
+}
+
+#if defined(MMATH_SSE2)
+#define MAT4_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps((v), (v), _MM_SHUFFLE(w, z, y, x))
+
+static inline __m128 mat4_cross_sse2(__m128 a, __m128 b) {
+  return _mm_sub_ps(
+    _mm_mul_ps(MAT4_SWIZZLE(a, 1, 2, 0, 3), MAT4_SWIZZLE(b, 2, 0, 1, 3)),
+    _mm_mul_ps(MAT4_SWIZZLE(a, 2, 0, 1, 3), MAT4_SWIZZLE(b, 1, 2, 0, 3))
+  );
+}
+
+// Writes the inverse 3x3 rows r0..r2 as columns and -(inverse * t) as the translation
+static inline void mat4_store_affine_inverse_sse2(mat4 *out, __m128 r0, __m128 r1, __m128 r2, __m128 t) {
+  __m128 r3 = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+  __m128 p = _mm_mul_ps(r0, MAT4_SWIZZLE(t, 0, 0, 0, 0));
+  p = _mm_add_ps(p, _mm_mul_ps(r1, MAT4_SWIZZLE(t, 1, 1, 1, 1)));
+  p = _mm_add_ps(p, _mm_mul_ps(r2, MAT4_SWIZZLE(t, 2, 2, 2, 2)));
+
+  _mm_storeu_ps(&out->data[0], r0);
+  _mm_storeu_ps(&out->data[4], r1);
+  _mm_storeu_ps(&out->data[8], r2);
+  _mm_storeu_ps(&out->data[12], _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), p));
+}
+#endif
+
+// The rows of the inverse upper 3x3 are the cross products of its columns divided by the determinant
+static inline bool mat4_invert_affine_kernel(mat4 *out, const mat4 *a) {
+#if defined(MMATH_SSE2)
+  __m128 c0 = _mm_loadu_ps(&a->data[0]);
+  __m128 c1 = _mm_loadu_ps(&a->data[4]);
+  __m128 c2 = _mm_loadu_ps(&a->data[8]);
+  __m128 t = _mm_loadu_ps(&a->data[12]);
+
+  __m128 r0 = mat4_cross_sse2(c1, c2);
+  __m128 r1 = mat4_cross_sse2(c2, c0);
+  __m128 r2 = mat4_cross_sse2(c0, c1);
+
+  // r0.w is 0, so the w lane drops out of the dot product
+  __m128 d = _mm_mul_ps(c0, r0);
+  d = _mm_add_ps(d, MAT4_SWIZZLE(d, 1, 0, 3, 2));
+  d = _mm_add_ps(d, MAT4_SWIZZLE(d, 2, 3, 0, 1));
+
+  if (_mm_cvtss_f32(d) == 0.f) {
+    return false;
+  }
+
+  d = _mm_div_ps(_mm_set1_ps(1.f), d);
+  mat4_store_affine_inverse_sse2(out, _mm_mul_ps(r0, d), _mm_mul_ps(r1, d), _mm_mul_ps(r2, d), t);
+#else
+  float a00 = a->data[0], a01 = a->data[1], a02 = a->data[2];
+  float a10 = a->data[4], a11 = a->data[5], a12 = a->data[6];
+  float a20 = a->data[8], a21 = a->data[9], a22 = a->data[10];
+  float tx = a->data[12], ty = a->data[13], tz = a->data[14];
+
+  float b00 = a11 * a22 - a12 * a21;
+  float b01 = a12 * a20 - a10 * a22;
+  float b02 = a10 * a21 - a11 * a20;
+  float b10 = a21 * a02 - a22 * a01;
+  float b11 = a22 * a00 - a20 * a02;
+  float b12 = a20 * a01 - a21 * a00;
+  float b20 = a01 * a12 - a02 * a11;
+  float b21 = a02 * a10 - a00 * a12;
+  float b22 = a00 * a11 - a01 * a10;
+
+  float det = a00 * b00 + a01 * b01 + a02 * b02;
+
+  if (det == 0.f) {
+    return false;
+  }
+
+  det = 1.f / det;
+  b00 *= det; b01 *= det; b02 *= det;
+  b10 *= det; b11 *= det; b12 *= det;
+  b20 *= det; b21 *= det; b22 *= det;
+
+  out->data[0] = b00;
+  out->data[1] = b10;
+  out->data[2] = b20;
+  out->data[3] = 0.f;
+  out->data[4] = b01;
+  out->data[5] = b11;
+  out->data[6] = b21;
+  out->data[7] = 0.f;
+  out->data[8] = b02;
+  out->data[9] = b12;
+  out->data[10] = b22;
+  out->data[11] = 0.f;
+  out->data[12] = -(b00 * tx + b01 * ty + b02 * tz);
+  out->data[13] = -(b10 * tx + b11 * ty + b12 * tz);
+  out->data[14] = -(b20 * tx + b21 * ty + b22 * tz);
+  out->data[15] = 1.f;
+#endif
+  return true;
+}
+
+static inline void mat4_invert_rigid_kernel(mat4 *out, const mat4 *a) {
+#if defined(MMATH_SSE2)
+  // The rows of the inverse rotation are the columns of a
+  mat4_store_affine_inverse_sse2(
+    out,
+    _mm_loadu_ps(&a->data[0]),
+    _mm_loadu_ps(&a->data[4]),
+    _mm_loadu_ps(&a->data[8]),
+    _mm_loadu_ps(&a->data[12])
+  );
+#else
+  float a00 = a->data[0], a01 = a->data[1], a02 = a->data[2];
+  float a10 = a->data[4], a11 = a->data[5], a12 = a->data[6];
+  float a20 = a->data[8], a21 = a->data[9], a22 = a->data[10];
+  float tx = a->data[12], ty = a->data[13], tz = a->data[14];
+
+  out->data[0] = a00;
+  out->data[1] = a10;
+  out->data[2] = a20;
+  out->data[3] = 0.f;
+  out->data[4] = a01;
+  out->data[5] = a11;
+  out->data[6] = a21;
+  out->data[7] = 0.f;
+  out->data[8] = a02;
+  out->data[9] = a12;
+  out->data[10] = a22;
+  out->data[11] = 0.f;
+  out->data[12] = -(a00 * tx + a01 * ty + a02 * tz);
+  out->data[13] = -(a10 * tx + a11 * ty + a12 * tz);
+  out->data[14] = -(a20 * tx + a21 * ty + a22 * tz);
+  out->data[15] = 1.f;
+#endif
+}
+
+mat4 *mat4_invert_affine(mat4 *out, const mat4 *a) {
+  return mat4_invert_affine_kernel(out, a) ? out : NULL;
+}
+
+mat4 *mat4_invert_rigid(mat4 *out, const mat4 *a) {
+  mat4_invert_rigid_kernel(out, a);
+  return out;
+}
+
+size_t mat4_invert_batch(mat4 *out, const mat4 *a, size_t count, uint32_t *failed) {
+  mat4 *(*invert)(mat4 *out, const mat4 *a) = mat4_kernels.invert;
+  size_t failures = 0;
+  size_t i, j;
+
+  for (i = 0; i < count; i += 32) {
+    size_t n = count - i < 32 ? count - i : 32;
+    uint32_t bits = 0;
+
+    for (j = 0; j < n; ++j) {
+      if (invert(&out[i + j], &a[i + j]) == NULL) {
+        bits |= (uint32_t) 1 << j;
+        ++failures;
+      }
+    }
+    if (failed != NULL) {
+      failed[i / 32] = bits;
+    }
+  }
+
+  return failures;
+}
+
+size_t mat4_invert_affine_batch(mat4 *out, const mat4 *a, size_t count, uint32_t *failed) {
+  size_t failures = 0;
+  size_t i, j;
+
+  for (i = 0; i < count; i += 32) {
+    size_t n = count - i < 32 ? count - i : 32;
+    uint32_t bits = 0;
+
+    for (j = 0; j < n; ++j) {
+      bits |= (uint32_t) !mat4_invert_affine_kernel(&out[i + j], &a[i + j]) << j;
+    }
+    if (failed != NULL) {
+      failed[i / 32] = bits;
+    }
+    while (bits != 0) {
+      bits &= bits - 1;
+      ++failures;
+    }
+  }
+
+  return failures;
+}
+
+mat4 *mat4_invert_rigid_batch(mat4 *out, const mat4 *a, size_t count) {
+  size_t i;
+
+  for (i = 0; i < count; ++i) {
+    mat4_invert_rigid_kernel(&out[i], &a[i]);
+  }
+
+  return out;
+}
+
+mat4 *mat4_multiply(mat4 *out, const mat4 *a, const mat4 *b) {
+  return mat4_kernels.multiply(out, a, b);
+}
+
+mat4 *mat4_multiply_batch(mat4 *out, const mat4 *a, const mat4 *b, size_t count) {
+  mat4_kernels.multiply_batch(out, a, 0, NULL, b, count);
+  return out;
+}
+
+mat4 *mat4_multiply_pairs_batch(mat4 *out, const mat4 *a, const mat4 *b, size_t count) {
+  mat4_kernels.multiply_batch(out, a, 1, NULL, b, count);
+  return out;
+}
+
+mat4 *mat4_multiply_indexed_batch(mat4 *out, const mat4 *a, const uint32_t *indices, const mat4 *b, size_t count) {
+  mat4_kernels.multiply_batch(out, a, 0, indices, b, count);
+  return out;
+}
+
 mat4 *mat4_translate(mat4 *out, const mat4 *a, const vec4 *v) {
   float x = v->x, y = v->y, z = v->z;
   float a00, a01, a02, a03;
@@ -311,8 +608,7 @@ mat4 *mat4_rotate(mat4 *out, const mat4 *a, float angle, const vec3 *axis) {
   y *= len;
   z *= len;
 
-  s = sinf(angle);
-  c = cosf(angle);
+  mmath_sincosf(angle, &s, &c);
   t = 1.f - c;
   
   a00 = a->data[0]; a01 = a->data[1]; a02 = a->data[2]; a03 = a->data[3];
@@ -349,8 +645,8 @@ mat4 *mat4_rotate(mat4 *out, const mat4 *a, float angle, const vec3 *axis) {
 }
 
 mat4 *mat4_rotate_x(mat4 *out, const mat4 *a, float angle) {
-  float s = sinf(angle);
-  float c = cosf(angle);
+  float s, c;
+  mmath_sincosf(angle, &s, &c);
   float a10 = a->data[4];
   float a11 = a->data[5];
   float a12 = a->data[6];
@@ -384,8 +680,8 @@ mat4 *mat4_rotate_x(mat4 *out, const mat4 *a, float angle) {
 }
 
 mat4 *mat4_rotate_y(mat4 *out, const mat4 *a, float angle) {
-  float s = sinf(angle);
-  float c = cosf(angle);
+  float s, c;
+  mmath_sincosf(angle, &s, &c);
   float a00 = a->data[0];
   float a01 = a->data[1];
   float a02 = a->data[2];
@@ -419,8 +715,8 @@ mat4 *mat4_rotate_y(mat4 *out, const mat4 *a, float angle) {
 }
 
 mat4 *mat4_rotate_z(mat4 *out, const mat4 *a, float angle) {
-  float s = sinf(angle);
-  float c = cosf(angle);
+  float s, c;
+  mmath_sincosf(angle, &s, &c);
   float a00 = a->data[0];
   float a01 = a->data[1];
   float a02 = a->data[2];
@@ -507,8 +803,7 @@ mat4 *mat4_from_rotation(mat4 *out, float angle, const vec3 *axis) {
   y *= len;
   z *= len;
 
-  s = sinf(angle);
-  c = cosf(angle);
+  mmath_sincosf(angle, &s, &c);
   t = 1.f - c;
   
   out->data[0] = x * x * t + c;
@@ -530,10 +825,7 @@ mat4 *mat4_from_rotation(mat4 *out, float angle, const vec3 *axis) {
   return out;
 }
 
-mat4 *mat4_from_rotation_x(mat4 *out, float angle) {
-  float s = sinf(angle);
-  float c = cosf(angle);
-
+static inline void mat4_set_rotation_x(mat4 *out, float s, float c) {
   out->data[0] = 1;
   out->data[1] = 0;
   out->data[2] = 0;
@@ -550,13 +842,30 @@ mat4 *mat4_from_rotation_x(mat4 *out, float angle) {
   out->data[13] = 0;
   out->data[14] = 0;
   out->data[15] = 1;
+}
+
+mat4 *mat4_from_rotation_x(mat4 *out, float angle) {
+  float s, c;
+  mmath_sincosf(angle, &s, &c);
+  mat4_set_rotation_x(out, s, c);
   return out;
 }
 
-mat4 *mat4_from_rotation_y(mat4 *out, float angle) {
-  float s = sinf(angle);
-  float c = cosf(angle);
+mat4 *mat4_from_rotation_x_batch(mat4 *out, const float *angles, size_t count) {
+  float s[MMATH_ROTATION_BATCH], c[MMATH_ROTATION_BATCH];
+  size_t i, k, n;
 
+  for (i = 0; i < count; i += n) {
+    n = count - i < MMATH_ROTATION_BATCH ? count - i : MMATH_ROTATION_BATCH;
+    mmath_sincosf_batch(s, c, &angles[i], n);
+    for (k = 0; k < n; ++k) {
+      mat4_set_rotation_x(&out[i + k], s[k], c[k]);
+    }
+  }
+  return out;
+}
+
+static inline void mat4_set_rotation_y(mat4 *out, float s, float c) {
   out->data[0] = c;
   out->data[1] = 0;
   out->data[2] = -s;
@@ -573,13 +882,30 @@ mat4 *mat4_from_rotation_y(mat4 *out, float angle) {
   out->data[13] = 0;
   out->data[14] = 0;
   out->data[15] = 1;
+}
+
+mat4 *mat4_from_rotation_y(mat4 *out, float angle) {
+  float s, c;
+  mmath_sincosf(angle, &s, &c);
+  mat4_set_rotation_y(out, s, c);
   return out;
 }
 
-mat4 *mat4_from_rotation_z(mat4 *out, float angle) {
-  float s = sinf(angle);
-  float c = cosf(angle);
+mat4 *mat4_from_rotation_y_batch(mat4 *out, const float *angles, size_t count) {
+  float s[MMATH_ROTATION_BATCH], c[MMATH_ROTATION_BATCH];
+  size_t i, k, n;
+
+  for (i = 0; i < count; i += n) {
+    n = count - i < MMATH_ROTATION_BATCH ? count - i : MMATH_ROTATION_BATCH;
+    mmath_sincosf_batch(s, c, &angles[i], n);
+    for (k = 0; k < n; ++k) {
+      mat4_set_rotation_y(&out[i + k], s[k], c[k]);
+    }
+  }
+  return out;
+}
 
+static inline void mat4_set_rotation_z(mat4 *out, float s, float c) {
   out->data[0] = c;
   out->data[1] = s;
   out->data[2] = 0;
@@ -596,6 +922,26 @@ mat4 *mat4_from_rotation_z(mat4 *out, float angle) {
   out->data[13] = 0;
   out->data[14] = 0;
   out->data[15] = 1;
+}
+
+mat4 *mat4_from_rotation_z(mat4 *out, float angle) {
+  float s, c;
+  mmath_sincosf(angle, &s, &c);
+  mat4_set_rotation_z(out, s, c);
+  return out;
+}
+
+mat4 *mat4_from_rotation_z_batch(mat4 *out, const float *angles, size_t count) {
+  float s[MMATH_ROTATION_BATCH], c[MMATH_ROTATION_BATCH];
+  size_t i, k, n;
+
+  for (i = 0; i < count; i += n) {
+    n = count - i < MMATH_ROTATION_BATCH ? count - i : MMATH_ROTATION_BATCH;
+    mmath_sincosf_batch(s, c, &angles[i], n);
+    for (k = 0; k < n; ++k) {
+      mat4_set_rotation_z(&out[i + k], s[k], c[k]);
+    }
+  }
   return out;
 }
 
@@ -672,7 +1018,53 @@ mat4 *mat4_from_quat2(mat4 *out, const quat2 *a) {
     translation.z = (az * bw + aw * bz + ax * by - ay * bx) * 2;
   }
 
-  return mat4_from_rotation_translation(out, a, &translation);
+  return mat4_from_rotation_translation(out, (const quat *) a, &translation);
+}
+
+mat4 *mat4_from_mat3x4(mat4 *out, const mat3x4 *a) {
+#if defined(MMATH_SSE2)
+  __m128 c0 = _mm_loadu_ps(&a->data[0]);
+  __m128 c1 = _mm_loadu_ps(&a->data[4]);
+  __m128 c2 = _mm_loadu_ps(&a->data[8]);
+  __m128 c3 = _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  _mm_storeu_ps(&out->data[0], c0);
+  _mm_storeu_ps(&out->data[4], c1);
+  _mm_storeu_ps(&out->data[8], c2);
+  _mm_storeu_ps(&out->data[12], c3);
+#else
+  float a00 = a->data[0], a01 = a->data[1], a02 = a->data[2], a03 = a->data[3];
+  float a10 = a->data[4], a11 = a->data[5], a12 = a->data[6], a13 = a->data[7];
+  float a20 = a->data[8], a21 = a->data[9], a22 = a->data[10], a23 = a->data[11];
+
+  out->data[0] = a00;
+  out->data[1] = a10;
+  out->data[2] = a20;
+  out->data[3] = 0.f;
+  out->data[4] = a01;
+  out->data[5] = a11;
+  out->data[6] = a21;
+  out->data[7] = 0.f;
+  out->data[8] = a02;
+  out->data[9] = a12;
+  out->data[10] = a22;
+  out->data[11] = 0.f;
+  out->data[12] = a03;
+  out->data[13] = a13;
+  out->data[14] = a23;
+  out->data[15] = 1.f;
+#endif
+  return out;
+}
+
+mat4 *mat4_from_mat3x4_batch(mat4 *out, const mat3x4 *a, size_t count) {
+  size_t i;
+
+  for (i = 0; i < count; ++i) {
+    mat4_from_mat3x4(&out[i], &a[i]);
+  }
+
+  return out;
 }
 
 vec3 *mat4_get_translation(vec3 *out, const mat4 *m) {
@@ -777,6 +1169,474 @@ mat4 *mat4_from_rotation_translation_scale(
   return out;
 }
 
+#if defined(MMATH_SSE2)
+// Four TRS matrices from x/y/z(/w) lanes, premultiplied by the broadcast parent p when it is not NULL
+static void mat4_trs_store4_sse2(mat4 *out, const __m128 *q, const __m128 *t, const __m128 *s, const __m128 *p) {
+  __m128 one = _mm_set1_ps(1.f), zero = _mm_setzero_ps();
+  __m128 x2 = _mm_add_ps(q[0], q[0]), y2 = _mm_add_ps(q[1], q[1]), z2 = _mm_add_ps(q[2], q[2]);
+  __m128 xx = _mm_mul_ps(q[0], x2), xy = _mm_mul_ps(q[0], y2), xz = _mm_mul_ps(q[0], z2);
+  __m128 yy = _mm_mul_ps(q[1], y2), yz = _mm_mul_ps(q[1], z2), zz = _mm_mul_ps(q[2], z2);
+  __m128 wx = _mm_mul_ps(q[3], x2), wy = _mm_mul_ps(q[3], y2), wz = _mm_mul_ps(q[3], z2);
+  __m128 c[16];
+  int j, k;
+
+  c[0] = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), s[0]);
+  c[1] = _mm_mul_ps(_mm_add_ps(xy, wz), s[0]);
+  c[2] = _mm_mul_ps(_mm_sub_ps(xz, wy), s[0]);
+  c[3] = zero;
+  c[4] = _mm_mul_ps(_mm_sub_ps(xy, wz), s[1]);
+  c[5] = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), s[1]);
+  c[6] = _mm_mul_ps(_mm_add_ps(yz, wx), s[1]);
+  c[7] = zero;
+  c[8] = _mm_mul_ps(_mm_add_ps(xz, wy), s[2]);
+  c[9] = _mm_mul_ps(_mm_sub_ps(yz, wx), s[2]);
+  c[10] = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), s[2]);
+  c[11] = zero;
+  c[12] = t[0];
+  c[13] = t[1];
+  c[14] = t[2];
+  c[15] = one;
+
+  if (p != NULL) {
+    // The local matrices are affine, so every column skips a term
+    __m128 r[16];
+    for (j = 0; j < 4; ++j) {
+      for (k = 0; k < 4; ++k) {
+        r[4 * j + k] = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(p[k], c[4 * j]), _mm_mul_ps(p[4 + k], c[4 * j + 1])),
+          _mm_mul_ps(p[8 + k], c[4 * j + 2])
+        );
+      }
+    }
+    for (k = 0; k < 4; ++k) {
+      c[k] = r[k];
+      c[4 + k] = r[4 + k];
+      c[8 + k] = r[8 + k];
+      c[12 + k] = _mm_add_ps(r[12 + k], p[12 + k]);
+    }
+  }
+
+  for (j = 0; j < 4; ++j) {
+    _MM_TRANSPOSE4_PS(c[4 * j], c[4 * j + 1], c[4 * j + 2], c[4 * j + 3]);
+    for (k = 0; k < 4; ++k) {
+      _mm_storeu_ps(&out[k].data[4 * j], c[4 * j + k]);
+    }
+  }
+}
+
+// x/y/z lanes of four packed vec3s
+static inline void mat4_load_vec3x4_sse2(__m128 *out, const vec3 *v) {
+  // (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3)
+  __m128 p0 = _mm_loadu_ps(&v[0].x);
+  __m128 p1 = _mm_loadu_ps(&v[1].y);
+  __m128 p2 = _mm_loadu_ps(&v[2].z);
+
+  out[0] = _mm_shuffle_ps(p0, _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(1, 0, 3, 2)), _MM_SHUFFLE(3, 0, 3, 0));
+  out[1] = _mm_shuffle_ps(
+    _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(0, 0, 1, 1)),
+    _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(2, 2, 3, 3)),
+    _MM_SHUFFLE(2, 0, 2, 0)
+  );
+  out[2] = _mm_shuffle_ps(
+    _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 1, 2, 2)),
+    _mm_shuffle_ps(p2, p2, _MM_SHUFFLE(3, 3, 0, 0)),
+    _MM_SHUFFLE(2, 0, 2, 0)
+  );
+}
+
+static const __m128 *mat4_broadcast_sse2(__m128 *out, const mat4 *m) {
+  int k;
+
+  if (m == NULL) {
+    return NULL;
+  }
+  for (k = 0; k < 16; ++k) {
+    out[k] = _mm_set1_ps(m->data[k]);
+  }
+  return out;
+}
+#endif
+
+mat4 *mat4_from_rotation_translation_scale_batch(
+  mat4 *out,
+  const quat *q,
+  const vec3 *v,
+  const vec3 *s,
+  const mat4 *parent,
+  size_t count
+) {
+  mat4 p;
+  size_t i = 0;
+
+  // The parent may be one of the outputs
+  if (parent != NULL) {
+    parent = mat4_copy(&p, parent);
+  }
+
+#if defined(MMATH_SSE2)
+  {
+    __m128 pb[16], qs[4], ts[3], ss[3];
+    const __m128 *pp = mat4_broadcast_sse2(pb, parent);
+
+    for (; i + 4 <= count; i += 4) {
+      qs[0] = _mm_loadu_ps(&q[i].x);
+      qs[1] = _mm_loadu_ps(&q[i + 1].x);
+      qs[2] = _mm_loadu_ps(&q[i + 2].x);
+      qs[3] = _mm_loadu_ps(&q[i + 3].x);
+      _MM_TRANSPOSE4_PS(qs[0], qs[1], qs[2], qs[3]);
+      mat4_load_vec3x4_sse2(ts, &v[i]);
+      mat4_load_vec3x4_sse2(ss, &s[i]);
+      mat4_trs_store4_sse2(&out[i], qs, ts, ss, pp);
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    mat4_from_rotation_translation_scale(&out[i], &q[i], &v[i], &s[i]);
+    if (parent != NULL) {
+      mat4_multiply(&out[i], parent, &out[i]);
+    }
+  }
+
+  return out;
+}
+
+mat4 *mat4_from_rotation_translation_scale_batch_soa(
+  mat4 *out,
+  const float *const q[4],
+  const float *const v[3],
+  const float *const s[3],
+  const mat4 *parent,
+  size_t count
+) {
+  mat4 p;
+  size_t i = 0;
+
+  if (parent != NULL) {
+    parent = mat4_copy(&p, parent);
+  }
+
+#if defined(MMATH_SSE2)
+  {
+    __m128 pb[16], qs[4], ts[3], ss[3];
+    const __m128 *pp = mat4_broadcast_sse2(pb, parent);
+    int k;
+
+    for (; i + 4 <= count; i += 4) {
+      for (k = 0; k < 4; ++k) {
+        qs[k] = _mm_loadu_ps(&q[k][i]);
+      }
+      for (k = 0; k < 3; ++k) {
+        ts[k] = _mm_loadu_ps(&v[k][i]);
+        ss[k] = _mm_loadu_ps(&s[k][i]);
+      }
+      mat4_trs_store4_sse2(&out[i], qs, ts, ss, pp);
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    quat qi;
+    vec3 vi, si;
+    quat_set(&qi, q[0][i], q[1][i], q[2][i], q[3][i]);
+    vec3_set(&vi, v[0][i], v[1][i], v[2][i]);
+    vec3_set(&si, s[0][i], s[1][i], s[2][i]);
+    mat4_from_rotation_translation_scale(&out[i], &qi, &vi, &si);
+    if (parent != NULL) {
+      mat4_multiply(&out[i], parent, &out[i]);
+    }
+  }
+
+  return out;
+}
+
+// Picks the largest of |w|, |x|, |y|, |z| from the diagonal and derives the others from it
+static void mat4_rotation_to_quat(
+  quat *out,
+  float r00, float r01, float r02,
+  float r10, float r11, float r12,
+  float r20, float r21, float r22
+) {
+  float dx = r21 - r12, dy = r02 - r20, dz = r10 - r01;
+  float sxy = r01 + r10, sxz = r02 + r20, syz = r12 + r21;
+  int mw = r00 + r11 + r22 > 0.f;
+  int mx = !mw && r00 > r11 && r00 > r22;
+  int my = !mw && !mx && r11 > r22;
+  float t = mw ? 1.f + r00 + r11 + r22
+    : mx ? 1.f + r00 - r11 - r22
+    : my ? 1.f - r00 + r11 - r22
+    : 1.f - r00 - r11 + r22;
+  float scale = .5f / sqrtf(t);
+
+  out->x = (mw ? dx : mx ? t : my ? sxy : sxz) * scale;
+  out->y = (mw ? dy : mx ? sxy : my ? t : syz) * scale;
+  out->z = (mw ? dz : mx ? sxz : my ? syz : t) * scale;
+  out->w = (mw ? t : mx ? dx : my ? dy : dz) * scale;
+}
+
+// A column whose length drops below this fraction of its original length during Gram-Schmidt
+// was a linear combination of the previous ones, squared since it compares squared lengths
+#define MAT4_DECOMPOSE_EPSILON_SQ 1e-10f
+
+static bool mat4_decompose_kernel(quat *r, vec3 *t, vec3 *s, vec3 *shear, const mat4 *m) {
+  const float *d = m->data;
+  float x0 = d[0], x1 = d[1], x2 = d[2];
+  float y0 = d[4], y1 = d[5], y2 = d[6];
+  float z0 = d[8], z1 = d[9], z2 = d[10];
+  float yy = y0 * y0 + y1 * y1 + y2 * y2;
+  float zz = z0 * z0 + z1 * z1 + z2 * z2;
+  float sx, sy, sz, kxy, kxz, kyz, inv;
+
+  // Gram-Schmidt, each column loses its projections on the previous ones and keeps them as shear
+  sx = sqrtf(x0 * x0 + x1 * x1 + x2 * x2);
+  if (sx == 0.f) {
+    return false;
+  }
+  inv = 1.f / sx;
+  x0 *= inv; x1 *= inv; x2 *= inv;
+
+  kxy = x0 * y0 + x1 * y1 + x2 * y2;
+  y0 -= kxy * x0; y1 -= kxy * x1; y2 -= kxy * x2;
+  sy = y0 * y0 + y1 * y1 + y2 * y2;
+  if (sy <= MAT4_DECOMPOSE_EPSILON_SQ * yy) {
+    return false;
+  }
+  sy = sqrtf(sy);
+  inv = 1.f / sy;
+  y0 *= inv; y1 *= inv; y2 *= inv;
+  kxy *= inv;
+
+  kxz = x0 * z0 + x1 * z1 + x2 * z2;
+  z0 -= kxz * x0; z1 -= kxz * x1; z2 -= kxz * x2;
+  kyz = y0 * z0 + y1 * z1 + y2 * z2;
+  z0 -= kyz * y0; z1 -= kyz * y1; z2 -= kyz * y2;
+  sz = z0 * z0 + z1 * z1 + z2 * z2;
+  if (sz <= MAT4_DECOMPOSE_EPSILON_SQ * zz) {
+    return false;
+  }
+  sz = sqrtf(sz);
+  inv = 1.f / sz;
+  z0 *= inv; z1 *= inv; z2 *= inv;
+  kxz *= inv;
+  kyz *= inv;
+
+  // A reflection goes into the scale, negating all three keeps the shear unchanged
+  if (x0 * (y1 * z2 - y2 * z1) + x1 * (y2 * z0 - y0 * z2) + x2 * (y0 * z1 - y1 * z0) < 0.f) {
+    sx = -sx; sy = -sy; sz = -sz;
+    x0 = -x0; x1 = -x1; x2 = -x2;
+    y0 = -y0; y1 = -y1; y2 = -y2;
+    z0 = -z0; z1 = -z1; z2 = -z2;
+  }
+
+  mat4_rotation_to_quat(r, x0, y0, z0, x1, y1, z1, x2, y2, z2);
+  vec3_set(t, d[12], d[13], d[14]);
+  vec3_set(s, sx, sy, sz);
+  if (shear != NULL) {
+    vec3_set(shear, kxy, kxz, kyz);
+  }
+  return true;
+}
+
+bool mat4_decompose(quat *r, vec3 *t, vec3 *s, vec3 *shear, const mat4 *m) {
+  return mat4_decompose_kernel(r, t, s, shear, m);
+}
+
+#if defined(MMATH_SSE2)
+static inline void mat4_store_vec3x4_sse2(vec3 *out, const __m128 *v) {
+  __m128 x = v[0], y = v[1], z = v[2];
+
+  _mm_storeu_ps(&out[0].x, _mm_shuffle_ps(
+    _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)),
+    _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+    _MM_SHUFFLE(2, 0, 2, 0)
+  ));
+  _mm_storeu_ps(&out[1].y, _mm_shuffle_ps(
+    _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+    _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+    _MM_SHUFFLE(2, 0, 2, 0)
+  ));
+  _mm_storeu_ps(&out[2].z, _mm_shuffle_ps(
+    _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+    _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+    _MM_SHUFFLE(2, 0, 2, 0)
+  ));
+}
+
+static inline __m128 mat4_select_sse2(__m128 a, __m128 b, __m128 mask) {
+  return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+}
+
+static inline __m128 mat4_dot3_sse2(const __m128 *a, const __m128 *b) {
+  return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_mul_ps(a[2], b[2]));
+}
+
+// a -= k * b
+static inline void mat4_sub_scaled3_sse2(__m128 *a, __m128 k, const __m128 *b) {
+  a[0] = _mm_sub_ps(a[0], _mm_mul_ps(k, b[0]));
+  a[1] = _mm_sub_ps(a[1], _mm_mul_ps(k, b[1]));
+  a[2] = _mm_sub_ps(a[2], _mm_mul_ps(k, b[2]));
+}
+
+static inline void mat4_mul3_sse2(__m128 *a, __m128 k) {
+  a[0] = _mm_mul_ps(a[0], k);
+  a[1] = _mm_mul_ps(a[1], k);
+  a[2] = _mm_mul_ps(a[2], k);
+}
+
+// mat4_decompose_kernel on four matrices in x/y/z/w lanes, returns false without writing
+// anything when one of them is singular
+static bool mat4_decompose4_sse2(quat *r, vec3 *t, vec3 *s, vec3 *shear, const mat4 *m) {
+  __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f);
+  __m128 x[4], y[4], z[4], w[4], sc[3], sh[3], q[4];
+  __m128 kxy, kxz, kyz, yy, zz, inv, fail, flip, eps = _mm_set1_ps(MAT4_DECOMPOSE_EPSILON_SQ);
+  __m128 dx, dy, dz, sxy, sxz, syz, mw, mx, my, tr;
+  int k;
+
+  for (k = 0; k < 4; ++k) {
+    x[k] = _mm_loadu_ps(&m[k].data[0]);
+    y[k] = _mm_loadu_ps(&m[k].data[4]);
+    z[k] = _mm_loadu_ps(&m[k].data[8]);
+    w[k] = _mm_loadu_ps(&m[k].data[12]);
+  }
+  _MM_TRANSPOSE4_PS(x[0], x[1], x[2], x[3]);
+  _MM_TRANSPOSE4_PS(y[0], y[1], y[2], y[3]);
+  _MM_TRANSPOSE4_PS(z[0], z[1], z[2], z[3]);
+  _MM_TRANSPOSE4_PS(w[0], w[1], w[2], w[3]);
+
+  yy = _mm_mul_ps(eps, mat4_dot3_sse2(y, y));
+  zz = _mm_mul_ps(eps, mat4_dot3_sse2(z, z));
+
+  sc[0] = _mm_sqrt_ps(mat4_dot3_sse2(x, x));
+  fail = _mm_cmpeq_ps(sc[0], zero);
+  mat4_mul3_sse2(x, _mm_div_ps(one, sc[0]));
+
+  kxy = mat4_dot3_sse2(x, y);
+  mat4_sub_scaled3_sse2(y, kxy, x);
+  sc[1] = mat4_dot3_sse2(y, y);
+  fail = _mm_or_ps(fail, _mm_cmple_ps(sc[1], yy));
+  sc[1] = _mm_sqrt_ps(sc[1]);
+  inv = _mm_div_ps(one, sc[1]);
+  mat4_mul3_sse2(y, inv);
+  kxy = _mm_mul_ps(kxy, inv);
+
+  kxz = mat4_dot3_sse2(x, z);
+  mat4_sub_scaled3_sse2(z, kxz, x);
+  kyz = mat4_dot3_sse2(y, z);
+  mat4_sub_scaled3_sse2(z, kyz, y);
+  sc[2] = mat4_dot3_sse2(z, z);
+  fail = _mm_or_ps(fail, _mm_cmple_ps(sc[2], zz));
+  sc[2] = _mm_sqrt_ps(sc[2]);
+  inv = _mm_div_ps(one, sc[2]);
+  mat4_mul3_sse2(z, inv);
+  kxz = _mm_mul_ps(kxz, inv);
+  kyz = _mm_mul_ps(kyz, inv);
+
+  if (_mm_movemask_ps(fail) != 0) {
+    return false;
+  }
+
+  flip = _mm_and_ps(
+    _mm_cmplt_ps(
+      _mm_add_ps(
+        _mm_add_ps(
+          _mm_mul_ps(x[0], _mm_sub_ps(_mm_mul_ps(y[1], z[2]), _mm_mul_ps(y[2], z[1]))),
+          _mm_mul_ps(x[1], _mm_sub_ps(_mm_mul_ps(y[2], z[0]), _mm_mul_ps(y[0], z[2])))
+        ),
+        _mm_mul_ps(x[2], _mm_sub_ps(_mm_mul_ps(y[0], z[1]), _mm_mul_ps(y[1], z[0])))
+      ),
+      zero
+    ),
+    _mm_set1_ps(-0.f)
+  );
+  for (k = 0; k < 3; ++k) {
+    sc[k] = _mm_xor_ps(sc[k], flip);
+    x[k] = _mm_xor_ps(x[k], flip);
+    y[k] = _mm_xor_ps(y[k], flip);
+    z[k] = _mm_xor_ps(z[k], flip);
+  }
+
+  // mat4_rotation_to_quat with masks, rij is row i of column j
+  dx = _mm_sub_ps(y[2], z[1]);
+  dy = _mm_sub_ps(z[0], x[2]);
+  dz = _mm_sub_ps(x[1], y[0]);
+  sxy = _mm_add_ps(y[0], x[1]);
+  sxz = _mm_add_ps(z[0], x[2]);
+  syz = _mm_add_ps(z[1], y[2]);
+  mw = _mm_cmpgt_ps(_mm_add_ps(_mm_add_ps(x[0], y[1]), z[2]), zero);
+  mx = _mm_andnot_ps(mw, _mm_and_ps(_mm_cmpgt_ps(x[0], y[1]), _mm_cmpgt_ps(x[0], z[2])));
+  my = _mm_andnot_ps(_mm_or_ps(mw, mx), _mm_cmpgt_ps(y[1], z[2]));
+  tr = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(one, z[2]), x[0]), y[1]);
+  tr = mat4_select_sse2(tr, _mm_sub_ps(_mm_add_ps(_mm_sub_ps(one, x[0]), y[1]), z[2]), my);
+  tr = mat4_select_sse2(tr, _mm_sub_ps(_mm_sub_ps(_mm_add_ps(one, x[0]), y[1]), z[2]), mx);
+  tr = mat4_select_sse2(tr, _mm_add_ps(_mm_add_ps(_mm_add_ps(one, x[0]), y[1]), z[2]), mw);
+
+  q[0] = mat4_select_sse2(mat4_select_sse2(mat4_select_sse2(sxz, sxy, my), tr, mx), dx, mw);
+  q[1] = mat4_select_sse2(mat4_select_sse2(mat4_select_sse2(syz, tr, my), sxy, mx), dy, mw);
+  q[2] = mat4_select_sse2(mat4_select_sse2(mat4_select_sse2(tr, syz, my), sxz, mx), dz, mw);
+  q[3] = mat4_select_sse2(mat4_select_sse2(mat4_select_sse2(dz, dy, my), dx, mx), tr, mw);
+  tr = _mm_div_ps(_mm_set1_ps(.5f), _mm_sqrt_ps(tr));
+  for (k = 0; k < 4; ++k) {
+    q[k] = _mm_mul_ps(q[k], tr);
+  }
+  _MM_TRANSPOSE4_PS(q[0], q[1], q[2], q[3]);
+  for (k = 0; k < 4; ++k) {
+    _mm_storeu_ps(&r[k].x, q[k]);
+  }
+
+  mat4_store_vec3x4_sse2(t, w);
+  mat4_store_vec3x4_sse2(s, sc);
+  if (shear != NULL) {
+    sh[0] = kxy;
+    sh[1] = kxz;
+    sh[2] = kyz;
+    mat4_store_vec3x4_sse2(shear, sh);
+  }
+  return true;
+}
+#endif
+
+size_t mat4_decompose_batch(
+  quat *r,
+  vec3 *t,
+  vec3 *s,
+  vec3 *shear,
+  const mat4 *m,
+  size_t count,
+  uint32_t *failed
+) {
+  size_t failures = 0;
+  size_t i, j;
+
+  for (i = 0; i < count; i += 32) {
+    size_t n = count - i < 32 ? count - i : 32;
+    uint32_t bits = 0;
+
+    for (j = 0; j < n; j += 4) {
+      size_t group = n - j < 4 ? n - j : 4;
+      size_t b = i + j, k;
+
+#if defined(MMATH_SSE2)
+      // Groups with a singular matrix are redone one at a time to find it
+      if (group == 4 && mat4_decompose4_sse2(&r[b], &t[b], &s[b], shear != NULL ? &shear[b] : NULL, &m[b])) {
+        continue;
+      }
+#endif
+      for (k = 0; k < group; ++k, ++b) {
+        bits |= (uint32_t) !mat4_decompose_kernel(&r[b], &t[b], &s[b], shear != NULL ? &shear[b] : NULL, &m[b]) << (j + k);
+      }
+    }
+    if (failed != NULL) {
+      failed[i / 32] = bits;
+    }
+    while (bits != 0) {
+      bits &= bits - 1;
+      ++failures;
+    }
+  }
+
+  return failures;
+}
+
 mat4 *mat4_from_rotation_translation_scale_origin(
   mat4 *out,
   const quat *q,
@@ -0,0 +1,107 @@
+#include <immintrin.h>
+
+#include "mat4_simd.h"
+#include "mmath_private.h"
+
+// The 128-bit kernels are rebuilt here with VEX encoding to avoid SSE/AVX transition stalls
+
+mat4 *mmath_mat4_transpose_avx2(mat4 *out, const mat4 *a) {
+  return mmath_mat4_transpose_sse(out, a);
+}
+
+mat4 *mmath_mat4_invert_avx2(mat4 *out, const mat4 *a) {
+  return mmath_mat4_invert_sse(out, a);
+}
+
+mat4 *mmath_mat4_adjoint_avx2(mat4 *out, const mat4 *a) {
+  return mmath_mat4_adjoint_sse(out, a);
+}
+
+static inline __m256 mmath_m256_dup(__m128 a) {
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(a), a, 1);
+}
+
+mat4 *mmath_mat4_multiply_avx2(mat4 *out, const mat4 *a, const mat4 *b) {
+  // Computes two columns of the result per instruction
+  __m256 a0 = mmath_m256_dup(_mm_loadu_ps(&a->data[0]));
+  __m256 a1 = mmath_m256_dup(_mm_loadu_ps(&a->data[4]));
+  __m256 a2 = mmath_m256_dup(_mm_loadu_ps(&a->data[8]));
+  __m256 a3 = mmath_m256_dup(_mm_loadu_ps(&a->data[12]));
+
+  __m256 b01 = _mm256_loadu_ps(&b->data[0]);
+  __m256 b23 = _mm256_loadu_ps(&b->data[8]);
+
+  __m256 r01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, 0x00));
+  __m256 r23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, 0x00));
+  r01 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, 0x55), r01);
+  r23 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b23, 0x55), r23);
+  r01 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, 0xaa), r01);
+  r23 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b23, 0xaa), r23);
+  r01 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, 0xff), r01);
+  r23 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b23, 0xff), r23);
+
+  _mm256_storeu_ps(&out->data[0], r01);
+  _mm256_storeu_ps(&out->data[8], r23);
+  return out;
+}
+
+static inline void mmath_mat4_load_avx2(__m256 *c, const mat4 *a) {
+  c[0] = mmath_m256_dup(_mm_loadu_ps(&a->data[0]));
+  c[1] = mmath_m256_dup(_mm_loadu_ps(&a->data[4]));
+  c[2] = mmath_m256_dup(_mm_loadu_ps(&a->data[8]));
+  c[3] = mmath_m256_dup(_mm_loadu_ps(&a->data[12]));
+}
+
+static inline __m256 mmath_mat4_columns_avx2(const __m256 *a, __m256 b) {
+  __m256 r = _mm256_mul_ps(a[0], _mm256_permute_ps(b, 0x00));
+  r = _mm256_fmadd_ps(a[1], _mm256_permute_ps(b, 0x55), r);
+  r = _mm256_fmadd_ps(a[2], _mm256_permute_ps(b, 0xaa), r);
+  return _mm256_fmadd_ps(a[3], _mm256_permute_ps(b, 0xff), r);
+}
+
+static inline void mmath_mat4_multiply_columns_avx2(mat4 *out, const __m256 *ac, const mat4 *b, int stream) {
+  __m256 r01 = mmath_mat4_columns_avx2(ac, _mm256_loadu_ps(&b->data[0]));
+  __m256 r23 = mmath_mat4_columns_avx2(ac, _mm256_loadu_ps(&b->data[8]));
+
+  if (stream) {
+    _mm256_stream_ps(&out->data[0], r01);
+    _mm256_stream_ps(&out->data[8], r23);
+  } else {
+    _mm256_storeu_ps(&out->data[0], r01);
+    _mm256_storeu_ps(&out->data[8], r23);
+  }
+}
+
+void mmath_mat4_multiply_batch_avx2(
+  mat4 *out,
+  const mat4 *a,
+  size_t a_step,
+  const uint32_t *indices,
+  const mat4 *b,
+  size_t count
+) {
+  int stream = mmath_mat4_should_stream(out, count, 32);
+  __m256 ac[4];
+  size_t i;
+
+  if (indices != NULL) {
+    for (i = 0; i < count; ++i) {
+      mmath_mat4_load_avx2(ac, &a[indices[i]]);
+      mmath_mat4_multiply_columns_avx2(&out[i], ac, &b[i], stream);
+    }
+  } else if (a_step != 0) {
+    for (i = 0; i < count; ++i) {
+      mmath_mat4_load_avx2(ac, &a[i]);
+      mmath_mat4_multiply_columns_avx2(&out[i], ac, &b[i], stream);
+    }
+  } else {
+    mmath_mat4_load_avx2(ac, a);
+    for (i = 0; i < count; ++i) {
+      mmath_mat4_multiply_columns_avx2(&out[i], ac, &b[i], stream);
+    }
+  }
+
+  if (stream) {
+    _mm_sfence();
+  }
+}
@@ -0,0 +1,222 @@
+#ifndef MMATH_MAT4_SIMD_H
+#define MMATH_MAT4_SIMD_H
+
+// SSE4.1 mat4 kernels shared by the SSE4.1 and AVX2 translation units.
+// Matrices are packed, so every access goes through unaligned loads and stores.
+
+#include <smmintrin.h>
+
+#include "mmath/mat4.h"
+
+#define MMATH_SHUFFLE(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+#define MMATH_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps((v), (v), MMATH_SHUFFLE(x, y, z, w))
+
+static inline void mmath_mat4_load_sse(__m128 *c, const mat4 *a) {
+  c[0] = _mm_loadu_ps(&a->data[0]);
+  c[1] = _mm_loadu_ps(&a->data[4]);
+  c[2] = _mm_loadu_ps(&a->data[8]);
+  c[3] = _mm_loadu_ps(&a->data[12]);
+}
+
+static inline void mmath_mat4_store_sse(mat4 *out, const __m128 *c) {
+  _mm_storeu_ps(&out->data[0], c[0]);
+  _mm_storeu_ps(&out->data[4], c[1]);
+  _mm_storeu_ps(&out->data[8], c[2]);
+  _mm_storeu_ps(&out->data[12], c[3]);
+}
+
+static inline __m128 mmath_mat4_column_sse(const __m128 *a, __m128 b) {
+  __m128 r = _mm_mul_ps(a[0], MMATH_SWIZZLE(b, 0, 0, 0, 0));
+  r = _mm_add_ps(r, _mm_mul_ps(a[1], MMATH_SWIZZLE(b, 1, 1, 1, 1)));
+  r = _mm_add_ps(r, _mm_mul_ps(a[2], MMATH_SWIZZLE(b, 2, 2, 2, 2)));
+  r = _mm_add_ps(r, _mm_mul_ps(a[3], MMATH_SWIZZLE(b, 3, 3, 3, 3)));
+  return r;
+}
+
+static inline mat4 *mmath_mat4_multiply_sse(mat4 *out, const mat4 *a, const mat4 *b) {
+  __m128 ac[4], r[4];
+  mmath_mat4_load_sse(ac, a);
+
+  r[0] = mmath_mat4_column_sse(ac, _mm_loadu_ps(&b->data[0]));
+  r[1] = mmath_mat4_column_sse(ac, _mm_loadu_ps(&b->data[4]));
+  r[2] = mmath_mat4_column_sse(ac, _mm_loadu_ps(&b->data[8]));
+  r[3] = mmath_mat4_column_sse(ac, _mm_loadu_ps(&b->data[12]));
+
+  mmath_mat4_store_sse(out, r);
+  return out;
+}
+
+// Batches whose result is at least this many matrices (512 KiB) are written with streaming
+// stores, the output no longer fits in L2 and would only evict the inputs on the way out
+#define MMATH_MAT4_STREAM_COUNT 8192
+
+static inline int mmath_mat4_should_stream(const mat4 *out, size_t count, size_t alignment) {
+  return count >= MMATH_MAT4_STREAM_COUNT && ((uintptr_t) out & (alignment - 1)) == 0;
+}
+
+static inline void mmath_mat4_stream_sse(mat4 *out, const __m128 *c) {
+  _mm_stream_ps(&out->data[0], c[0]);
+  _mm_stream_ps(&out->data[4], c[1]);
+  _mm_stream_ps(&out->data[8], c[2]);
+  _mm_stream_ps(&out->data[12], c[3]);
+}
+
+static inline void mmath_mat4_multiply_columns_sse(mat4 *out, const __m128 *ac, const mat4 *b, int stream) {
+  __m128 r[4];
+
+  r[0] = mmath_mat4_column_sse(ac, _mm_loadu_ps(&b->data[0]));
+  r[1] = mmath_mat4_column_sse(ac, _mm_loadu_ps(&b->data[4]));
+  r[2] = mmath_mat4_column_sse(ac, _mm_loadu_ps(&b->data[8]));
+  r[3] = mmath_mat4_column_sse(ac, _mm_loadu_ps(&b->data[12]));
+
+  if (stream) {
+    mmath_mat4_stream_sse(out, r);
+  } else {
+    mmath_mat4_store_sse(out, r);
+  }
+}
+
+// out[i] = a[indices[i]] * b[i] with indices, a[i * a_step] * b[i] without, a_step being 0 or 1.
+// A shared left operand is loaded once and stays in registers.
+static inline void mmath_mat4_multiply_batch_sse(
+  mat4 *out,
+  const mat4 *a,
+  size_t a_step,
+  const uint32_t *indices,
+  const mat4 *b,
+  size_t count
+) {
+  int stream = mmath_mat4_should_stream(out, count, 16);
+  __m128 ac[4];
+  size_t i;
+
+  if (indices != NULL) {
+    for (i = 0; i < count; ++i) {
+      mmath_mat4_load_sse(ac, &a[indices[i]]);
+      mmath_mat4_multiply_columns_sse(&out[i], ac, &b[i], stream);
+    }
+  } else if (a_step != 0) {
+    for (i = 0; i < count; ++i) {
+      mmath_mat4_load_sse(ac, &a[i]);
+      mmath_mat4_multiply_columns_sse(&out[i], ac, &b[i], stream);
+    }
+  } else {
+    mmath_mat4_load_sse(ac, a);
+    for (i = 0; i < count; ++i) {
+      mmath_mat4_multiply_columns_sse(&out[i], ac, &b[i], stream);
+    }
+  }
+
+  if (stream) {
+    _mm_sfence();
+  }
+}
+
+static inline mat4 *mmath_mat4_transpose_sse(mat4 *out, const mat4 *a) {
+  __m128 c[4];
+  mmath_mat4_load_sse(c, a);
+  _MM_TRANSPOSE4_PS(c[0], c[1], c[2], c[3]);
+  mmath_mat4_store_sse(out, c);
+  return out;
+}
+
+// 2x2 helpers for the block-wise inverse, each 2x2 matrix is stored as (x00, x01, x10, x11)
+
+// a * b
+static inline __m128 mmath_mat2_mul_sse(__m128 a, __m128 b) {
+  return _mm_add_ps(
+    _mm_mul_ps(a, MMATH_SWIZZLE(b, 0, 3, 0, 3)),
+    _mm_mul_ps(MMATH_SWIZZLE(a, 1, 0, 3, 2), MMATH_SWIZZLE(b, 2, 1, 2, 1))
+  );
+}
+
+// adj(a) * b
+static inline __m128 mmath_mat2_adj_mul_sse(__m128 a, __m128 b) {
+  return _mm_sub_ps(
+    _mm_mul_ps(MMATH_SWIZZLE(a, 3, 3, 0, 0), b),
+    _mm_mul_ps(MMATH_SWIZZLE(a, 1, 1, 2, 2), MMATH_SWIZZLE(b, 2, 3, 0, 1))
+  );
+}
+
+// a * adj(b)
+static inline __m128 mmath_mat2_mul_adj_sse(__m128 a, __m128 b) {
+  return _mm_sub_ps(
+    _mm_mul_ps(a, MMATH_SWIZZLE(b, 3, 0, 3, 0)),
+    _mm_mul_ps(MMATH_SWIZZLE(a, 1, 0, 3, 2), MMATH_SWIZZLE(b, 2, 1, 2, 1))
+  );
+}
+
+// Computes the blocks of the adjugate and the determinant using the 2x2 block
+// decomposition M = | A B |, with the adjugate blocks still carrying their signs.
+//                   | C D |
+static inline __m128 mmath_mat4_adjugate_blocks_sse(__m128 *blocks, const mat4 *a) {
+  __m128 c[4];
+  mmath_mat4_load_sse(c, a);
+
+  __m128 A = _mm_movelh_ps(c[0], c[1]);
+  __m128 B = _mm_movehl_ps(c[1], c[0]);
+  __m128 C = _mm_movelh_ps(c[2], c[3]);
+  __m128 D = _mm_movehl_ps(c[3], c[2]);
+
+  // (|A|, |B|, |C|, |D|)
+  __m128 det_sub = _mm_sub_ps(
+    _mm_mul_ps(
+      _mm_shuffle_ps(c[0], c[2], MMATH_SHUFFLE(0, 2, 0, 2)),
+      _mm_shuffle_ps(c[1], c[3], MMATH_SHUFFLE(1, 3, 1, 3))
+    ),
+    _mm_mul_ps(
+      _mm_shuffle_ps(c[0], c[2], MMATH_SHUFFLE(1, 3, 1, 3)),
+      _mm_shuffle_ps(c[1], c[3], MMATH_SHUFFLE(0, 2, 0, 2))
+    )
+  );
+  __m128 det_a = MMATH_SWIZZLE(det_sub, 0, 0, 0, 0);
+  __m128 det_b = MMATH_SWIZZLE(det_sub, 1, 1, 1, 1);
+  __m128 det_c = MMATH_SWIZZLE(det_sub, 2, 2, 2, 2);
+  __m128 det_d = MMATH_SWIZZLE(det_sub, 3, 3, 3, 3);
+
+  __m128 d_c = mmath_mat2_adj_mul_sse(D, C);
+  __m128 a_b = mmath_mat2_adj_mul_sse(A, B);
+
+  blocks[0] = _mm_sub_ps(_mm_mul_ps(det_d, A), mmath_mat2_mul_sse(B, d_c));
+  blocks[1] = _mm_sub_ps(_mm_mul_ps(det_b, C), mmath_mat2_mul_adj_sse(D, a_b));
+  blocks[2] = _mm_sub_ps(_mm_mul_ps(det_c, B), mmath_mat2_mul_adj_sse(A, d_c));
+  blocks[3] = _mm_sub_ps(_mm_mul_ps(det_a, D), mmath_mat2_mul_sse(C, a_b));
+
+  // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+  __m128 det = _mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c));
+  __m128 tr = _mm_dp_ps(a_b, MMATH_SWIZZLE(d_c, 0, 2, 1, 3), 0xff);
+  return _mm_sub_ps(det, tr);
+}
+
+static inline void mmath_mat4_store_adjugate_sse(mat4 *out, const __m128 *blocks, __m128 scale) {
+  __m128 x = _mm_mul_ps(blocks[0], scale);
+  __m128 y = _mm_mul_ps(blocks[1], scale);
+  __m128 z = _mm_mul_ps(blocks[2], scale);
+  __m128 w = _mm_mul_ps(blocks[3], scale);
+
+  _mm_storeu_ps(&out->data[0], _mm_shuffle_ps(x, y, MMATH_SHUFFLE(3, 1, 3, 1)));
+  _mm_storeu_ps(&out->data[4], _mm_shuffle_ps(x, y, MMATH_SHUFFLE(2, 0, 2, 0)));
+  _mm_storeu_ps(&out->data[8], _mm_shuffle_ps(z, w, MMATH_SHUFFLE(3, 1, 3, 1)));
+  _mm_storeu_ps(&out->data[12], _mm_shuffle_ps(z, w, MMATH_SHUFFLE(2, 0, 2, 0)));
+}
+
+static inline mat4 *mmath_mat4_invert_sse(mat4 *out, const mat4 *a) {
+  __m128 blocks[4];
+  __m128 det = mmath_mat4_adjugate_blocks_sse(blocks, a);
+
+  if (_mm_cvtss_f32(det) == 0.f) {
+    return NULL;
+  }
+
+  mmath_mat4_store_adjugate_sse(out, blocks, _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det));
+  return out;
+}
+
+static inline mat4 *mmath_mat4_adjoint_sse(mat4 *out, const mat4 *a) {
+  __m128 blocks[4];
+  mmath_mat4_adjugate_blocks_sse(blocks, a);
+  mmath_mat4_store_adjugate_sse(out, blocks, _mm_setr_ps(1.f, -1.f, -1.f, 1.f));
+  return out;
+}
+
+#endif // MMATH_MAT4_SIMD_H
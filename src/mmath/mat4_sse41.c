@@ -0,0 +1,29 @@
+#include "mat4_simd.h"
+#include "mmath_private.h"
+
+mat4 *mmath_mat4_transpose_sse41(mat4 *out, const mat4 *a) {
+  return mmath_mat4_transpose_sse(out, a);
+}
+
+mat4 *mmath_mat4_invert_sse41(mat4 *out, const mat4 *a) {
+  return mmath_mat4_invert_sse(out, a);
+}
+
+mat4 *mmath_mat4_adjoint_sse41(mat4 *out, const mat4 *a) {
+  return mmath_mat4_adjoint_sse(out, a);
+}
+
+mat4 *mmath_mat4_multiply_sse41(mat4 *out, const mat4 *a, const mat4 *b) {
+  return mmath_mat4_multiply_sse(out, a, b);
+}
+
+void mmath_mat4_multiply_batch_sse41(
+  mat4 *out,
+  const mat4 *a,
+  size_t a_step,
+  const uint32_t *indices,
+  const mat4 *b,
+  size_t count
+) {
+  mmath_mat4_multiply_batch_sse(out, a, a_step, indices, b, count);
+}
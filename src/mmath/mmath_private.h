@@ -12,4 +12,117 @@
 
 #include "mmath.h"
 
+#if defined(_MSC_VER)
+#define MMATH_THREAD_LOCAL __declspec(thread)
+#else
+#define MMATH_THREAD_LOCAL _Thread_local
+#endif
+
+// Every object allocation goes through these, honoring mmath_set_allocator and the active arena.
+// The size and alignment passed to mmath_free must match the ones given to mmath_alloc.
+void *mmath_alloc(size_t size, size_t alignment);
+void mmath_free(void *ptr, size_t size, size_t alignment);
+
+// Skip the arena, for containers whose storage outlives it or grows after it ends: hierarchy,
+// bvh, soa streams and pools
+void *mmath_alloc_global(size_t size, size_t alignment);
+void mmath_free_global(void *ptr, size_t size, size_t alignment);
+
+// SSE2 is part of the x86-64 baseline, so kernels using it need no runtime dispatch
+#if !defined(MMATH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MMATH_SSE2
+#include <emmintrin.h>
+#endif
+
+// sin/cos on one range reduction: x = j * pi/2 + r with |r| <= pi/4, pi/2 split in four parts
+// short enough that j * part is exact, then minimax polynomials on r. An exhaustive check over
+// |x| <= MMATH_SINCOS_MAX gives at most 1.53 ulp; past that the float reduction loses accuracy
+// near the zeros, so larger inputs and NaN go through sinf/cosf.
+#define MMATH_SINCOS_MAX 128.f
+#define MMATH_SINCOS_2_PI 0.636619772367581343f
+#define MMATH_SINCOS_PI_2_A 1.5703125f
+#define MMATH_SINCOS_PI_2_B 4.837512969970703125e-4f
+#define MMATH_SINCOS_PI_2_C 7.549533620476723e-8f
+#define MMATH_SINCOS_PI_2_D 2.5632829192545614e-12f
+
+static inline void mmath_sincosf(float x, float *s, float *c) {
+  if (!(fabsf(x) <= MMATH_SINCOS_MAX)) {
+    *s = sinf(x);
+    *c = cosf(x);
+    return;
+  }
+
+  float t = x * MMATH_SINCOS_2_PI;
+  int q = (int) (t + (t >= 0.f ? .5f : -.5f));
+  float j = (float) q;
+  float r = (((x - j * MMATH_SINCOS_PI_2_A) - j * MMATH_SINCOS_PI_2_B) - j * MMATH_SINCOS_PI_2_C) - j * MMATH_SINCOS_PI_2_D;
+  float z = r * r;
+
+  float sr = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+  float cr = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - .5f * z + 1.f;
+
+  // Quadrant q maps (sin, cos) to (sr, cr), (cr, -sr), (-sr, -cr), (-cr, sr)
+  float so = (q & 1) ? cr : sr;
+  float co = (q & 1) ? sr : cr;
+  *s = (q & 2) ? -so : so;
+  *c = ((q + 1) & 2) ? -co : co;
+}
+
+// Angles per mmath_sincosf_batch call in the batch rotation builders
+#define MMATH_ROTATION_BATCH 64
+
+#if defined(MMATH_HAVE_X86_SIMD)
+// SIMD kernels, each built in its own translation unit with the matching -m flags.
+// Only call them after mmath_get_backend() reported support.
+mat4 *mmath_mat4_transpose_sse41(mat4 *out, const mat4 *a);
+mat4 *mmath_mat4_invert_sse41(mat4 *out, const mat4 *a);
+mat4 *mmath_mat4_adjoint_sse41(mat4 *out, const mat4 *a);
+mat4 *mmath_mat4_multiply_sse41(mat4 *out, const mat4 *a, const mat4 *b);
+void mmath_mat4_multiply_batch_sse41(
+  mat4 *out,
+  const mat4 *a,
+  size_t a_step,
+  const uint32_t *indices,
+  const mat4 *b,
+  size_t count
+);
+
+mat4 *mmath_mat4_transpose_avx2(mat4 *out, const mat4 *a);
+mat4 *mmath_mat4_invert_avx2(mat4 *out, const mat4 *a);
+mat4 *mmath_mat4_adjoint_avx2(mat4 *out, const mat4 *a);
+mat4 *mmath_mat4_multiply_avx2(mat4 *out, const mat4 *a, const mat4 *b);
+void mmath_mat4_multiply_batch_avx2(
+  mat4 *out,
+  const mat4 *a,
+  size_t a_step,
+  const uint32_t *indices,
+  const mat4 *b,
+  size_t count
+);
+
+// Batch kernels below take a count that is a multiple of 8
+void mmath_quat_slerp_fast_soa_avx2(float *const out[4], const float *const a[4], const float *const b[4], const float *t, size_t count);
+
+size_t mmath_frustum_cull_spheres_avx2(
+  uint32_t *out,
+  const frustum *f,
+  const float *x,
+  const float *y,
+  const float *z,
+  const float *radius,
+  size_t count
+);
+size_t mmath_frustum_cull_aabbs_avx2(
+  uint32_t *out,
+  const frustum *f,
+  const float *min_x,
+  const float *min_y,
+  const float *min_z,
+  const float *max_x,
+  const float *max_y,
+  const float *max_z,
+  size_t count
+);
+#endif
+
 #endif
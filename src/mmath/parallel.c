@@ -0,0 +1,772 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "mmath/parallel.h"
+#include "mmath_private.h"
+
+#if defined(MMATH_HAVE_THREADS)
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#endif
+
+// Input + output bytes per chunk of the batch wrappers, small enough to stay in L1/L2
+#define MMATH_PARALLEL_CHUNK_BYTES (32 * 1024)
+#define MMATH_PARALLEL_CHUNKS_PER_THREAD 8
+// Wrappers that compact their output keep a count per chunk on the stack
+#define MMATH_PARALLEL_MAX_COMPACT_CHUNKS 1024
+
+#if defined(MMATH_HAVE_THREADS)
+// Chunks not taken yet, [begin, end) packed as begin | end << 32. The owner pops from the
+// front and thieves take the back half, both with a compare-exchange on the whole range.
+typedef struct mmath_pool_slot {
+  _Alignas(64) _Atomic uint64_t range;
+} mmath_pool_slot;
+
+typedef struct mmath_pool_worker {
+  mmath_pool *pool;
+  size_t index;
+  pthread_t thread;
+} mmath_pool_worker;
+#endif
+
+struct mmath_pool {
+  size_t threads;
+  size_t grain;
+
+#if defined(MMATH_HAVE_THREADS)
+  // threads may end up lower than the number of slots and workers allocated
+  size_t capacity;
+  mmath_pool_worker *workers;
+  mmath_pool_slot *slots;
+
+  // Serializes parallel_for calls from different threads
+  pthread_mutex_t submit;
+
+  // Guards everything below
+  pthread_mutex_t mutex;
+  pthread_cond_t wake;
+  pthread_cond_t done;
+  uint64_t generation;
+  bool open;
+  bool stop;
+  size_t active;
+
+  // The running job, fixed while it is open
+  mmath_parallel_fn fn;
+  void *user;
+  size_t count;
+  size_t job_grain;
+#endif
+};
+
+#if defined(MMATH_HAVE_THREADS)
+// Set while a thread runs chunks, so nested calls on the same pool run inline instead of deadlocking
+static MMATH_THREAD_LOCAL mmath_pool *mmath_pool_current;
+#endif
+
+static size_t mmath_parallel_chunks(size_t count, size_t grain) {
+  return count / grain + (count % grain != 0);
+}
+
+static size_t mmath_parallel_resolve_grain(const mmath_pool *pool, size_t count, size_t grain) {
+  size_t threads = pool != NULL ? pool->threads : 1;
+
+  if (grain == 0 && pool != NULL) {
+    grain = pool->grain;
+  }
+  if (grain == 0) {
+    grain = mmath_parallel_chunks(count, threads * MMATH_PARALLEL_CHUNKS_PER_THREAD);
+  }
+  if (grain == 0) {
+    grain = 1;
+  }
+  // Chunk indices are packed into 32 bits
+  if (mmath_parallel_chunks(count, grain) > UINT32_MAX) {
+    grain = mmath_parallel_chunks(count, UINT32_MAX);
+  }
+  return grain;
+}
+
+static void mmath_parallel_serial(size_t count, size_t grain, mmath_parallel_fn fn, void *user) {
+  size_t begin;
+
+  for (begin = 0; begin < count; begin += grain) {
+    fn(begin, count - begin < grain ? count : begin + grain, user);
+  }
+}
+
+#if defined(MMATH_HAVE_THREADS)
+static inline uint64_t mmath_pool_range(uint64_t begin, uint64_t end) {
+  return begin | end << 32;
+}
+
+static bool mmath_pool_next(mmath_pool *pool, size_t self, size_t *chunk) {
+  mmath_pool_slot *own = &pool->slots[self];
+  uint64_t range = atomic_load_explicit(&own->range, memory_order_acquire);
+  size_t k;
+
+  for (;;) {
+    uint64_t begin = range & UINT32_MAX, end = range >> 32;
+    if (begin >= end) {
+      break;
+    }
+    if (atomic_compare_exchange_weak_explicit(
+      &own->range, &range, mmath_pool_range(begin + 1, end), memory_order_acq_rel, memory_order_acquire
+    )) {
+      *chunk = (size_t) begin;
+      return true;
+    }
+  }
+
+  for (k = 1; k < pool->threads; ++k) {
+    mmath_pool_slot *victim = &pool->slots[(self + k) % pool->threads];
+    range = atomic_load_explicit(&victim->range, memory_order_acquire);
+
+    for (;;) {
+      uint64_t begin = range & UINT32_MAX, end = range >> 32, mid;
+      if (begin >= end) {
+        break;
+      }
+      mid = begin + (end - begin) / 2;
+      if (atomic_compare_exchange_weak_explicit(
+        &victim->range, &range, mmath_pool_range(begin, mid), memory_order_acq_rel, memory_order_acquire
+      )) {
+        // Own slot is empty, so no thief writes it until this store
+        atomic_store_explicit(&own->range, mmath_pool_range(mid + 1, end), memory_order_release);
+        *chunk = (size_t) mid;
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+static void mmath_pool_run(mmath_pool *pool, size_t self) {
+  mmath_pool *previous = mmath_pool_current;
+  size_t grain = pool->job_grain, count = pool->count;
+  size_t chunk;
+
+  mmath_pool_current = pool;
+  while (mmath_pool_next(pool, self, &chunk)) {
+    size_t begin = chunk * grain;
+    pool->fn(begin, count - begin < grain ? count : begin + grain, pool->user);
+  }
+  mmath_pool_current = previous;
+}
+
+static void *mmath_pool_main(void *arg) {
+  mmath_pool_worker *worker = (mmath_pool_worker *) arg;
+  mmath_pool *pool = worker->pool;
+  uint64_t seen = 0;
+
+  pthread_mutex_lock(&pool->mutex);
+  for (;;) {
+    while (!pool->stop && pool->generation == seen) {
+      pthread_cond_wait(&pool->wake, &pool->mutex);
+    }
+    if (pool->stop) {
+      break;
+    }
+    seen = pool->generation;
+    // Woke up after the job was already finished by the others
+    if (!pool->open) {
+      continue;
+    }
+
+    ++pool->active;
+    pthread_mutex_unlock(&pool->mutex);
+    mmath_pool_run(pool, worker->index);
+    pthread_mutex_lock(&pool->mutex);
+    if (--pool->active == 0) {
+      pthread_cond_signal(&pool->done);
+    }
+  }
+  pthread_mutex_unlock(&pool->mutex);
+
+  return NULL;
+}
+
+static size_t mmath_pool_online_cpus() {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (size_t) n : 1;
+}
+#endif
+
+mmath_pool *mmath_pool_create(size_t threads) {
+  mmath_pool *pool = (mmath_pool *) mmath_alloc_global(sizeof(mmath_pool), _Alignof(mmath_pool));
+  if (pool == NULL) {
+    return NULL;
+  }
+
+  memset(pool, 0, sizeof(mmath_pool));
+  pool->threads = 1;
+
+#if defined(MMATH_HAVE_THREADS)
+  {
+    size_t i;
+
+    if (threads == 0) {
+      threads = mmath_pool_online_cpus();
+    }
+    if (threads <= 1) {
+      return pool;
+    }
+
+    pool->slots = (mmath_pool_slot *) mmath_alloc_global(threads * sizeof(mmath_pool_slot), _Alignof(mmath_pool_slot));
+    pool->workers = (mmath_pool_worker *) mmath_alloc_global(
+      threads * sizeof(mmath_pool_worker),
+      _Alignof(mmath_pool_worker)
+    );
+    if (pool->slots == NULL || pool->workers == NULL) {
+      mmath_free_global(pool->slots, threads * sizeof(mmath_pool_slot), _Alignof(mmath_pool_slot));
+      mmath_free_global(pool->workers, threads * sizeof(mmath_pool_worker), _Alignof(mmath_pool_worker));
+      mmath_free_global(pool, sizeof(mmath_pool), _Alignof(mmath_pool));
+      return NULL;
+    }
+    for (i = 0; i < threads; ++i) {
+      atomic_init(&pool->slots[i].range, 0);
+    }
+
+    pthread_mutex_init(&pool->submit, NULL);
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    // Slot 0 belongs to the calling thread. If a worker fails to start, the pool keeps the ones that did.
+    pool->capacity = threads;
+    pool->threads = threads;
+    for (i = 1; i < threads; ++i) {
+      pool->workers[i].pool = pool;
+      pool->workers[i].index = i;
+      if (pthread_create(&pool->workers[i].thread, NULL, mmath_pool_main, &pool->workers[i]) != 0) {
+        pool->threads = i;
+        break;
+      }
+    }
+  }
+#else
+  (void) threads;
+#endif
+
+  return pool;
+}
+
+void mmath_pool_destroy(mmath_pool *pool) {
+  if (pool == NULL) {
+    return;
+  }
+
+#if defined(MMATH_HAVE_THREADS)
+  if (pool->slots != NULL) {
+    size_t allocated = pool->capacity;
+    size_t i;
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->mutex);
+    for (i = 1; i < pool->threads; ++i) {
+      pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_mutex_destroy(&pool->submit);
+    mmath_free_global(pool->workers, allocated * sizeof(mmath_pool_worker), _Alignof(mmath_pool_worker));
+    mmath_free_global(pool->slots, allocated * sizeof(mmath_pool_slot), _Alignof(mmath_pool_slot));
+  }
+#endif
+
+  mmath_free_global(pool, sizeof(mmath_pool), _Alignof(mmath_pool));
+}
+
+size_t mmath_pool_threads(const mmath_pool *pool) {
+  return pool->threads;
+}
+
+void mmath_pool_set_grain(mmath_pool *pool, size_t grain) {
+  pool->grain = grain;
+}
+
+size_t mmath_pool_grain(const mmath_pool *pool) {
+  return pool->grain;
+}
+
+void mmath_parallel_for(mmath_pool *pool, size_t count, size_t grain, mmath_parallel_fn fn, void *user) {
+  if (count == 0) {
+    return;
+  }
+  grain = mmath_parallel_resolve_grain(pool, count, grain);
+
+#if defined(MMATH_HAVE_THREADS)
+  if (pool != NULL && pool->threads > 1 && count > grain && mmath_pool_current != pool) {
+    size_t chunks = mmath_parallel_chunks(count, grain);
+    size_t i;
+
+    pthread_mutex_lock(&pool->submit);
+    pthread_mutex_lock(&pool->mutex);
+
+    pool->fn = fn;
+    pool->user = user;
+    pool->count = count;
+    pool->job_grain = grain;
+    for (i = 0; i < pool->threads; ++i) {
+      atomic_store_explicit(
+        &pool->slots[i].range,
+        mmath_pool_range(chunks * i / pool->threads, chunks * (i + 1) / pool->threads),
+        memory_order_relaxed
+      );
+    }
+    pool->open = true;
+    ++pool->generation;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->mutex);
+
+    mmath_pool_run(pool, 0);
+
+    // Every chunk has been taken, wait for the workers still running theirs
+    pthread_mutex_lock(&pool->mutex);
+    pool->open = false;
+    while (pool->active != 0) {
+      pthread_cond_wait(&pool->done, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    pthread_mutex_unlock(&pool->submit);
+    return;
+  }
+#endif
+
+  mmath_parallel_serial(count, grain, fn, user);
+}
+
+// Batch wrappers
+
+// A multiple of 8 keeps the SIMD groups of the kernels where they are in a single call, so the
+// results match the serial kernels bit for bit
+static size_t mmath_parallel_batch_grain(const mmath_pool *pool, size_t bytes_per_element) {
+  size_t grain;
+
+  if (pool != NULL && pool->grain != 0) {
+    return pool->grain;
+  }
+  grain = MMATH_PARALLEL_CHUNK_BYTES / bytes_per_element & ~(size_t) 7;
+  return grain != 0 ? grain : 8;
+}
+
+typedef struct mmath_parallel_transform_args {
+  vec3 *out;
+  size_t out_stride;
+  const vec3 *a;
+  size_t a_stride;
+  const mat4 *m;
+} mmath_parallel_transform_args;
+
+static void mmath_parallel_transform_chunk(size_t begin, size_t end, void *user) {
+  const mmath_parallel_transform_args *args = (const mmath_parallel_transform_args *) user;
+  vec3_transform_mat4_batch(
+    (vec3 *) ((unsigned char *) args->out + begin * args->out_stride),
+    args->out_stride,
+    (const vec3 *) ((const unsigned char *) args->a + begin * args->a_stride),
+    args->a_stride,
+    end - begin,
+    args->m
+  );
+}
+
+vec3 *mmath_parallel_vec3_transform_mat4_batch(
+  mmath_pool *pool,
+  vec3 *out,
+  size_t out_stride,
+  const vec3 *a,
+  size_t a_stride,
+  size_t count,
+  const mat4 *m
+) {
+  mmath_parallel_transform_args args = { out, out_stride, a, a_stride, m };
+  size_t grain = mmath_parallel_batch_grain(pool, out_stride + a_stride);
+
+  mmath_parallel_for(pool, count, grain, mmath_parallel_transform_chunk, &args);
+  return out;
+}
+
+typedef struct mmath_parallel_multiply_args {
+  mat4 *out;
+  const mat4 *a;
+  const mat4 *b;
+} mmath_parallel_multiply_args;
+
+static void mmath_parallel_multiply_chunk(size_t begin, size_t end, void *user) {
+  const mmath_parallel_multiply_args *args = (const mmath_parallel_multiply_args *) user;
+  mat4_multiply_batch(&args->out[begin], args->a, &args->b[begin], end - begin);
+}
+
+mat4 *mmath_parallel_mat4_multiply_batch(
+  mmath_pool *pool,
+  mat4 *out,
+  const mat4 *a,
+  const mat4 *b,
+  size_t count
+) {
+  mmath_parallel_multiply_args args = { out, a, b };
+  size_t grain = mmath_parallel_batch_grain(pool, 2 * sizeof(mat4));
+
+  mmath_parallel_for(pool, count, grain, mmath_parallel_multiply_chunk, &args);
+  return out;
+}
+
+typedef struct mmath_parallel_trs_args {
+  mat4 *out;
+  const quat *q;
+  const vec3 *v;
+  const vec3 *s;
+  const mat4 *parent;
+} mmath_parallel_trs_args;
+
+static void mmath_parallel_trs_chunk(size_t begin, size_t end, void *user) {
+  const mmath_parallel_trs_args *args = (const mmath_parallel_trs_args *) user;
+  mat4_from_rotation_translation_scale_batch(
+    &args->out[begin], &args->q[begin], &args->v[begin], &args->s[begin], args->parent, end - begin
+  );
+}
+
+mat4 *mmath_parallel_mat4_from_rotation_translation_scale_batch(
+  mmath_pool *pool,
+  mat4 *out,
+  const quat *q,
+  const vec3 *v,
+  const vec3 *s,
+  const mat4 *parent,
+  size_t count
+) {
+  mmath_parallel_trs_args args = { out, q, v, s, NULL };
+  size_t grain = mmath_parallel_batch_grain(pool, sizeof(mat4) + sizeof(quat) + 2 * sizeof(vec3));
+  mat4 p;
+
+  // Chunks may run after other chunks overwrote a parent that lives in out
+  if (parent != NULL) {
+    args.parent = mat4_copy(&p, parent);
+  }
+  mmath_parallel_for(pool, count, grain, mmath_parallel_trs_chunk, &args);
+  return out;
+}
+
+typedef struct mmath_parallel_skin_args {
+  const mmath_skin_desc *desc;
+  const mat4 *palette;
+  const quat2 *bones;
+} mmath_parallel_skin_args;
+
+static void *mmath_parallel_offset(const void *ptr, size_t index, size_t stride) {
+  return ptr != NULL ? (unsigned char *) ptr + index * stride : NULL;
+}
+
+static void mmath_parallel_skin_chunk(size_t begin, size_t end, void *user) {
+  const mmath_parallel_skin_args *args = (const mmath_parallel_skin_args *) user;
+  const mmath_skin_desc *desc = args->desc;
+  mmath_skin_desc chunk = *desc;
+
+  chunk.count = end - begin;
+  chunk.joints = &desc->joints[begin * desc->influences];
+  chunk.weights = &desc->weights[begin * desc->influences];
+  chunk.positions = (const vec3 *) mmath_parallel_offset(desc->positions, begin, desc->position_stride);
+  chunk.out_positions = (vec3 *) mmath_parallel_offset(desc->out_positions, begin, desc->out_position_stride);
+  chunk.normals = (const vec3 *) mmath_parallel_offset(desc->normals, begin, desc->normal_stride);
+  chunk.out_normals = (vec3 *) mmath_parallel_offset(desc->out_normals, begin, desc->out_normal_stride);
+  chunk.tangents = (const vec4 *) mmath_parallel_offset(desc->tangents, begin, desc->tangent_stride);
+  chunk.out_tangents = (vec4 *) mmath_parallel_offset(desc->out_tangents, begin, desc->out_tangent_stride);
+
+  if (args->palette != NULL) {
+    mmath_skin_lbs(&chunk, args->palette);
+  } else {
+    mmath_skin_dqs(&chunk, args->bones);
+  }
+}
+
+static size_t mmath_parallel_skin_bytes(const mmath_skin_desc *desc) {
+  size_t bytes = desc->influences * (sizeof(uint16_t) + sizeof(float)) + desc->position_stride + desc->out_position_stride;
+
+  if (desc->normals != NULL) {
+    bytes += desc->normal_stride + desc->out_normal_stride;
+  }
+  if (desc->tangents != NULL) {
+    bytes += desc->tangent_stride + desc->out_tangent_stride;
+  }
+  return bytes;
+}
+
+void mmath_parallel_skin_lbs(mmath_pool *pool, const mmath_skin_desc *desc, const mat4 *palette) {
+  mmath_parallel_skin_args args = { desc, palette, NULL };
+  size_t grain = mmath_parallel_batch_grain(pool, mmath_parallel_skin_bytes(desc));
+
+  mmath_parallel_for(pool, desc->count, grain, mmath_parallel_skin_chunk, &args);
+}
+
+void mmath_parallel_skin_dqs(mmath_pool *pool, const mmath_skin_desc *desc, const quat2 *bones) {
+  mmath_parallel_skin_args args = { desc, NULL, bones };
+  size_t grain = mmath_parallel_batch_grain(pool, mmath_parallel_skin_bytes(desc));
+
+  mmath_parallel_for(pool, desc->count, grain, mmath_parallel_skin_chunk, &args);
+}
+
+// Each chunk writes its indices to out[begin], these are then moved down in chunk order
+static size_t mmath_parallel_compact_grain(const mmath_pool *pool, size_t bytes_per_element, size_t count) {
+  size_t grain = mmath_parallel_batch_grain(pool, bytes_per_element);
+
+  if (mmath_parallel_chunks(count, grain) > MMATH_PARALLEL_MAX_COMPACT_CHUNKS) {
+    grain = mmath_parallel_chunks(count, MMATH_PARALLEL_MAX_COMPACT_CHUNKS);
+  }
+  return grain;
+}
+
+static size_t mmath_parallel_compact(uint32_t *out, const uint32_t *counts, size_t chunks, size_t grain) {
+  size_t n = 0, c;
+
+  for (c = 0; c < chunks; ++c) {
+    if (n != c * grain) {
+      memmove(&out[n], &out[c * grain], counts[c] * sizeof(uint32_t));
+    }
+    n += counts[c];
+  }
+  return n;
+}
+
+typedef struct mmath_parallel_cull_args {
+  uint32_t *out;
+  const frustum *f;
+  // x, y, z, radius for spheres, min x/y/z and max x/y/z for boxes
+  const float *in[6];
+  bool aabbs;
+  size_t grain;
+  uint32_t *counts;
+} mmath_parallel_cull_args;
+
+static void mmath_parallel_cull_chunk(size_t begin, size_t end, void *user) {
+  const mmath_parallel_cull_args *args = (const mmath_parallel_cull_args *) user;
+  const float *const *in = args->in;
+  uint32_t *out = &args->out[begin];
+  size_t n, i;
+
+  if (args->aabbs) {
+    n = frustum_cull_aabbs(
+      out, args->f, &in[0][begin], &in[1][begin], &in[2][begin], &in[3][begin], &in[4][begin], &in[5][begin], end - begin
+    );
+  } else {
+    n = frustum_cull_spheres(out, args->f, &in[0][begin], &in[1][begin], &in[2][begin], &in[3][begin], end - begin);
+  }
+  for (i = 0; i < n; ++i) {
+    out[i] += (uint32_t) begin;
+  }
+  args->counts[begin / args->grain] = (uint32_t) n;
+}
+
+static size_t mmath_parallel_cull(mmath_pool *pool, mmath_parallel_cull_args *args, size_t bytes, size_t count) {
+  uint32_t counts[MMATH_PARALLEL_MAX_COMPACT_CHUNKS];
+  size_t grain = mmath_parallel_compact_grain(pool, bytes, count);
+
+  args->grain = grain;
+  args->counts = counts;
+  mmath_parallel_for(pool, count, grain, mmath_parallel_cull_chunk, args);
+  return mmath_parallel_compact(args->out, counts, mmath_parallel_chunks(count, grain), grain);
+}
+
+size_t mmath_parallel_frustum_cull_spheres(
+  mmath_pool *pool,
+  uint32_t *out,
+  const frustum *f,
+  const float *x,
+  const float *y,
+  const float *z,
+  const float *radius,
+  size_t count
+) {
+  mmath_parallel_cull_args args = { out, f, { x, y, z, radius, NULL, NULL }, false, 0, NULL };
+
+  if (count == 0) {
+    return 0;
+  }
+  return mmath_parallel_cull(pool, &args, 4 * sizeof(float) + sizeof(uint32_t), count);
+}
+
+size_t mmath_parallel_frustum_cull_aabbs(
+  mmath_pool *pool,
+  uint32_t *out,
+  const frustum *f,
+  const float *min_x,
+  const float *min_y,
+  const float *min_z,
+  const float *max_x,
+  const float *max_y,
+  const float *max_z,
+  size_t count
+) {
+  mmath_parallel_cull_args args = { out, f, { min_x, min_y, min_z, max_x, max_y, max_z }, true, 0, NULL };
+
+  if (count == 0) {
+    return 0;
+  }
+  return mmath_parallel_cull(pool, &args, 6 * sizeof(float) + sizeof(uint32_t), count);
+}
+
+// The dirty nodes are split into chunks in breadth-first order, and each chunk counts how many of
+// its nodes are written. A node waits until every node up to its parent is written, instead of
+// for the whole level above, so deeper levels start while the rest of a level is still running.
+// Waits only go to lower chunks. A thread takes its own chunks in order, and a thief keeps the
+// part of a range above the chunk it steals, so every range still waiting to be taken lies above
+// the chunk its thread is running. The lowest unfinished chunk therefore has nothing left below
+// it to wait for, and the update always finishes.
+#if defined(MMATH_HAVE_THREADS)
+typedef _Atomic uint32_t mmath_parallel_counter;
+
+static uint32_t mmath_parallel_counter_get(mmath_parallel_counter *counter) {
+  return atomic_load_explicit(counter, memory_order_acquire);
+}
+
+static void mmath_parallel_counter_set(mmath_parallel_counter *counter, uint32_t value) {
+  atomic_store_explicit(counter, value, memory_order_release);
+}
+
+// Returns the counter, which may have gone past value
+static uint32_t mmath_parallel_counter_wait(mmath_parallel_counter *counter, uint32_t value) {
+  uint32_t current;
+
+  while ((current = mmath_parallel_counter_get(counter)) < value) {
+    sched_yield();
+  }
+  return current;
+}
+#else
+// Chunks run in order on the calling thread, so a parent is always written already
+typedef uint32_t mmath_parallel_counter;
+
+static uint32_t mmath_parallel_counter_get(mmath_parallel_counter *counter) {
+  return *counter;
+}
+
+static void mmath_parallel_counter_set(mmath_parallel_counter *counter, uint32_t value) {
+  *counter = value;
+}
+
+static uint32_t mmath_parallel_counter_wait(mmath_parallel_counter *counter, uint32_t value) {
+  (void) value;
+  return *counter;
+}
+#endif
+
+typedef struct mmath_parallel_hierarchy_args {
+  hierarchy *h;
+  size_t first;
+  // Chunks are a power of two long, so finding the chunk of an offset is a shift
+  unsigned shift;
+  uint32_t *updated;
+  uint32_t *counts;
+  // Written nodes per chunk, and an offset below which every node is known to be written
+  mmath_parallel_counter *done;
+  mmath_parallel_counter ready;
+} mmath_parallel_hierarchy_args;
+
+// Moves ready past offset, which is below the calling chunk
+static size_t mmath_parallel_hierarchy_wait(mmath_parallel_hierarchy_args *args, size_t ready, size_t offset) {
+  size_t shared = mmath_parallel_counter_get(&args->ready);
+
+  if (ready < shared) {
+    ready = shared;
+  }
+  while (ready <= offset) {
+    size_t chunk = ready >> args->shift, chunk_begin = chunk << args->shift;
+    // Chunks below the calling one are all full length
+    size_t needed = offset - chunk_begin < ((size_t) 1 << args->shift)
+      ? offset - chunk_begin + 1
+      : (size_t) 1 << args->shift;
+    ready = chunk_begin + mmath_parallel_counter_wait(&args->done[chunk], (uint32_t) needed);
+  }
+  // Other chunks skip the counters this one already went through. A racing store may lower
+  // ready, which only costs them a few more reads.
+  if (ready > shared) {
+    mmath_parallel_counter_set(&args->ready, (uint32_t) ready);
+  }
+  return ready;
+}
+
+static void mmath_parallel_hierarchy_chunk(size_t begin, size_t end, void *user) {
+  mmath_parallel_hierarchy_args *args = (mmath_parallel_hierarchy_args *) user;
+  hierarchy *h = args->h;
+  size_t first = args->first;
+  mmath_parallel_counter *done = &args->done[begin >> args->shift];
+  size_t ready = 0, n = 0, i;
+
+  for (i = first + begin; i < first + end; ++i) {
+    int32_t parent = h->parents[i];
+
+    // Nodes before first are clean and not written during the update
+    if (parent >= 0 && (size_t) parent >= first) {
+      size_t offset = (size_t) parent - first;
+      if (offset >= ready && offset < begin) {
+        ready = mmath_parallel_hierarchy_wait(args, ready, offset);
+      }
+      if (h->dirty[parent]) {
+        h->dirty[i] = 1;
+      }
+    }
+
+    if (h->dirty[i]) {
+      mat4_from_rotation_translation_scale(&h->worlds[i], &h->rotations[i], &h->translations[i], &h->scales[i]);
+      if (parent >= 0) {
+        mat4_multiply(&h->worlds[i], &h->worlds[parent], &h->worlds[i]);
+      }
+      if (args->updated != NULL) {
+        args->updated[begin + n] = (uint32_t) i;
+      }
+      ++n;
+    }
+    mmath_parallel_counter_set(done, (uint32_t) (i - first - begin + 1));
+  }
+
+  args->counts[begin >> args->shift] = (uint32_t) n;
+}
+
+size_t mmath_parallel_hierarchy_update(mmath_pool *pool, hierarchy *h, uint32_t *updated) {
+  mmath_parallel_counter done[MMATH_PARALLEL_MAX_COMPACT_CHUNKS];
+  uint32_t counts[MMATH_PARALLEL_MAX_COMPACT_CHUNKS];
+  mmath_parallel_hierarchy_args args;
+  size_t first = h->first_dirty, count, grain, chunks, n = 0, c;
+
+  if (first >= h->count) {
+    h->first_dirty = h->count;
+    return 0;
+  }
+
+  count = h->count - first;
+  args.h = h;
+  args.first = first;
+  grain = mmath_parallel_compact_grain(
+    pool, 2 * sizeof(mat4) + sizeof(quat) + 2 * sizeof(vec3) + sizeof(int32_t) + sizeof(uint32_t) + 1, count
+  );
+  for (args.shift = 0; ((size_t) 1 << args.shift) < grain; ++args.shift) {
+  }
+  grain = (size_t) 1 << args.shift;
+  args.updated = updated;
+  args.counts = counts;
+  args.done = done;
+  mmath_parallel_counter_set(&args.ready, 0);
+
+  chunks = mmath_parallel_chunks(count, grain);
+  for (c = 0; c < chunks; ++c) {
+    mmath_parallel_counter_set(&done[c], 0);
+  }
+  mmath_parallel_for(pool, count, grain, mmath_parallel_hierarchy_chunk, &args);
+
+  if (updated != NULL) {
+    n = mmath_parallel_compact(updated, counts, chunks, grain);
+  } else {
+    for (c = 0; c < chunks; ++c) {
+      n += counts[c];
+    }
+  }
+
+  memset(&h->dirty[first], 0, count);
+  h->first_dirty = h->count;
+  return n;
+}
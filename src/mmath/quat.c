@@ -1,40 +1,35 @@
 #include "mmath/quat.h"
 #include "mmath_private.h"
+#include "mmath/quat_inline.h"
+#include "quat_slerp.h"
 
 quat *quat_create() {
-  quat *out = malloc(sizeof(quat));
+  quat *out = mmath_alloc(sizeof(quat), _Alignof(quat));
   return quat_identity(out);
 }
 
 void quat_free(quat *a) {
-  free(a);
+  mmath_free(a, sizeof(quat), _Alignof(quat));
 }
 
-quat *quat_clone(const quat *a) {
-  quat *out = quat_create();
-  quat_copy(out, a);
+quata *quata_create() {
+  quata *out = mmath_alloc(sizeof(quata), _Alignof(quata));
+  quat_identity(&out->q);
   return out;
 }
 
-quat *quat_from_values(float x, float y, float z, float w) {
-  return quat_set(quat_create(), x, y, z, w);
+void quata_free(quata *a) {
+  mmath_free(a, sizeof(quata), _Alignof(quata));
 }
 
-quat *quat_copy(quat *out, const quat *a) {
-  memcpy(out->data, a->data, sizeof(a->data));
+quat *quat_clone(const quat *a) {
+  quat *out = quat_create();
+  quat_copy(out, a);
   return out;
 }
 
-quat *quat_identity(quat *out) {
-  return quat_set(out, 0.f, 0.f, 0.f, 1.f);
-}
-
-quat *quat_set(quat *out, float x, float y, float z, float w) {
-  out->x = x;
-  out->y = y;
-  out->z = z;
-  out->w = w;
-  return out;
+quat *quat_from_values(float x, float y, float z, float w) {
+  return quat_set(quat_create(), x, y, z, w);
 }
 
 float quat_get_axis_angle(quat *out_axis, const quat *q) {
@@ -55,30 +50,13 @@ float quat_get_axis_angle(quat *out_axis, const quat *q) {
 }
 
 quat *quat_set_axis_angle(quat *out, const vec3 *axis, float angle) {
-  angle *= .5f;
-  float s = sinf(angle);
+  float s, c;
+  mmath_sincosf(angle * .5f, &s, &c);
 
   out->x = s * axis->x;
   out->y = s * axis->y;
   out->z = s * axis->z;
-  out->w = cosf(angle);
-  return out;
-}
-
-quat *quat_multiply(quat *out, const quat *a, const quat *b) {
-  float ax = a->x;
-  float ay = a->y;
-  float az = a->z;
-  float aw = a->w;
-  float bx = b->x;
-  float by = b->y;
-  float bz = b->z;
-  float bw = b->w;
-
-  out->x = ax * bw + aw * bx + ay * bz - az * by;
-  out->y = ay * bw + aw * by + az * bx - ax * bz;
-  out->z = az * bw + aw * bz + ax * by - ay * bx;
-  out->w = aw * bw - ax * bx - ay * by - az * bz;
+  out->w = c;
   return out;
 }
 
@@ -90,8 +68,8 @@ quat *quat_rotate_x(quat *out, const quat *a, float angle) {
   float az = a->z;
   float aw = a->w;
 
-  float bx = sinf(angle);
-  float bw = cosf(angle);
+  float bx, bw;
+  mmath_sincosf(angle, &bx, &bw);
   
   out->x = ax * bw + aw * bx;
   out->y = ay * bw + az * bx;
@@ -108,8 +86,8 @@ quat *quat_rotate_y(quat *out, const quat *a, float angle) {
   float az = a->z;
   float aw = a->w;
 
-  float by = sinf(angle);
-  float bw = cosf(angle);
+  float by, bw;
+  mmath_sincosf(angle, &by, &bw);
   
   out->x = ax * bw - az * by;
   out->y = ay * bw + aw * by;
@@ -126,8 +104,8 @@ quat *quat_rotate_z(quat *out, const quat *a, float angle) {
   float az = a->z;
   float aw = a->w;
 
-  float bz = sinf(angle);
-  float bw = cosf(angle);
+  float bz, bw;
+  mmath_sincosf(angle, &bz, &bw);
   
   out->x = ax * bw + ay * bz;
   out->y = ay * bw - ax * bz;
@@ -148,22 +126,6 @@ quat *quat_calculate_w(quat *out, const quat *a) {
   return out;
 }
 
-quat *quat_add(quat *out, const quat *a, const quat *b) {
-  return (quat *) vec4_add((vec4 *) out, (const vec4 *) a, (const vec4 *) b);
-}
-
-quat *quat_scale(quat *out, const quat *a, float b) {
-  return (quat *) vec4_scale((vec4 *) out, (const vec4 *) a, b);
-}
-
-float quat_dot(const quat *a, const quat *b) {
-  return vec4_dot((const vec4 *) a, (const vec4 *) b);
-}
-
-quat *quat_lerp(quat *out, const quat *a, const quat *b, float t) {
-  return (quat *) vec4_lerp((vec4 *) out, (const vec4 *) a, (const vec4 *) b, t);
-}
-
 quat *quat_slerp(quat *out, const quat *a, const quat *b, float t) {
   // benchmarks:
   //    http://jsperf.com/quaternion-slerp-implementations
@@ -212,12 +174,245 @@ quat *quat_slerp(quat *out, const quat *a, const quat *b, float t) {
   return out;
 }
 
-float quat_length(const quat *a) {
-  return vec4_length((const vec4 *) a);
+// Evaluates sin(t * theta) / sin(theta) as a polynomial in cos(theta) - 1 (Horner form)
+static inline float quat_slerp_fast_coefficient(float xm1, float t) {
+  float sqr_t = t * t;
+  float c = 1.f;
+  int i;
+  for (i = 7; i >= 0; --i) {
+    c = 1.f + (mmath_slerp_u[i] * sqr_t - mmath_slerp_v[i]) * xm1 * c;
+  }
+  return t * c;
+}
+
+quat *quat_slerp_fast(quat *out, const quat *a, const quat *b, float t) {
+  float cosom = a->x * b->x + a->y * b->y + a->z * b->z + a->w * b->w;
+  float sign = cosom < 0.f ? -1.f : 1.f;
+  float xm1 = cosom * sign - 1.f;
+  float scale0 = quat_slerp_fast_coefficient(xm1, 1.f - t);
+  float scale1 = quat_slerp_fast_coefficient(xm1, t) * sign;
+
+  out->x = scale0 * a->x + scale1 * b->x;
+  out->y = scale0 * a->y + scale1 * b->y;
+  out->z = scale0 * a->z + scale1 * b->z;
+  out->w = scale0 * a->w + scale1 * b->w;
+  return out;
+}
+
+#if defined(MMATH_SSE2)
+
+// Four quaternions, one component per register
+typedef struct quat_x4 {
+  __m128 x, y, z, w;
+} quat_x4;
+
+static inline void quat_x4_load(quat_x4 *q, const quat *a) {
+  q->x = _mm_loadu_ps(a[0].data);
+  q->y = _mm_loadu_ps(a[1].data);
+  q->z = _mm_loadu_ps(a[2].data);
+  q->w = _mm_loadu_ps(a[3].data);
+  _MM_TRANSPOSE4_PS(q->x, q->y, q->z, q->w);
+}
+
+static inline void quat_x4_store(quat *out, quat_x4 q) {
+  _MM_TRANSPOSE4_PS(q.x, q.y, q.z, q.w);
+  _mm_storeu_ps(out[0].data, q.x);
+  _mm_storeu_ps(out[1].data, q.y);
+  _mm_storeu_ps(out[2].data, q.z);
+  _mm_storeu_ps(out[3].data, q.w);
+}
+
+static inline void quat_x4_load_soa(quat_x4 *q, const float *const a[4], size_t i) {
+  q->x = _mm_loadu_ps(&a[0][i]);
+  q->y = _mm_loadu_ps(&a[1][i]);
+  q->z = _mm_loadu_ps(&a[2][i]);
+  q->w = _mm_loadu_ps(&a[3][i]);
+}
+
+static inline void quat_x4_store_soa(float *const out[4], size_t i, const quat_x4 *q) {
+  _mm_storeu_ps(&out[0][i], q->x);
+  _mm_storeu_ps(&out[1][i], q->y);
+  _mm_storeu_ps(&out[2][i], q->z);
+  _mm_storeu_ps(&out[3][i], q->w);
+}
+
+static inline __m128 quat_x4_dot(const quat_x4 *a, const quat_x4 *b) {
+  return _mm_add_ps(
+    _mm_add_ps(_mm_mul_ps(a->x, b->x), _mm_mul_ps(a->y, b->y)),
+    _mm_add_ps(_mm_mul_ps(a->z, b->z), _mm_mul_ps(a->w, b->w))
+  );
+}
+
+// out = a * s0 + b * s1
+static inline quat_x4 quat_x4_blend(const quat_x4 *a, const quat_x4 *b, __m128 s0, __m128 s1) {
+  quat_x4 out;
+  out.x = _mm_add_ps(_mm_mul_ps(a->x, s0), _mm_mul_ps(b->x, s1));
+  out.y = _mm_add_ps(_mm_mul_ps(a->y, s0), _mm_mul_ps(b->y, s1));
+  out.z = _mm_add_ps(_mm_mul_ps(a->z, s0), _mm_mul_ps(b->z, s1));
+  out.w = _mm_add_ps(_mm_mul_ps(a->w, s0), _mm_mul_ps(b->w, s1));
+  return out;
+}
+
+static inline __m128 quat_x4_slerp_coefficient(__m128 xm1, __m128 t) {
+  __m128 sqr_t = _mm_mul_ps(t, t);
+  __m128 one = _mm_set1_ps(1.f);
+  __m128 c = one;
+  int i;
+  for (i = 7; i >= 0; --i) {
+    __m128 b = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(mmath_slerp_u[i]), sqr_t), _mm_set1_ps(mmath_slerp_v[i]));
+    c = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(b, xm1), c));
+  }
+  return _mm_mul_ps(t, c);
+}
+
+static inline quat_x4 quat_x4_slerp_fast(const quat_x4 *a, const quat_x4 *b, __m128 t) {
+  __m128 cosom = quat_x4_dot(a, b);
+  __m128 sign = _mm_and_ps(cosom, _mm_set1_ps(-0.f));
+  __m128 xm1 = _mm_sub_ps(_mm_xor_ps(cosom, sign), _mm_set1_ps(1.f));
+  __m128 scale0 = quat_x4_slerp_coefficient(xm1, _mm_sub_ps(_mm_set1_ps(1.f), t));
+  __m128 scale1 = _mm_xor_ps(quat_x4_slerp_coefficient(xm1, t), sign);
+  return quat_x4_blend(a, b, scale0, scale1);
+}
+
+static inline quat_x4 quat_x4_nlerp(const quat_x4 *a, const quat_x4 *b, __m128 t) {
+  __m128 sign = _mm_and_ps(quat_x4_dot(a, b), _mm_set1_ps(-0.f));
+  quat_x4 out = quat_x4_blend(a, b, _mm_sub_ps(_mm_set1_ps(1.f), t), _mm_xor_ps(t, sign));
+  __m128 len = _mm_sqrt_ps(quat_x4_dot(&out, &out));
+  __m128 inv = _mm_div_ps(_mm_set1_ps(1.f), len);
+  // Zero-length results stay zero, like quat_normalize
+  inv = _mm_and_ps(inv, _mm_cmpgt_ps(len, _mm_setzero_ps()));
+  out.x = _mm_mul_ps(out.x, inv);
+  out.y = _mm_mul_ps(out.y, inv);
+  out.z = _mm_mul_ps(out.z, inv);
+  out.w = _mm_mul_ps(out.w, inv);
+  return out;
+}
+
+#endif
+
+static inline quat *quat_nlerp(quat *out, const quat *a, const quat *b, float t) {
+  float scale1 = quat_dot(a, b) < 0.f ? -t : t;
+  float scale0 = 1.f - t;
+
+  out->x = scale0 * a->x + scale1 * b->x;
+  out->y = scale0 * a->y + scale1 * b->y;
+  out->z = scale0 * a->z + scale1 * b->z;
+  out->w = scale0 * a->w + scale1 * b->w;
+  return quat_normalize(out, out);
+}
+
+static inline void quat_load_soa(quat *out, const float *const a[4], size_t i) {
+  quat_set(out, a[0][i], a[1][i], a[2][i], a[3][i]);
+}
+
+static inline void quat_store_soa(float *const out[4], size_t i, const quat *a) {
+  out[0][i] = a->x;
+  out[1][i] = a->y;
+  out[2][i] = a->z;
+  out[3][i] = a->w;
+}
+
+quat *quat_slerp_batch(quat *out, const quat *a, const quat *b, const float *t, size_t count) {
+  size_t i;
+  for (i = 0; i < count; ++i) {
+    quat_slerp(&out[i], &a[i], &b[i], t[i]);
+  }
+  return out;
 }
 
-float quat_length_squared(const quat *a) {
-  return vec4_length_squared((const vec4 *) a);
+quat *quat_slerp_fast_batch(quat *out, const quat *a, const quat *b, const float *t, size_t count) {
+  size_t i = 0;
+
+#if defined(MMATH_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    quat_x4 qa, qb;
+    quat_x4_load(&qa, &a[i]);
+    quat_x4_load(&qb, &b[i]);
+    quat_x4_store(&out[i], quat_x4_slerp_fast(&qa, &qb, _mm_loadu_ps(&t[i])));
+  }
+#endif
+
+  for (; i < count; ++i) {
+    quat_slerp_fast(&out[i], &a[i], &b[i], t[i]);
+  }
+  return out;
+}
+
+quat *quat_nlerp_batch(quat *out, const quat *a, const quat *b, const float *t, size_t count) {
+  size_t i = 0;
+
+#if defined(MMATH_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    quat_x4 qa, qb;
+    quat_x4_load(&qa, &a[i]);
+    quat_x4_load(&qb, &b[i]);
+    quat_x4_store(&out[i], quat_x4_nlerp(&qa, &qb, _mm_loadu_ps(&t[i])));
+  }
+#endif
+
+  for (; i < count; ++i) {
+    quat_nlerp(&out[i], &a[i], &b[i], t[i]);
+  }
+  return out;
+}
+
+void quat_slerp_batch_soa(float *const out[4], const float *const a[4], const float *const b[4], const float *t, size_t count) {
+  size_t i;
+  for (i = 0; i < count; ++i) {
+    quat qa, qb, r;
+    quat_load_soa(&qa, a, i);
+    quat_load_soa(&qb, b, i);
+    quat_store_soa(out, i, quat_slerp(&r, &qa, &qb, t[i]));
+  }
+}
+
+void quat_slerp_fast_batch_soa(float *const out[4], const float *const a[4], const float *const b[4], const float *t, size_t count) {
+  size_t i = 0;
+
+#if defined(MMATH_HAVE_X86_SIMD)
+  if (mmath_get_backend() >= MMATH_BACKEND_AVX2) {
+    i = count & ~(size_t) 7;
+    mmath_quat_slerp_fast_soa_avx2(out, a, b, t, i);
+  }
+#endif
+
+#if defined(MMATH_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    quat_x4 qa, qb, r;
+    quat_x4_load_soa(&qa, a, i);
+    quat_x4_load_soa(&qb, b, i);
+    r = quat_x4_slerp_fast(&qa, &qb, _mm_loadu_ps(&t[i]));
+    quat_x4_store_soa(out, i, &r);
+  }
+#endif
+
+  for (; i < count; ++i) {
+    quat qa, qb, r;
+    quat_load_soa(&qa, a, i);
+    quat_load_soa(&qb, b, i);
+    quat_store_soa(out, i, quat_slerp_fast(&r, &qa, &qb, t[i]));
+  }
+}
+
+void quat_nlerp_batch_soa(float *const out[4], const float *const a[4], const float *const b[4], const float *t, size_t count) {
+  size_t i = 0;
+
+#if defined(MMATH_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    quat_x4 qa, qb, r;
+    quat_x4_load_soa(&qa, a, i);
+    quat_x4_load_soa(&qb, b, i);
+    r = quat_x4_nlerp(&qa, &qb, _mm_loadu_ps(&t[i]));
+    quat_x4_store_soa(out, i, &r);
+  }
+#endif
+
+  for (; i < count; ++i) {
+    quat qa, qb, r;
+    quat_load_soa(&qa, a, i);
+    quat_load_soa(&qb, b, i);
+    quat_store_soa(out, i, quat_nlerp(&r, &qa, &qb, t[i]));
+  }
 }
 
 quat *quat_random(quat *out) {
@@ -238,10 +433,6 @@ quat *quat_random(quat *out) {
   return out;
 }
 
-quat *quat_normalize(quat *out, const quat *a) {
-  return (quat *) vec4_normalize((vec4 *) out, (vec4 *) a);
-}
-
 quat *quat_invert(quat *out, const quat *a) {
   float ax = a->x;
   float ay = a->y;
@@ -264,14 +455,6 @@ quat *quat_invert(quat *out, const quat *a) {
   return out;
 }
 
-quat *quat_conjugate(quat *out, const quat *a) {
-  out->x = -a->x;
-  out->y = -a->y;
-  out->z = -a->z;
-  out->w =  a->w;
-  return out;
-}
-
 quat *quat_from_mat3(quat *out, const mat3 *m) {
   // Algorithm in Ken Shoemake's article in 1987 SIGGRAPH course notes
   // article "Quaternion Calculus and Fast Animation".
@@ -316,12 +499,10 @@ quat *quat_from_euler(quat *out, float x, float y, float z) {
   y *= half_to_rad;
   z *= half_to_rad;
   
-  float sx = sinf(x);
-  float cx = cosf(x);
-  float sy = sinf(y);
-  float cy = cosf(y);
-  float sz = sinf(z);
-  float cz = cosf(z);
+  float sx, cx, sy, cy, sz, cz;
+  mmath_sincosf(x, &sx, &cx);
+  mmath_sincosf(y, &sy, &cy);
+  mmath_sincosf(z, &sz, &cz);
   
   out->x = sx * cy * cz - cx * sy * sz;
   out->y = cx * sy * cz + sx * cy * sz;
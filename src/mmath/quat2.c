@@ -0,0 +1,457 @@
+#include "mmath/quat2.h"
+#include "mmath_private.h"
+
+quat2 *quat2_create() {
+  quat2 *out = mmath_alloc(sizeof(quat2), _Alignof(quat2));
+  return quat2_identity(out);
+}
+
+void quat2_free(quat2 *a) {
+  mmath_free(a, sizeof(quat2), _Alignof(quat2));
+}
+
+quat2a *quat2a_create() {
+  quat2a *out = mmath_alloc(sizeof(quat2a), _Alignof(quat2a));
+  quat2_identity(&out->q);
+  return out;
+}
+
+void quat2a_free(quat2a *a) {
+  mmath_free(a, sizeof(quat2a), _Alignof(quat2a));
+}
+
+quat2 *quat2_clone(const quat2 *a) {
+  quat2 *out = quat2_create();
+  quat2_copy(out, a);
+  return out;
+}
+
+quat2 *quat2_from_values(float x1, float y1, float z1, float w1, float x2, float y2, float z2, float w2) {
+  return quat2_set(quat2_create(), x1, y1, z1, w1, x2, y2, z2, w2);
+}
+
+quat2 *quat2_from_rotation_translation_values(float x1, float y1, float z1, float w1, float x2, float y2, float z2) {
+  quat q;
+  vec3 t;
+
+  quat_set(&q, x1, y1, z1, w1);
+  vec3_set(&t, x2, y2, z2);
+  return quat2_from_rotation_translation(quat2_create(), &q, &t);
+}
+
+quat2 *quat2_from_rotation_translation(quat2 *out, const quat *q, const vec3 *t) {
+  float ax = t->x * .5f;
+  float ay = t->y * .5f;
+  float az = t->z * .5f;
+  float bx = q->x;
+  float by = q->y;
+  float bz = q->z;
+  float bw = q->w;
+
+  out->x1 = bx;
+  out->y1 = by;
+  out->z1 = bz;
+  out->w1 = bw;
+  out->x2 = ax * bw + ay * bz - az * by;
+  out->y2 = ay * bw + az * bx - ax * bz;
+  out->z2 = az * bw + ax * by - ay * bx;
+  out->w2 = -ax * bx - ay * by - az * bz;
+  return out;
+}
+
+quat2 *quat2_from_translation(quat2 *out, const vec3 *t) {
+  return quat2_set(out, 0.f, 0.f, 0.f, 1.f, t->x * .5f, t->y * .5f, t->z * .5f, 0.f);
+}
+
+quat2 *quat2_from_rotation(quat2 *out, const quat *q) {
+  return quat2_set(out, q->x, q->y, q->z, q->w, 0.f, 0.f, 0.f, 0.f);
+}
+
+quat2 *quat2_from_mat4(quat2 *out, const mat4 *a) {
+  quat outer;
+  vec3 t;
+
+  mat4_get_rotation(&outer, a);
+  mat4_get_translation(&t, a);
+  return quat2_from_rotation_translation(out, &outer, &t);
+}
+
+quat2 *quat2_copy(quat2 *out, const quat2 *a) {
+  memcpy(out->data, a->data, sizeof(a->data));
+  return out;
+}
+
+quat2 *quat2_identity(quat2 *out) {
+  return quat2_set(out, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f);
+}
+
+quat2 *quat2_set(quat2 *out, float x1, float y1, float z1, float w1, float x2, float y2, float z2, float w2) {
+  out->x1 = x1;
+  out->y1 = y1;
+  out->z1 = z1;
+  out->w1 = w1;
+  out->x2 = x2;
+  out->y2 = y2;
+  out->z2 = z2;
+  out->w2 = w2;
+  return out;
+}
+
+quat *quat2_get_real(quat *out, const quat2 *a) {
+  return quat_set(out, a->x1, a->y1, a->z1, a->w1);
+}
+
+quat *quat2_get_dual(quat *out, const quat2 *a) {
+  return quat_set(out, a->x2, a->y2, a->z2, a->w2);
+}
+
+quat2 *quat2_set_real(quat2 *out, const quat *q) {
+  out->x1 = q->x;
+  out->y1 = q->y;
+  out->z1 = q->z;
+  out->w1 = q->w;
+  return out;
+}
+
+quat2 *quat2_set_dual(quat2 *out, const quat *q) {
+  out->x2 = q->x;
+  out->y2 = q->y;
+  out->z2 = q->z;
+  out->w2 = q->w;
+  return out;
+}
+
+vec3 *quat2_get_translation(vec3 *out, const quat2 *a) {
+  float ax = a->x2, ay = a->y2, az = a->z2, aw = a->w2;
+  float bx = -a->x1, by = -a->y1, bz = -a->z1, bw = a->w1;
+
+  out->x = (ax * bw + aw * bx + ay * bz - az * by) * 2.f;
+  out->y = (ay * bw + aw * by + az * bx - ax * bz) * 2.f;
+  out->z = (az * bw + aw * bz + ax * by - ay * bx) * 2.f;
+  return out;
+}
+
+quat2 *quat2_translate(quat2 *out, const quat2 *a, const vec3 *v) {
+  float ax1 = a->x1, ay1 = a->y1, az1 = a->z1, aw1 = a->w1;
+  float bx1 = v->x * .5f, by1 = v->y * .5f, bz1 = v->z * .5f;
+  float ax2 = a->x2, ay2 = a->y2, az2 = a->z2, aw2 = a->w2;
+
+  out->x1 = ax1;
+  out->y1 = ay1;
+  out->z1 = az1;
+  out->w1 = aw1;
+  out->x2 = aw1 * bx1 + ay1 * bz1 - az1 * by1 + ax2;
+  out->y2 = aw1 * by1 + az1 * bx1 - ax1 * bz1 + ay2;
+  out->z2 = aw1 * bz1 + ax1 * by1 - ay1 * bx1 + az2;
+  out->w2 = -ax1 * bx1 - ay1 * by1 - az1 * bz1 + aw2;
+  return out;
+}
+
+// Rotates the real part with the given quat function and rebuilds the dual part
+// from the unchanged translation
+static quat2 *quat2_rotate_real(
+  quat2 *out,
+  const quat2 *a,
+  float angle,
+  quat *(*rotate)(quat *out, const quat *a, float angle)
+) {
+  float bx = -a->x1, by = -a->y1, bz = -a->z1, bw = a->w1;
+  float ax = a->x2, ay = a->y2, az = a->z2, aw = a->w2;
+  float ax1 = ax * bw + aw * bx + ay * bz - az * by;
+  float ay1 = ay * bw + aw * by + az * bx - ax * bz;
+  float az1 = az * bw + aw * bz + ax * by - ay * bx;
+  float aw1 = aw * bw - ax * bx - ay * by - az * bz;
+  quat real;
+
+  rotate(&real, (const quat *) a, angle);
+  bx = real.x;
+  by = real.y;
+  bz = real.z;
+  bw = real.w;
+
+  out->x1 = bx;
+  out->y1 = by;
+  out->z1 = bz;
+  out->w1 = bw;
+  out->x2 = ax1 * bw + aw1 * bx + ay1 * bz - az1 * by;
+  out->y2 = ay1 * bw + aw1 * by + az1 * bx - ax1 * bz;
+  out->z2 = az1 * bw + aw1 * bz + ax1 * by - ay1 * bx;
+  out->w2 = aw1 * bw - ax1 * bx - ay1 * by - az1 * bz;
+  return out;
+}
+
+quat2 *quat2_rotate_x(quat2 *out, const quat2 *a, float angle) {
+  return quat2_rotate_real(out, a, angle, quat_rotate_x);
+}
+
+quat2 *quat2_rotate_y(quat2 *out, const quat2 *a, float angle) {
+  return quat2_rotate_real(out, a, angle, quat_rotate_y);
+}
+
+quat2 *quat2_rotate_z(quat2 *out, const quat2 *a, float angle) {
+  return quat2_rotate_real(out, a, angle, quat_rotate_z);
+}
+
+quat2 *quat2_rotate_by_quat_append(quat2 *out, const quat2 *a, const quat *q) {
+  float qx = q->x, qy = q->y, qz = q->z, qw = q->w;
+  float ax = a->x1, ay = a->y1, az = a->z1, aw = a->w1;
+
+  out->x1 = ax * qw + aw * qx + ay * qz - az * qy;
+  out->y1 = ay * qw + aw * qy + az * qx - ax * qz;
+  out->z1 = az * qw + aw * qz + ax * qy - ay * qx;
+  out->w1 = aw * qw - ax * qx - ay * qy - az * qz;
+
+  ax = a->x2;
+  ay = a->y2;
+  az = a->z2;
+  aw = a->w2;
+  out->x2 = ax * qw + aw * qx + ay * qz - az * qy;
+  out->y2 = ay * qw + aw * qy + az * qx - ax * qz;
+  out->z2 = az * qw + aw * qz + ax * qy - ay * qx;
+  out->w2 = aw * qw - ax * qx - ay * qy - az * qz;
+  return out;
+}
+
+quat2 *quat2_rotate_by_quat_prepend(quat2 *out, const quat *q, const quat2 *a) {
+  float qx = q->x, qy = q->y, qz = q->z, qw = q->w;
+  float bx = a->x1, by = a->y1, bz = a->z1, bw = a->w1;
+
+  out->x1 = qx * bw + qw * bx + qy * bz - qz * by;
+  out->y1 = qy * bw + qw * by + qz * bx - qx * bz;
+  out->z1 = qz * bw + qw * bz + qx * by - qy * bx;
+  out->w1 = qw * bw - qx * bx - qy * by - qz * bz;
+
+  bx = a->x2;
+  by = a->y2;
+  bz = a->z2;
+  bw = a->w2;
+  out->x2 = qx * bw + qw * bx + qy * bz - qz * by;
+  out->y2 = qy * bw + qw * by + qz * bx - qx * bz;
+  out->z2 = qz * bw + qw * bz + qx * by - qy * bx;
+  out->w2 = qw * bw - qx * bx - qy * by - qz * bz;
+  return out;
+}
+
+quat2 *quat2_rotate_around_axis(quat2 *out, const quat2 *a, const vec3 *axis, float angle) {
+  quat q;
+  float len;
+
+  if (fabsf(angle) < MMATH_EPSILON) {
+    return quat2_copy(out, a);
+  }
+
+  len = vec3_length(axis);
+  float s, c;
+  mmath_sincosf(angle * .5f, &s, &c);
+  s /= len;
+
+  quat_set(&q, axis->x * s, axis->y * s, axis->z * s, c);
+  return quat2_rotate_by_quat_append(out, a, &q);
+}
+
+quat2 *quat2_add(quat2 *out, const quat2 *a, const quat2 *b) {
+  out->x1 = a->x1 + b->x1;
+  out->y1 = a->y1 + b->y1;
+  out->z1 = a->z1 + b->z1;
+  out->w1 = a->w1 + b->w1;
+  out->x2 = a->x2 + b->x2;
+  out->y2 = a->y2 + b->y2;
+  out->z2 = a->z2 + b->z2;
+  out->w2 = a->w2 + b->w2;
+  return out;
+}
+
+quat2 *quat2_multiply(quat2 *out, const quat2 *a, const quat2 *b) {
+  float ax0 = a->x1, ay0 = a->y1, az0 = a->z1, aw0 = a->w1;
+  float bx1 = b->x2, by1 = b->y2, bz1 = b->z2, bw1 = b->w2;
+  float ax1 = a->x2, ay1 = a->y2, az1 = a->z2, aw1 = a->w2;
+  float bx0 = b->x1, by0 = b->y1, bz0 = b->z1, bw0 = b->w1;
+
+  out->x1 = ax0 * bw0 + aw0 * bx0 + ay0 * bz0 - az0 * by0;
+  out->y1 = ay0 * bw0 + aw0 * by0 + az0 * bx0 - ax0 * bz0;
+  out->z1 = az0 * bw0 + aw0 * bz0 + ax0 * by0 - ay0 * bx0;
+  out->w1 = aw0 * bw0 - ax0 * bx0 - ay0 * by0 - az0 * bz0;
+  out->x2 = ax0 * bw1 + aw0 * bx1 + ay0 * bz1 - az0 * by1 + ax1 * bw0 + aw1 * bx0 + ay1 * bz0 - az1 * by0;
+  out->y2 = ay0 * bw1 + aw0 * by1 + az0 * bx1 - ax0 * bz1 + ay1 * bw0 + aw1 * by0 + az1 * bx0 - ax1 * bz0;
+  out->z2 = az0 * bw1 + aw0 * bz1 + ax0 * by1 - ay0 * bx1 + az1 * bw0 + aw1 * bz0 + ax1 * by0 - ay1 * bx0;
+  out->w2 = aw0 * bw1 - ax0 * bx1 - ay0 * by1 - az0 * bz1 + aw1 * bw0 - ax1 * bx0 - ay1 * by0 - az1 * bz0;
+  return out;
+}
+
+quat2 *quat2_scale(quat2 *out, const quat2 *a, float b) {
+  out->x1 = a->x1 * b;
+  out->y1 = a->y1 * b;
+  out->z1 = a->z1 * b;
+  out->w1 = a->w1 * b;
+  out->x2 = a->x2 * b;
+  out->y2 = a->y2 * b;
+  out->z2 = a->z2 * b;
+  out->w2 = a->w2 * b;
+  return out;
+}
+
+float quat2_dot(const quat2 *a, const quat2 *b) {
+  return a->x1 * b->x1 + a->y1 * b->y1 + a->z1 * b->z1 + a->w1 * b->w1;
+}
+
+quat2 *quat2_lerp(quat2 *out, const quat2 *a, const quat2 *b, float t) {
+  float mt = 1.f - t;
+  int i;
+
+  if (quat2_dot(a, b) < 0.f) {
+    t = -t;
+  }
+
+  for (i = 0; i < 8; ++i) {
+    out->data[i] = a->data[i] * mt + b->data[i] * t;
+  }
+  return out;
+}
+
+quat2 *quat2_sclerp(quat2 *out, const quat2 *a, const quat2 *b, float t) {
+  // Raises the relative motion d = conj(a) * b to the power t through its screw
+  // parameters (angle, pitch, axis, moment) and applies it back onto a.
+  // See Kavan et al., "Dual Quaternions for Rigid Transformation Blending", 2006.
+  quat2 conj_a, d, dt;
+  float half_angle, s, c, pitch, scale;
+  float lx, ly, lz, mx, my, mz;
+
+  quat2_conjugate(&conj_a, a);
+  quat2_multiply(&d, &conj_a, b);
+  if (d.w1 < 0.f) {
+    quat2_scale(&d, &d, -1.f);
+  }
+
+  s = sqrtf(d.x1 * d.x1 + d.y1 * d.y1 + d.z1 * d.z1);
+
+  if (s < MMATH_EPSILON) {
+    // No rotation between a and b, the screw degenerates to a pure translation
+    quat2_set(&dt, 0.f, 0.f, 0.f, 1.f, d.x2 * t, d.y2 * t, d.z2 * t, 0.f);
+  } else {
+    half_angle = atan2f(s, d.w1);
+    pitch = -2.f * d.w2 / s;
+
+    lx = d.x1 / s;
+    ly = d.y1 / s;
+    lz = d.z1 / s;
+
+    c = d.w1 * pitch * .5f;
+    mx = (d.x2 - lx * c) / s;
+    my = (d.y2 - ly * c) / s;
+    mz = (d.z2 - lz * c) / s;
+
+    half_angle *= t;
+    pitch *= t;
+    mmath_sincosf(half_angle, &s, &c);
+    scale = pitch * .5f * c;
+
+    quat2_set(
+      &dt,
+      lx * s,
+      ly * s,
+      lz * s,
+      c,
+      mx * s + lx * scale,
+      my * s + ly * scale,
+      mz * s + lz * scale,
+      -pitch * .5f * s
+    );
+  }
+
+  quat2_multiply(out, a, &dt);
+  return quat2_normalize(out, out);
+}
+
+quat2 *quat2_invert(quat2 *out, const quat2 *a) {
+  float sqlen = quat2_length_squared(a);
+
+  out->x1 = -a->x1 / sqlen;
+  out->y1 = -a->y1 / sqlen;
+  out->z1 = -a->z1 / sqlen;
+  out->w1 = a->w1 / sqlen;
+  out->x2 = -a->x2 / sqlen;
+  out->y2 = -a->y2 / sqlen;
+  out->z2 = -a->z2 / sqlen;
+  out->w2 = a->w2 / sqlen;
+  return out;
+}
+
+quat2 *quat2_conjugate(quat2 *out, const quat2 *a) {
+  out->x1 = -a->x1;
+  out->y1 = -a->y1;
+  out->z1 = -a->z1;
+  out->w1 = a->w1;
+  out->x2 = -a->x2;
+  out->y2 = -a->y2;
+  out->z2 = -a->z2;
+  out->w2 = a->w2;
+  return out;
+}
+
+float quat2_length(const quat2 *a) {
+  return sqrtf(quat2_length_squared(a));
+}
+
+float quat2_length_squared(const quat2 *a) {
+  return a->x1 * a->x1 + a->y1 * a->y1 + a->z1 * a->z1 + a->w1 * a->w1;
+}
+
+quat2 *quat2_normalize(quat2 *out, const quat2 *a) {
+  float magnitude = quat2_length_squared(a);
+
+  if (magnitude > 0.f) {
+    magnitude = sqrtf(magnitude);
+
+    float a0 = a->x1 / magnitude;
+    float a1 = a->y1 / magnitude;
+    float a2 = a->z1 / magnitude;
+    float a3 = a->w1 / magnitude;
+
+    float b0 = a->x2;
+    float b1 = a->y2;
+    float b2 = a->z2;
+    float b3 = a->w2;
+
+    float a_dot_b = a0 * b0 + a1 * b1 + a2 * b2 + a3 * b3;
+
+    out->x1 = a0;
+    out->y1 = a1;
+    out->z1 = a2;
+    out->w1 = a3;
+    out->x2 = (b0 - a0 * a_dot_b) / magnitude;
+    out->y2 = (b1 - a1 * a_dot_b) / magnitude;
+    out->z2 = (b2 - a2 * a_dot_b) / magnitude;
+    out->w2 = (b3 - a3 * a_dot_b) / magnitude;
+  } else if (out != a) {
+    quat2_copy(out, a);
+  }
+
+  return out;
+}
+
+bool quat2_exact_equals(const quat2 *a, const quat2 *b) {
+  return (
+    a->data[0] == b->data[0] &&
+    a->data[1] == b->data[1] &&
+    a->data[2] == b->data[2] &&
+    a->data[3] == b->data[3] &&
+    a->data[4] == b->data[4] &&
+    a->data[5] == b->data[5] &&
+    a->data[6] == b->data[6] &&
+    a->data[7] == b->data[7]
+  );
+}
+
+bool quat2_equals(const quat2 *a, const quat2 *b) {
+  int i;
+
+  for (i = 0; i < 8; ++i) {
+    float a0 = a->data[i];
+    float b0 = b->data[i];
+
+    if (fabsf(a0 - b0) > MMATH_EPSILON * fmaxf(1.f, fmaxf(fabsf(a0), fabsf(b0)))) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,44 @@
+#include <immintrin.h>
+
+#include "mmath_private.h"
+#include "quat_slerp.h"
+
+static inline __m256 quat_slerp_coefficient_avx2(__m256 xm1, __m256 t) {
+  __m256 sqr_t = _mm256_mul_ps(t, t);
+  __m256 one = _mm256_set1_ps(1.f);
+  __m256 c = one;
+  int i;
+  for (i = 7; i >= 0; --i) {
+    __m256 b = _mm256_fmsub_ps(_mm256_set1_ps(mmath_slerp_u[i]), sqr_t, _mm256_set1_ps(mmath_slerp_v[i]));
+    c = _mm256_fmadd_ps(_mm256_mul_ps(b, xm1), c, one);
+  }
+  return _mm256_mul_ps(t, c);
+}
+
+void mmath_quat_slerp_fast_soa_avx2(float *const out[4], const float *const a[4], const float *const b[4], const float *t, size_t count) {
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 sign_mask = _mm256_set1_ps(-0.f);
+  size_t i;
+  int k;
+
+  for (i = 0; i < count; i += 8) {
+    __m256 qa[4], qb[4];
+    __m256 cosom = _mm256_setzero_ps();
+
+    for (k = 0; k < 4; ++k) {
+      qa[k] = _mm256_loadu_ps(&a[k][i]);
+      qb[k] = _mm256_loadu_ps(&b[k][i]);
+      cosom = _mm256_fmadd_ps(qa[k], qb[k], cosom);
+    }
+
+    __m256 tt = _mm256_loadu_ps(&t[i]);
+    __m256 sign = _mm256_and_ps(cosom, sign_mask);
+    __m256 xm1 = _mm256_sub_ps(_mm256_xor_ps(cosom, sign), one);
+    __m256 scale0 = quat_slerp_coefficient_avx2(xm1, _mm256_sub_ps(one, tt));
+    __m256 scale1 = _mm256_xor_ps(quat_slerp_coefficient_avx2(xm1, tt), sign);
+
+    for (k = 0; k < 4; ++k) {
+      _mm256_storeu_ps(&out[k][i], _mm256_fmadd_ps(qa[k], scale0, _mm256_mul_ps(qb[k], scale1)));
+    }
+  }
+}
@@ -0,0 +1,19 @@
+#ifndef MMATH_QUAT_SLERP_H
+#define MMATH_QUAT_SLERP_H
+
+// Coefficients of Eberly's polynomial slerp ("A Fast and Accurate Algorithm for Computing
+// SLERP", 2011): u[i] = 1 / ((i + 1) * (2i + 3)), v[i] = (i + 1) / (2i + 3), with the last
+// term scaled by mu to balance the truncation error over the whole [0, 1] range of cos(theta).
+#define MMATH_SLERP_MU 1.85298109240830f
+
+static const float mmath_slerp_u[8] = {
+  1.f / (1.f * 3.f), 1.f / (2.f * 5.f), 1.f / (3.f * 7.f), 1.f / (4.f * 9.f),
+  1.f / (5.f * 11.f), 1.f / (6.f * 13.f), 1.f / (7.f * 15.f), MMATH_SLERP_MU / (8.f * 17.f)
+};
+
+static const float mmath_slerp_v[8] = {
+  1.f / 3.f, 2.f / 5.f, 3.f / 7.f, 4.f / 9.f,
+  5.f / 11.f, 6.f / 13.f, 7.f / 15.f, MMATH_SLERP_MU * 8.f / 17.f
+};
+
+#endif // MMATH_QUAT_SLERP_H
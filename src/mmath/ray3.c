@@ -0,0 +1,333 @@
+#include "mmath/ray3.h"
+#include "mmath_private.h"
+
+ray3 *ray3_create() {
+  ray3 *out = mmath_alloc(sizeof(ray3), _Alignof(ray3));
+  vec3_zero(&out->origin);
+  vec3_zero(&out->direction);
+  return out;
+}
+
+void ray3_free(ray3 *a) {
+  mmath_free(a, sizeof(ray3), _Alignof(ray3));
+}
+
+ray3 *ray3_clone(const ray3 *a) {
+  ray3 *out = mmath_alloc(sizeof(ray3), _Alignof(ray3));
+  return ray3_copy(out, a);
+}
+
+ray3 *ray3_from_values(const vec3 *origin, const vec3 *direction) {
+  ray3 *out = mmath_alloc(sizeof(ray3), _Alignof(ray3));
+  return ray3_set(out, origin, direction);
+}
+
+ray3 *ray3_copy(ray3 *out, const ray3 *a) {
+  vec3_copy(&out->origin, &a->origin);
+  vec3_copy(&out->direction, &a->direction);
+  return out;
+}
+
+ray3 *ray3_set(ray3 *out, const vec3 *origin, const vec3 *direction) {
+  vec3_copy(&out->origin, origin);
+  vec3_copy(&out->direction, direction);
+  return out;
+}
+
+vec3 *ray3_at(vec3 *out, const ray3 *a, float t) {
+  return vec3_scale_and_add(out, &a->origin, &a->direction, t);
+}
+
+// Moller-Trumbore with the edges leaving vertex. A zero determinant is not checked for: its
+// infinite or NaN inverse fails one of the range tests. The packet versions below follow the
+// same steps lane by lane.
+static bool ray3_intersect_edges(
+  const ray3 *r,
+  const vec3 *vertex,
+  const vec3 *edge1,
+  const vec3 *edge2,
+  float *t,
+  vec2 *uv
+) {
+  vec3 p, s, q;
+  float inverse, u, v, distance;
+
+  vec3_cross(&p, &r->direction, edge2);
+  inverse = 1.f / vec3_dot(edge1, &p);
+
+  vec3_subtract(&s, &r->origin, vertex);
+  u = vec3_dot(&s, &p) * inverse;
+  vec3_cross(&q, &s, edge1);
+  v = vec3_dot(&r->direction, &q) * inverse;
+  distance = vec3_dot(edge2, &q) * inverse;
+
+  if (!(u >= 0.f && v >= 0.f && u + v <= 1.f && distance >= 0.f && distance <= *t)) {
+    return false;
+  }
+  *t = distance;
+  if (uv != NULL) {
+    vec2_set(uv, u, v);
+  }
+  return true;
+}
+
+bool ray3_intersect_triangle(
+  const ray3 *r,
+  const vec3 *a,
+  const vec3 *b,
+  const vec3 *c,
+  float *t,
+  vec2 *uv
+) {
+  vec3 edge1, edge2;
+
+  vec3_subtract(&edge1, b, a);
+  vec3_subtract(&edge2, c, a);
+  return ray3_intersect_edges(r, a, &edge1, &edge2, t, uv);
+}
+
+ray3_packet *ray3_packet_set(ray3_packet *out, size_t lane, const ray3 *r) {
+  int k;
+
+  for (k = 0; k < 3; ++k) {
+    out->origin[k][lane] = r->origin.data[k];
+    out->direction[k][lane] = r->direction.data[k];
+  }
+  return out;
+}
+
+ray3_triangle_packet *ray3_triangle_packet_set(
+  ray3_triangle_packet *out,
+  size_t lane,
+  const vec3 *a,
+  const vec3 *b,
+  const vec3 *c
+) {
+  int k;
+
+  for (k = 0; k < 3; ++k) {
+    out->vertex[k][lane] = a->data[k];
+    out->edge1[k][lane] = b->data[k] - a->data[k];
+    out->edge2[k][lane] = c->data[k] - a->data[k];
+  }
+  return out;
+}
+
+#if defined(MMATH_SSE2)
+
+static inline void ray3_cross4(__m128 *out, const __m128 *a, const __m128 *b) {
+  out[0] = _mm_sub_ps(_mm_mul_ps(a[1], b[2]), _mm_mul_ps(a[2], b[1]));
+  out[1] = _mm_sub_ps(_mm_mul_ps(a[2], b[0]), _mm_mul_ps(a[0], b[2]));
+  out[2] = _mm_sub_ps(_mm_mul_ps(a[0], b[1]), _mm_mul_ps(a[1], b[0]));
+}
+
+static inline __m128 ray3_dot4(const __m128 *a, const __m128 *b) {
+  return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_mul_ps(a[2], b[2]));
+}
+
+// Moller-Trumbore over 4 lanes of rays and triangles. Returns the hit mask and the t, u and v
+// of every lane.
+static inline __m128 ray3_intersect4(
+  __m128 *t,
+  __m128 *u,
+  __m128 *v,
+  const __m128 *origin,
+  const __m128 *direction,
+  const __m128 *vertex,
+  const __m128 *edge1,
+  const __m128 *edge2,
+  __m128 t_max
+) {
+  const __m128 zero = _mm_setzero_ps();
+  __m128 p[3], s[3], q[3], inverse, hit;
+  int k;
+
+  ray3_cross4(p, direction, edge2);
+  inverse = _mm_div_ps(_mm_set1_ps(1.f), ray3_dot4(edge1, p));
+
+  for (k = 0; k < 3; ++k) {
+    s[k] = _mm_sub_ps(origin[k], vertex[k]);
+  }
+  *u = _mm_mul_ps(ray3_dot4(s, p), inverse);
+  ray3_cross4(q, s, edge1);
+  *v = _mm_mul_ps(ray3_dot4(direction, q), inverse);
+  *t = _mm_mul_ps(ray3_dot4(edge2, q), inverse);
+
+  hit = _mm_and_ps(_mm_cmpge_ps(*u, zero), _mm_cmpge_ps(*v, zero));
+  hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(*u, *v), _mm_set1_ps(1.f)));
+  hit = _mm_and_ps(hit, _mm_cmpge_ps(*t, zero));
+  return _mm_and_ps(hit, _mm_cmple_ps(*t, t_max));
+}
+
+static inline __m128 ray3_select4(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+#endif
+
+// Rays [lane, lane + 4) of the packet against one triangle
+static uint32_t ray3_packet_intersect_triangle4(
+  ray3_packet_hit *hit,
+  const ray3_packet *rays,
+  size_t lane,
+  uint32_t lanes,
+  const vec3 *a,
+  const vec3 *b,
+  const vec3 *c
+) {
+#if defined(MMATH_SSE2)
+  __m128 origin[3], direction[3], vertex[3], edge1[3], edge2[3], t, u, v, t_max, mask;
+  uint32_t result;
+  int k;
+
+  for (k = 0; k < 3; ++k) {
+    origin[k] = _mm_load_ps(&rays->origin[k][lane]);
+    direction[k] = _mm_load_ps(&rays->direction[k][lane]);
+    vertex[k] = _mm_set1_ps(a->data[k]);
+    edge1[k] = _mm_set1_ps(b->data[k] - a->data[k]);
+    edge2[k] = _mm_set1_ps(c->data[k] - a->data[k]);
+  }
+
+  t_max = _mm_load_ps(&hit->t[lane]);
+  mask = ray3_intersect4(&t, &u, &v, origin, direction, vertex, edge1, edge2, t_max);
+  result = (uint32_t) _mm_movemask_ps(mask) & lanes;
+  if (result == 0) {
+    return 0;
+  }
+
+  // Lanes past count may hit on whatever they hold, only the requested ones are written
+  mask = _mm_and_ps(mask, _mm_castsi128_ps(_mm_set_epi32(
+    -(int) ((lanes >> 3) & 1), -(int) ((lanes >> 2) & 1), -(int) ((lanes >> 1) & 1), -(int) (lanes & 1)
+  )));
+  _mm_store_ps(&hit->t[lane], ray3_select4(mask, t, t_max));
+  _mm_store_ps(&hit->u[lane], ray3_select4(mask, u, _mm_load_ps(&hit->u[lane])));
+  _mm_store_ps(&hit->v[lane], ray3_select4(mask, v, _mm_load_ps(&hit->v[lane])));
+  return result;
+#else
+  uint32_t result = 0;
+  size_t i;
+
+  for (i = 0; i < 4; ++i) {
+    ray3 r = { {
+      rays->origin[0][lane + i], rays->origin[1][lane + i], rays->origin[2][lane + i],
+      rays->direction[0][lane + i], rays->direction[1][lane + i], rays->direction[2][lane + i]
+    } };
+    vec2 uv;
+
+    if (((lanes >> i) & 1) != 0 && ray3_intersect_triangle(&r, a, b, c, &hit->t[lane + i], &uv)) {
+      hit->u[lane + i] = uv.x;
+      hit->v[lane + i] = uv.y;
+      result |= (uint32_t) 1 << i;
+    }
+  }
+  return result;
+#endif
+}
+
+uint32_t ray3_packet_intersect_triangle(
+  ray3_packet_hit *hit,
+  const ray3_packet *rays,
+  size_t count,
+  const vec3 *a,
+  const vec3 *b,
+  const vec3 *c
+) {
+  uint32_t lanes = ((uint32_t) 1 << count) - 1;
+
+  if (count <= 4) {
+    return ray3_packet_intersect_triangle4(hit, rays, 0, lanes, a, b, c);
+  }
+  return ray3_packet_intersect_triangle4(hit, rays, 0, 15, a, b, c)
+    | ray3_packet_intersect_triangle4(hit, rays, 4, lanes >> 4, a, b, c) << 4;
+}
+
+// Closest hit among triangles [lane, lane + 4) with t in [0, *t], returns its lane or -1
+static int ray3_intersect_triangle_packet4(
+  const ray3 *r,
+  const ray3_triangle_packet *triangles,
+  size_t lane,
+  uint32_t lanes,
+  float *t,
+  vec2 *uv
+) {
+#if defined(MMATH_SSE2)
+  __m128 origin[3], direction[3], vertex[3], edge1[3], edge2[3], distance, u, v, mask, closest;
+  float ts[4], us[4], vs[4];
+  uint32_t hits;
+  int k;
+
+  for (k = 0; k < 3; ++k) {
+    origin[k] = _mm_set1_ps(r->origin.data[k]);
+    direction[k] = _mm_set1_ps(r->direction.data[k]);
+    vertex[k] = _mm_load_ps(&triangles->vertex[k][lane]);
+    edge1[k] = _mm_load_ps(&triangles->edge1[k][lane]);
+    edge2[k] = _mm_load_ps(&triangles->edge2[k][lane]);
+  }
+
+  mask = ray3_intersect4(&distance, &u, &v, origin, direction, vertex, edge1, edge2, _mm_set1_ps(*t));
+  hits = (uint32_t) _mm_movemask_ps(mask) & lanes;
+  if (hits == 0) {
+    return -1;
+  }
+
+  // Misses become +inf, the lowest set lane of the minimum is the closest hit
+  _mm_store_ps(ts, distance);
+  for (k = 0; k < 4; ++k) {
+    ts[k] = ((hits >> k) & 1) != 0 ? ts[k] : INFINITY;
+  }
+  distance = _mm_load_ps(ts);
+  closest = _mm_min_ps(distance, _mm_shuffle_ps(distance, distance, _MM_SHUFFLE(2, 3, 0, 1)));
+  closest = _mm_min_ps(closest, _mm_shuffle_ps(closest, closest, _MM_SHUFFLE(1, 0, 3, 2)));
+  hits &= (uint32_t) _mm_movemask_ps(_mm_cmpeq_ps(distance, closest));
+  for (k = 0; ((hits >> k) & 1) == 0; ++k) {
+  }
+
+  _mm_store_ps(us, u);
+  _mm_store_ps(vs, v);
+  *t = ts[k];
+  if (uv != NULL) {
+    vec2_set(uv, us[k], vs[k]);
+  }
+  return k;
+#else
+  int k, result = -1;
+
+  // Backwards, so equally close hits go to the lowest lane as in the SIMD version
+  for (k = 3; k >= 0; --k) {
+    vec3 vertex, edge1, edge2;
+    int i;
+
+    if (((lanes >> k) & 1) == 0) {
+      continue;
+    }
+    for (i = 0; i < 3; ++i) {
+      vertex.data[i] = triangles->vertex[i][lane + k];
+      edge1.data[i] = triangles->edge1[i][lane + k];
+      edge2.data[i] = triangles->edge2[i][lane + k];
+    }
+    if (ray3_intersect_edges(r, &vertex, &edge1, &edge2, t, uv)) {
+      result = k;
+    }
+  }
+  return result;
+#endif
+}
+
+int ray3_intersect_triangle_packet(
+  const ray3 *r,
+  const ray3_triangle_packet *triangles,
+  size_t count,
+  float *t,
+  vec2 *uv
+) {
+  uint32_t lanes = ((uint32_t) 1 << count) - 1;
+  int first, second;
+
+  if (count <= 4) {
+    return ray3_intersect_triangle_packet4(r, triangles, 0, lanes, t, uv);
+  }
+  // The upper half goes first, so the lower one takes over equally close hits
+  second = ray3_intersect_triangle_packet4(r, triangles, 4, lanes >> 4, t, uv);
+  first = ray3_intersect_triangle_packet4(r, triangles, 0, 15, t, uv);
+  return first >= 0 ? first : second >= 0 ? second + 4 : -1;
+}
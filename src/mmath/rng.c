@@ -0,0 +1,136 @@
+#include "mmath/rng.h"
+#include "mmath_private.h"
+
+#include <stdatomic.h>
+
+static MMATH_THREAD_LOCAL mmath_rng mmath_rng_current;
+static atomic_uint_fast64_t mmath_rng_threads;
+
+static uint64_t rng_splitmix64(uint64_t *x) {
+  uint64_t z = (*x += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+static inline uint32_t rng_rotl(uint32_t x, int k) {
+  return (x << k) | (x >> (32 - k));
+}
+
+// 24 random bits scaled into [0, 1)
+static inline float rng_to_float(uint32_t x) {
+  return (float) (x >> 8) * (1.f / 16777216.f);
+}
+
+mmath_rng *mmath_rng_create(uint64_t seed) {
+  mmath_rng *out = mmath_alloc(sizeof(mmath_rng), _Alignof(mmath_rng));
+  return mmath_rng_seed(out, seed);
+}
+
+void mmath_rng_free(mmath_rng *rng) {
+  mmath_free(rng, sizeof(mmath_rng), _Alignof(mmath_rng));
+}
+
+mmath_rng *mmath_rng_seed(mmath_rng *rng, uint64_t seed) {
+  uint64_t a = rng_splitmix64(&seed);
+  uint64_t b = rng_splitmix64(&seed);
+
+  rng->s[0] = (uint32_t) a;
+  rng->s[1] = (uint32_t) (a >> 32);
+  rng->s[2] = (uint32_t) b;
+  rng->s[3] = (uint32_t) (b >> 32);
+
+  // splitmix64 never yields two zero outputs in a row, this is only a safeguard
+  if ((rng->s[0] | rng->s[1] | rng->s[2] | rng->s[3]) == 0) {
+    rng->s[0] = 1;
+  }
+  return rng;
+}
+
+mmath_rng *mmath_rng_thread() {
+  mmath_rng *rng = &mmath_rng_current;
+
+  // An all-zero state is invalid for xoshiro, so it marks a thread that has not seeded yet.
+  // Every thread takes the next value of a shared counter, so even threads that reuse the
+  // storage of a finished one get their own sequence.
+  if ((rng->s[0] | rng->s[1] | rng->s[2] | rng->s[3]) == 0) {
+    uint64_t index = atomic_fetch_add(&mmath_rng_threads, 1);
+    mmath_rng_seed(rng, index ^ (uint64_t) (uintptr_t) rng);
+  }
+  return rng;
+}
+
+void mmath_random_seed(uint64_t seed) {
+  mmath_rng_seed(&mmath_rng_current, seed);
+}
+
+uint32_t mmath_rng_next(mmath_rng *rng) {
+  uint32_t *s = rng->s;
+  uint32_t result = rng_rotl(s[1] * 5, 7) * 9;
+  uint32_t t = s[1] << 9;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rng_rotl(s[3], 11);
+
+  return result;
+}
+
+float mmath_rng_float(mmath_rng *rng) {
+  return rng_to_float(mmath_rng_next(rng));
+}
+
+void mmath_rng_fill_float(mmath_rng *rng, float *out, size_t count) {
+  mmath_rng state = *rng;
+  size_t i;
+
+  // Working on a local copy lets the compiler keep the state in registers
+  for (i = 0; i < count; ++i) {
+    out[i] = rng_to_float(mmath_rng_next(&state));
+  }
+  *rng = state;
+}
+
+void mmath_rng_fill_unit_vec3(mmath_rng *rng, vec3 *out, size_t count) {
+  mmath_rng state = *rng;
+  size_t i;
+
+  for (i = 0; i < count; ++i) {
+    float r = rng_to_float(mmath_rng_next(&state)) * 2.f * (float) M_PI;
+    float z = rng_to_float(mmath_rng_next(&state)) * 2.f - 1.f;
+    float z_scale = sqrtf(1.f - z * z);
+    float s, c;
+    mmath_sincosf(r, &s, &c);
+
+    out[i].x = c * z_scale;
+    out[i].y = s * z_scale;
+    out[i].z = z;
+  }
+  *rng = state;
+}
+
+void mmath_rng_fill_unit_quat(mmath_rng *rng, quat *out, size_t count) {
+  mmath_rng state = *rng;
+  size_t i;
+
+  // Same construction as quat_random
+  for (i = 0; i < count; ++i) {
+    float u1 = rng_to_float(mmath_rng_next(&state));
+    float u2 = rng_to_float(mmath_rng_next(&state)) * 2.f * (float) M_PI;
+    float u3 = rng_to_float(mmath_rng_next(&state)) * 2.f * (float) M_PI;
+    float sqrt1MinusU1 = sqrtf(1.f - u1);
+    float sqrtU1 = sqrtf(u1);
+    float s2, c2, s3, c3;
+    mmath_sincosf(u2, &s2, &c2);
+    mmath_sincosf(u3, &s3, &c3);
+
+    out[i].x = sqrt1MinusU1 * s2;
+    out[i].y = sqrt1MinusU1 * c2;
+    out[i].z = sqrtU1 * s3;
+    out[i].w = sqrtU1 * c3;
+  }
+  *rng = state;
+}
@@ -0,0 +1,250 @@
+#include "mmath/skin.h"
+#include "mmath_private.h"
+
+#define MMATH_SKIN_DQS_MAX_INFLUENCES 4
+#define MMATH_SKIN_LBS_MAX_INFLUENCES 8
+
+void mmath_skin_dqs(const mmath_skin_desc *desc, const quat2 *bones) {
+  const unsigned char *positions = (const unsigned char *) desc->positions;
+  const unsigned char *normals = (const unsigned char *) desc->normals;
+  const unsigned char *tangents = (const unsigned char *) desc->tangents;
+  unsigned char *out_positions = (unsigned char *) desc->out_positions;
+  unsigned char *out_normals = (unsigned char *) desc->out_normals;
+  unsigned char *out_tangents = (unsigned char *) desc->out_tangents;
+  const uint16_t *joints = desc->joints;
+  const float *weights = desc->weights;
+  size_t influences = desc->influences;
+  size_t i, k;
+
+  if (influences > MMATH_SKIN_DQS_MAX_INFLUENCES) {
+    influences = MMATH_SKIN_DQS_MAX_INFLUENCES;
+  }
+  if (influences == 0) {
+    return;
+  }
+
+  for (i = 0; i < desc->count; ++i) {
+    const quat2 *pivot = &bones[joints[0]];
+    float b[8] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+
+    for (k = 0; k < influences; ++k) {
+      const quat2 *bone = &bones[joints[k]];
+      float w = weights[k];
+      int j;
+
+      // Keep every bone on the same hemisphere as the first one so the blend takes the short path
+      if (quat2_dot(pivot, bone) < 0.f) {
+        w = -w;
+      }
+      for (j = 0; j < 8; ++j) {
+        b[j] += bone->data[j] * w;
+      }
+    }
+
+    float len = b[0] * b[0] + b[1] * b[1] + b[2] * b[2] + b[3] * b[3];
+    len = len > 0.f ? 1.f / sqrtf(len) : 0.f;
+
+    float rx = b[0] * len, ry = b[1] * len, rz = b[2] * len, rw = b[3] * len;
+    float dx = b[4] * len, dy = b[5] * len, dz = b[6] * len, dw = b[7] * len;
+
+    // Translation is 2 * dual * conj(real)
+    float tx = 2.f * (rw * dx - dw * rx + ry * dz - rz * dy);
+    float ty = 2.f * (rw * dy - dw * ry + rz * dx - rx * dz);
+    float tz = 2.f * (rw * dz - dw * rz + rx * dy - ry * dx);
+
+    // v' = v + 2 * r x (r x v + w * v)
+    const vec3 *p = (const vec3 *) positions;
+    float px = p->x, py = p->y, pz = p->z;
+    float cx = ry * pz - rz * py + rw * px;
+    float cy = rz * px - rx * pz + rw * py;
+    float cz = rx * py - ry * px + rw * pz;
+
+    vec3 *op = (vec3 *) out_positions;
+    op->x = px + 2.f * (ry * cz - rz * cy) + tx;
+    op->y = py + 2.f * (rz * cx - rx * cz) + ty;
+    op->z = pz + 2.f * (rx * cy - ry * cx) + tz;
+
+    if (normals != NULL) {
+      const vec3 *n = (const vec3 *) normals;
+      float nx = n->x, ny = n->y, nz = n->z;
+      cx = ry * nz - rz * ny + rw * nx;
+      cy = rz * nx - rx * nz + rw * ny;
+      cz = rx * ny - ry * nx + rw * nz;
+
+      vec3 *on = (vec3 *) out_normals;
+      on->x = nx + 2.f * (ry * cz - rz * cy);
+      on->y = ny + 2.f * (rz * cx - rx * cz);
+      on->z = nz + 2.f * (rx * cy - ry * cx);
+
+      normals += desc->normal_stride;
+      out_normals += desc->out_normal_stride;
+    }
+
+    if (tangents != NULL) {
+      const vec4 *t = (const vec4 *) tangents;
+      float sx = t->x, sy = t->y, sz = t->z;
+      cx = ry * sz - rz * sy + rw * sx;
+      cy = rz * sx - rx * sz + rw * sy;
+      cz = rx * sy - ry * sx + rw * sz;
+
+      vec4 *ot = (vec4 *) out_tangents;
+      ot->x = sx + 2.f * (ry * cz - rz * cy);
+      ot->y = sy + 2.f * (rz * cx - rx * cz);
+      ot->z = sz + 2.f * (rx * cy - ry * cx);
+      ot->w = t->w;
+
+      tangents += desc->tangent_stride;
+      out_tangents += desc->out_tangent_stride;
+    }
+
+    positions += desc->position_stride;
+    out_positions += desc->out_position_stride;
+    joints += desc->influences;
+    weights += desc->influences;
+  }
+}
+
+// Weighted sum of the bone matrices of one vertex, only the affine part is accumulated
+#if defined(MMATH_SSE2)
+
+typedef struct skin_matrix {
+  __m128 c[4];
+} skin_matrix;
+
+static inline void skin_lbs_blend(skin_matrix *m, const mat4 *palette, const uint16_t *joints, const float *weights, size_t influences) {
+  const mat4 *bone = &palette[joints[0]];
+  __m128 w = _mm_set1_ps(weights[0]);
+  size_t k;
+
+  m->c[0] = _mm_mul_ps(_mm_loadu_ps(&bone->data[0]), w);
+  m->c[1] = _mm_mul_ps(_mm_loadu_ps(&bone->data[4]), w);
+  m->c[2] = _mm_mul_ps(_mm_loadu_ps(&bone->data[8]), w);
+  m->c[3] = _mm_mul_ps(_mm_loadu_ps(&bone->data[12]), w);
+
+  for (k = 1; k < influences; ++k) {
+    if (weights[k] == 0.f) {
+      continue;
+    }
+    bone = &palette[joints[k]];
+    w = _mm_set1_ps(weights[k]);
+    m->c[0] = _mm_add_ps(m->c[0], _mm_mul_ps(_mm_loadu_ps(&bone->data[0]), w));
+    m->c[1] = _mm_add_ps(m->c[1], _mm_mul_ps(_mm_loadu_ps(&bone->data[4]), w));
+    m->c[2] = _mm_add_ps(m->c[2], _mm_mul_ps(_mm_loadu_ps(&bone->data[8]), w));
+    m->c[3] = _mm_add_ps(m->c[3], _mm_mul_ps(_mm_loadu_ps(&bone->data[12]), w));
+  }
+}
+
+// out = m * (x, y, z, 1) when point is set, m * (x, y, z, 0) otherwise
+static inline void skin_lbs_apply(float *out, const skin_matrix *m, float x, float y, float z, int point) {
+  float r[4];
+  __m128 v = _mm_add_ps(
+    _mm_add_ps(_mm_mul_ps(m->c[0], _mm_set1_ps(x)), _mm_mul_ps(m->c[1], _mm_set1_ps(y))),
+    _mm_mul_ps(m->c[2], _mm_set1_ps(z))
+  );
+  if (point) {
+    v = _mm_add_ps(v, m->c[3]);
+  }
+  _mm_storeu_ps(r, v);
+  out[0] = r[0];
+  out[1] = r[1];
+  out[2] = r[2];
+}
+
+#else
+
+typedef struct skin_matrix {
+  float c[4][4];
+} skin_matrix;
+
+static inline void skin_lbs_blend(skin_matrix *m, const mat4 *palette, const uint16_t *joints, const float *weights, size_t influences) {
+  size_t k;
+  int j;
+
+  for (j = 0; j < 16; ++j) {
+    m->c[j >> 2][j & 3] = palette[joints[0]].data[j] * weights[0];
+  }
+  for (k = 1; k < influences; ++k) {
+    const mat4 *bone = &palette[joints[k]];
+    float w = weights[k];
+    if (w == 0.f) {
+      continue;
+    }
+    for (j = 0; j < 16; ++j) {
+      m->c[j >> 2][j & 3] += bone->data[j] * w;
+    }
+  }
+}
+
+static inline void skin_lbs_apply(float *out, const skin_matrix *m, float x, float y, float z, int point) {
+  int j;
+  for (j = 0; j < 3; ++j) {
+    out[j] = m->c[0][j] * x + m->c[1][j] * y + m->c[2][j] * z + (point ? m->c[3][j] : 0.f);
+  }
+}
+
+#endif
+
+static inline void skin_normalize3(float *v) {
+  float len = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+  if (len > 0.f) {
+    len = 1.f / sqrtf(len);
+    v[0] *= len;
+    v[1] *= len;
+    v[2] *= len;
+  }
+}
+
+void mmath_skin_lbs(const mmath_skin_desc *desc, const mat4 *palette) {
+  const unsigned char *positions = (const unsigned char *) desc->positions;
+  const unsigned char *normals = (const unsigned char *) desc->normals;
+  const unsigned char *tangents = (const unsigned char *) desc->tangents;
+  unsigned char *out_positions = (unsigned char *) desc->out_positions;
+  unsigned char *out_normals = (unsigned char *) desc->out_normals;
+  unsigned char *out_tangents = (unsigned char *) desc->out_tangents;
+  const uint16_t *joints = desc->joints;
+  const float *weights = desc->weights;
+  size_t influences = desc->influences;
+  skin_matrix m;
+  size_t i;
+
+  if (influences > MMATH_SKIN_LBS_MAX_INFLUENCES) {
+    influences = MMATH_SKIN_LBS_MAX_INFLUENCES;
+  }
+  if (influences == 0) {
+    return;
+  }
+
+  for (i = 0; i < desc->count; ++i) {
+    skin_lbs_blend(&m, palette, joints, weights, influences);
+
+    const vec3 *p = (const vec3 *) positions;
+    skin_lbs_apply(((vec3 *) out_positions)->data, &m, p->x, p->y, p->z, 1);
+
+    if (normals != NULL) {
+      const vec3 *n = (const vec3 *) normals;
+      vec3 *on = (vec3 *) out_normals;
+      skin_lbs_apply(on->data, &m, n->x, n->y, n->z, 0);
+      skin_normalize3(on->data);
+
+      normals += desc->normal_stride;
+      out_normals += desc->out_normal_stride;
+    }
+
+    if (tangents != NULL) {
+      const vec4 *t = (const vec4 *) tangents;
+      vec4 *ot = (vec4 *) out_tangents;
+      float sign = t->w;
+      skin_lbs_apply(ot->data, &m, t->x, t->y, t->z, 0);
+      skin_normalize3(ot->data);
+      ot->w = sign;
+
+      tangents += desc->tangent_stride;
+      out_tangents += desc->out_tangent_stride;
+    }
+
+    positions += desc->position_stride;
+    out_positions += desc->out_position_stride;
+    joints += desc->influences;
+    weights += desc->influences;
+  }
+}
@@ -0,0 +1,568 @@
+#include "mmath/soa.h"
+#include "mmath_private.h"
+
+#define MMATH_SOA_ALIGN 32
+// Floats per MMATH_SOA_ALIGN bytes, arrays are padded to a multiple of it
+#define MMATH_SOA_PAD 8
+
+static size_t soa_padded(size_t count) {
+  return (count + MMATH_SOA_PAD - 1) & ~(size_t) (MMATH_SOA_PAD - 1);
+}
+
+// All component arrays share one allocation that starts at data[0]
+static bool soa_alloc(float **data, size_t components, size_t count) {
+  size_t padded = soa_padded(count);
+  size_t size = (padded != 0 ? padded : MMATH_SOA_PAD) * components * sizeof(float);
+  float *block = (float *) mmath_alloc_global(size, MMATH_SOA_ALIGN);
+  size_t c;
+
+  if (block == NULL) {
+    return false;
+  }
+  memset(block, 0, size);
+  for (c = 0; c < components; ++c) {
+    data[c] = block + c * padded;
+  }
+  return true;
+}
+
+static void soa_free(float **data, size_t components, size_t count) {
+  size_t padded = soa_padded(count);
+  mmath_free_global(data[0], (padded != 0 ? padded : MMATH_SOA_PAD) * components * sizeof(float), MMATH_SOA_ALIGN);
+}
+
+#define SOA_CREATE(type, components) \
+  type *type##_create(size_t count) { \
+    type *a = (type *) mmath_alloc_global(sizeof(type), _Alignof(type)); \
+    if (a == NULL) { \
+      return NULL; \
+    } \
+    if (!soa_alloc(a->data, components, count)) { \
+      mmath_free_global(a, sizeof(type), _Alignof(type)); \
+      return NULL; \
+    } \
+    a->count = count; \
+    return a; \
+  } \
+  \
+  void type##_free(type *a) { \
+    if (a == NULL) { \
+      return; \
+    } \
+    soa_free(a->data, components, a->count); \
+    mmath_free_global(a, sizeof(type), _Alignof(type)); \
+  }
+
+SOA_CREATE(vec3_soa, 3)
+SOA_CREATE(vec4_soa, 4)
+SOA_CREATE(quat_soa, 4)
+
+#undef SOA_CREATE
+
+vec3 *vec3_soa_get(vec3 *out, const vec3_soa *a, size_t index) {
+  return vec3_set(out, a->x[index], a->y[index], a->z[index]);
+}
+
+void vec3_soa_set(vec3_soa *out, size_t index, const vec3 *a) {
+  out->x[index] = a->x;
+  out->y[index] = a->y;
+  out->z[index] = a->z;
+}
+
+vec4 *vec4_soa_get(vec4 *out, const vec4_soa *a, size_t index) {
+  return vec4_set(out, a->x[index], a->y[index], a->z[index], a->w[index]);
+}
+
+void vec4_soa_set(vec4_soa *out, size_t index, const vec4 *a) {
+  out->x[index] = a->x;
+  out->y[index] = a->y;
+  out->z[index] = a->z;
+  out->w[index] = a->w;
+}
+
+quat *quat_soa_get(quat *out, const quat_soa *a, size_t index) {
+  return quat_set(out, a->x[index], a->y[index], a->z[index], a->w[index]);
+}
+
+void quat_soa_set(quat_soa *out, size_t index, const quat *a) {
+  out->x[index] = a->x;
+  out->y[index] = a->y;
+  out->z[index] = a->z;
+  out->w[index] = a->w;
+}
+
+// Conversions
+
+static void soa_from_vec3(float *const *out, const vec3 *a, size_t count) {
+  size_t i = 0;
+
+#if defined(MMATH_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    // (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3)
+    __m128 p0 = _mm_loadu_ps(&a[i].x);
+    __m128 p1 = _mm_loadu_ps(&a[i + 1].y);
+    __m128 p2 = _mm_loadu_ps(&a[i + 2].z);
+
+    _mm_store_ps(&out[0][i], _mm_shuffle_ps(p0, _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(1, 0, 3, 2)), _MM_SHUFFLE(3, 0, 3, 0)));
+    _mm_store_ps(&out[1][i], _mm_shuffle_ps(
+      _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(0, 0, 1, 1)),
+      _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(2, 2, 3, 3)),
+      _MM_SHUFFLE(2, 0, 2, 0)
+    ));
+    _mm_store_ps(&out[2][i], _mm_shuffle_ps(
+      _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 1, 2, 2)),
+      _mm_shuffle_ps(p2, p2, _MM_SHUFFLE(3, 3, 0, 0)),
+      _MM_SHUFFLE(2, 0, 2, 0)
+    ));
+  }
+#endif
+
+  for (; i < count; ++i) {
+    out[0][i] = a[i].x;
+    out[1][i] = a[i].y;
+    out[2][i] = a[i].z;
+  }
+}
+
+static void soa_to_vec3(vec3 *out, const float *const *a, size_t count) {
+  size_t i = 0;
+
+#if defined(MMATH_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    __m128 x = _mm_load_ps(&a[0][i]);
+    __m128 y = _mm_load_ps(&a[1][i]);
+    __m128 z = _mm_load_ps(&a[2][i]);
+
+    _mm_storeu_ps(&out[i].x, _mm_shuffle_ps(
+      _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)),
+      _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+      _MM_SHUFFLE(2, 0, 2, 0)
+    ));
+    _mm_storeu_ps(&out[i + 1].y, _mm_shuffle_ps(
+      _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+      _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+      _MM_SHUFFLE(2, 0, 2, 0)
+    ));
+    _mm_storeu_ps(&out[i + 2].z, _mm_shuffle_ps(
+      _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+      _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+      _MM_SHUFFLE(2, 0, 2, 0)
+    ));
+  }
+#endif
+
+  for (; i < count; ++i) {
+    out[i].x = a[0][i];
+    out[i].y = a[1][i];
+    out[i].z = a[2][i];
+  }
+}
+
+// vec4 and quat share the layout of four packed floats
+static void soa_from_float4(float *const *out, const float *a, size_t count) {
+  size_t i = 0;
+
+#if defined(MMATH_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    __m128 r0 = _mm_loadu_ps(&a[4 * i]);
+    __m128 r1 = _mm_loadu_ps(&a[4 * i + 4]);
+    __m128 r2 = _mm_loadu_ps(&a[4 * i + 8]);
+    __m128 r3 = _mm_loadu_ps(&a[4 * i + 12]);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_store_ps(&out[0][i], r0);
+    _mm_store_ps(&out[1][i], r1);
+    _mm_store_ps(&out[2][i], r2);
+    _mm_store_ps(&out[3][i], r3);
+  }
+#endif
+
+  for (; i < count; ++i) {
+    out[0][i] = a[4 * i];
+    out[1][i] = a[4 * i + 1];
+    out[2][i] = a[4 * i + 2];
+    out[3][i] = a[4 * i + 3];
+  }
+}
+
+static void soa_to_float4(float *out, const float *const *a, size_t count) {
+  size_t i = 0;
+
+#if defined(MMATH_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    __m128 r0 = _mm_load_ps(&a[0][i]);
+    __m128 r1 = _mm_load_ps(&a[1][i]);
+    __m128 r2 = _mm_load_ps(&a[2][i]);
+    __m128 r3 = _mm_load_ps(&a[3][i]);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(&out[4 * i], r0);
+    _mm_storeu_ps(&out[4 * i + 4], r1);
+    _mm_storeu_ps(&out[4 * i + 8], r2);
+    _mm_storeu_ps(&out[4 * i + 12], r3);
+  }
+#endif
+
+  for (; i < count; ++i) {
+    out[4 * i] = a[0][i];
+    out[4 * i + 1] = a[1][i];
+    out[4 * i + 2] = a[2][i];
+    out[4 * i + 3] = a[3][i];
+  }
+}
+
+vec3_soa *vec3_soa_from_vec3(vec3_soa *out, const vec3 *a) {
+  soa_from_vec3(out->data, a, out->count);
+  return out;
+}
+
+vec3 *vec3_soa_to_vec3(vec3 *out, const vec3_soa *a) {
+  soa_to_vec3(out, (const float *const *) a->data, a->count);
+  return out;
+}
+
+vec4_soa *vec4_soa_from_vec4(vec4_soa *out, const vec4 *a) {
+  soa_from_float4(out->data, a->data, out->count);
+  return out;
+}
+
+vec4 *vec4_soa_to_vec4(vec4 *out, const vec4_soa *a) {
+  soa_to_float4(out->data, (const float *const *) a->data, a->count);
+  return out;
+}
+
+quat_soa *quat_soa_from_quat(quat_soa *out, const quat *a) {
+  soa_from_float4(out->data, a->data, out->count);
+  return out;
+}
+
+quat *quat_soa_to_quat(quat *out, const quat_soa *a) {
+  soa_to_float4(out->data, (const float *const *) a->data, a->count);
+  return out;
+}
+
+// Component-wise kernels, shared by every stream type
+
+// out = a + b * scale, which is exactly a + b for a scale of 1
+static void soa_scale_and_add(
+  float *const *out,
+  const float *const *a,
+  const float *const *b,
+  float scale,
+  size_t components,
+  size_t count
+) {
+  size_t c, i;
+
+  for (c = 0; c < components; ++c) {
+    const float *ac = a[c], *bc = b[c];
+    float *oc = out[c];
+    i = 0;
+#if defined(MMATH_SSE2)
+    {
+      __m128 s = _mm_set1_ps(scale);
+      for (; i + 4 <= count; i += 4) {
+        _mm_store_ps(&oc[i], _mm_add_ps(_mm_load_ps(&ac[i]), _mm_mul_ps(_mm_load_ps(&bc[i]), s)));
+      }
+    }
+#endif
+    for (; i < count; ++i) {
+      oc[i] = ac[i] + (bc[i] * scale);
+    }
+  }
+}
+
+static void soa_lerp(
+  float *const *out,
+  const float *const *a,
+  const float *const *b,
+  float t,
+  size_t components,
+  size_t count
+) {
+  size_t c, i;
+
+  for (c = 0; c < components; ++c) {
+    const float *ac = a[c], *bc = b[c];
+    float *oc = out[c];
+    i = 0;
+#if defined(MMATH_SSE2)
+    {
+      __m128 tv = _mm_set1_ps(t);
+      for (; i + 4 <= count; i += 4) {
+        __m128 av = _mm_load_ps(&ac[i]);
+        _mm_store_ps(&oc[i], _mm_add_ps(av, _mm_mul_ps(tv, _mm_sub_ps(_mm_load_ps(&bc[i]), av))));
+      }
+    }
+#endif
+    for (; i < count; ++i) {
+      oc[i] = ac[i] + t * (bc[i] - ac[i]);
+    }
+  }
+}
+
+static void soa_dot(float *out, const float *const *a, const float *const *b, size_t components, size_t count) {
+  size_t c, i = 0;
+
+#if defined(MMATH_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    __m128 r = _mm_mul_ps(_mm_load_ps(&a[0][i]), _mm_load_ps(&b[0][i]));
+    for (c = 1; c < components; ++c) {
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(&a[c][i]), _mm_load_ps(&b[c][i])));
+    }
+    _mm_storeu_ps(&out[i], r);
+  }
+#endif
+
+  for (; i < count; ++i) {
+    float r = a[0][i] * b[0][i];
+    for (c = 1; c < components; ++c) {
+      r += a[c][i] * b[c][i];
+    }
+    out[i] = r;
+  }
+}
+
+// Zero-length elements stay zero, like vec3_normalize
+static void soa_normalize(float *const *out, const float *const *a, size_t components, size_t count) {
+  size_t c, i = 0;
+
+#if defined(MMATH_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    __m128 v[4], len;
+    for (c = 0; c < components; ++c) {
+      v[c] = _mm_load_ps(&a[c][i]);
+    }
+    len = _mm_mul_ps(v[0], v[0]);
+    for (c = 1; c < components; ++c) {
+      len = _mm_add_ps(len, _mm_mul_ps(v[c], v[c]));
+    }
+    len = _mm_and_ps(
+      _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(len)),
+      _mm_cmpgt_ps(len, _mm_setzero_ps())
+    );
+    for (c = 0; c < components; ++c) {
+      _mm_store_ps(&out[c][i], _mm_mul_ps(v[c], len));
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    float len = 0.f;
+    for (c = 0; c < components; ++c) {
+      len += a[c][i] * a[c][i];
+    }
+    if (len > 0) {
+      len = 1.f / sqrtf(len);
+    }
+    for (c = 0; c < components; ++c) {
+      out[c][i] = a[c][i] * len;
+    }
+  }
+}
+
+#define SOA_DATA(a) ((const float *const *) (a)->data)
+
+// vec3_soa
+
+vec3_soa *vec3_soa_add(vec3_soa *out, const vec3_soa *a, const vec3_soa *b) {
+  soa_scale_and_add(out->data, SOA_DATA(a), SOA_DATA(b), 1.f, 3, a->count);
+  return out;
+}
+
+vec3_soa *vec3_soa_scale_and_add(vec3_soa *out, const vec3_soa *a, const vec3_soa *b, float scale) {
+  soa_scale_and_add(out->data, SOA_DATA(a), SOA_DATA(b), scale, 3, a->count);
+  return out;
+}
+
+float *vec3_soa_dot(float *out, const vec3_soa *a, const vec3_soa *b) {
+  soa_dot(out, SOA_DATA(a), SOA_DATA(b), 3, a->count);
+  return out;
+}
+
+vec3_soa *vec3_soa_cross(vec3_soa *out, const vec3_soa *a, const vec3_soa *b) {
+  size_t count = a->count;
+  size_t i = 0;
+
+#if defined(MMATH_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    __m128 ax = _mm_load_ps(&a->x[i]), ay = _mm_load_ps(&a->y[i]), az = _mm_load_ps(&a->z[i]);
+    __m128 bx = _mm_load_ps(&b->x[i]), by = _mm_load_ps(&b->y[i]), bz = _mm_load_ps(&b->z[i]);
+    _mm_store_ps(&out->x[i], _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+    _mm_store_ps(&out->y[i], _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)));
+    _mm_store_ps(&out->z[i], _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+  }
+#endif
+
+  for (; i < count; ++i) {
+    float ax = a->x[i], ay = a->y[i], az = a->z[i];
+    float bx = b->x[i], by = b->y[i], bz = b->z[i];
+    out->x[i] = ay * bz - az * by;
+    out->y[i] = az * bx - ax * bz;
+    out->z[i] = ax * by - ay * bx;
+  }
+
+  return out;
+}
+
+vec3_soa *vec3_soa_normalize(vec3_soa *out, const vec3_soa *a) {
+  soa_normalize(out->data, SOA_DATA(a), 3, a->count);
+  return out;
+}
+
+vec3_soa *vec3_soa_lerp(vec3_soa *out, const vec3_soa *a, const vec3_soa *b, float t) {
+  soa_lerp(out->data, SOA_DATA(a), SOA_DATA(b), t, 3, a->count);
+  return out;
+}
+
+vec3_soa *vec3_soa_transform_mat4(vec3_soa *out, const vec3_soa *a, const mat4 *m) {
+  size_t count = a->count;
+  size_t i = 0;
+
+#if defined(MMATH_SSE2)
+  {
+    const float *d = m->data;
+    __m128 m0 = _mm_set1_ps(d[0]), m1 = _mm_set1_ps(d[1]), m2 = _mm_set1_ps(d[2]), m3 = _mm_set1_ps(d[3]);
+    __m128 m4 = _mm_set1_ps(d[4]), m5 = _mm_set1_ps(d[5]), m6 = _mm_set1_ps(d[6]), m7 = _mm_set1_ps(d[7]);
+    __m128 m8 = _mm_set1_ps(d[8]), m9 = _mm_set1_ps(d[9]), m10 = _mm_set1_ps(d[10]), m11 = _mm_set1_ps(d[11]);
+    __m128 m12 = _mm_set1_ps(d[12]), m13 = _mm_set1_ps(d[13]), m14 = _mm_set1_ps(d[14]), m15 = _mm_set1_ps(d[15]);
+    __m128 one = _mm_set1_ps(1.f);
+
+    for (; i + 4 <= count; i += 4) {
+      __m128 x = _mm_load_ps(&a->x[i]), y = _mm_load_ps(&a->y[i]), z = _mm_load_ps(&a->z[i]);
+      __m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m3, x), _mm_mul_ps(m7, y)), _mm_mul_ps(m11, z)), m15);
+      __m128 zero_w = _mm_cmpeq_ps(w, _mm_setzero_ps());
+
+      // w of 0 divides by 1 instead, like vec3_transform_mat4
+      w = _mm_or_ps(_mm_andnot_ps(zero_w, w), _mm_and_ps(zero_w, one));
+      _mm_store_ps(&out->x[i], _mm_div_ps(
+        _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_mul_ps(m8, z)), m12), w
+      ));
+      _mm_store_ps(&out->y[i], _mm_div_ps(
+        _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_mul_ps(m9, z)), m13), w
+      ));
+      _mm_store_ps(&out->z[i], _mm_div_ps(
+        _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_mul_ps(m10, z)), m14), w
+      ));
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    vec3 v;
+    vec3_soa_get(&v, a, i);
+    vec3_transform_mat4(&v, &v, (mat4 *) m);
+    vec3_soa_set(out, i, &v);
+  }
+
+  return out;
+}
+
+// vec4_soa
+
+vec4_soa *vec4_soa_add(vec4_soa *out, const vec4_soa *a, const vec4_soa *b) {
+  soa_scale_and_add(out->data, SOA_DATA(a), SOA_DATA(b), 1.f, 4, a->count);
+  return out;
+}
+
+vec4_soa *vec4_soa_scale_and_add(vec4_soa *out, const vec4_soa *a, const vec4_soa *b, float scale) {
+  soa_scale_and_add(out->data, SOA_DATA(a), SOA_DATA(b), scale, 4, a->count);
+  return out;
+}
+
+float *vec4_soa_dot(float *out, const vec4_soa *a, const vec4_soa *b) {
+  soa_dot(out, SOA_DATA(a), SOA_DATA(b), 4, a->count);
+  return out;
+}
+
+vec4_soa *vec4_soa_normalize(vec4_soa *out, const vec4_soa *a) {
+  soa_normalize(out->data, SOA_DATA(a), 4, a->count);
+  return out;
+}
+
+vec4_soa *vec4_soa_lerp(vec4_soa *out, const vec4_soa *a, const vec4_soa *b, float t) {
+  soa_lerp(out->data, SOA_DATA(a), SOA_DATA(b), t, 4, a->count);
+  return out;
+}
+
+vec4_soa *vec4_soa_transform_mat4(vec4_soa *out, const vec4_soa *a, const mat4 *m) {
+  size_t count = a->count;
+  size_t i = 0;
+
+#if defined(MMATH_SSE2)
+  {
+    const float *d = m->data;
+    __m128 md[16];
+    int r;
+
+    for (r = 0; r < 16; ++r) {
+      md[r] = _mm_set1_ps(d[r]);
+    }
+    for (; i + 4 <= count; i += 4) {
+      __m128 x = _mm_load_ps(&a->x[i]), y = _mm_load_ps(&a->y[i]);
+      __m128 z = _mm_load_ps(&a->z[i]), w = _mm_load_ps(&a->w[i]);
+      for (r = 0; r < 4; ++r) {
+        _mm_store_ps(&out->data[r][i], _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(md[r], x), _mm_mul_ps(md[4 + r], y)),
+          _mm_add_ps(_mm_mul_ps(md[8 + r], z), _mm_mul_ps(md[12 + r], w))
+        ));
+      }
+    }
+  }
+#endif
+
+  for (; i < count; ++i) {
+    vec4 v;
+    vec4_soa_get(&v, a, i);
+    vec4_transform_mat4(&v, &v, (mat4 *) m);
+    vec4_soa_set(out, i, &v);
+  }
+
+  return out;
+}
+
+// quat_soa
+
+quat_soa *quat_soa_multiply(quat_soa *out, const quat_soa *a, const quat_soa *b) {
+  size_t count = a->count;
+  size_t i = 0;
+
+#if defined(MMATH_SSE2)
+  for (; i + 4 <= count; i += 4) {
+    __m128 ax = _mm_load_ps(&a->x[i]), ay = _mm_load_ps(&a->y[i]);
+    __m128 az = _mm_load_ps(&a->z[i]), aw = _mm_load_ps(&a->w[i]);
+    __m128 bx = _mm_load_ps(&b->x[i]), by = _mm_load_ps(&b->y[i]);
+    __m128 bz = _mm_load_ps(&b->z[i]), bw = _mm_load_ps(&b->w[i]);
+
+    _mm_store_ps(&out->x[i], _mm_sub_ps(
+      _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bw), _mm_mul_ps(aw, bx)), _mm_mul_ps(ay, bz)),
+      _mm_mul_ps(az, by)
+    ));
+    _mm_store_ps(&out->y[i], _mm_sub_ps(
+      _mm_add_ps(_mm_add_ps(_mm_mul_ps(ay, bw), _mm_mul_ps(aw, by)), _mm_mul_ps(az, bx)),
+      _mm_mul_ps(ax, bz)
+    ));
+    _mm_store_ps(&out->z[i], _mm_sub_ps(
+      _mm_add_ps(_mm_add_ps(_mm_mul_ps(az, bw), _mm_mul_ps(aw, bz)), _mm_mul_ps(ax, by)),
+      _mm_mul_ps(ay, bx)
+    ));
+    _mm_store_ps(&out->w[i], _mm_sub_ps(
+      _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)),
+      _mm_mul_ps(az, bz)
+    ));
+  }
+#endif
+
+  for (; i < count; ++i) {
+    quat qa, qb;
+    quat_soa_get(&qa, a, i);
+    quat_soa_get(&qb, b, i);
+    quat_multiply(&qa, &qa, &qb);
+    quat_soa_set(out, i, &qa);
+  }
+
+  return out;
+}
+
+quat_soa *quat_soa_normalize(quat_soa *out, const quat_soa *a) {
+  soa_normalize(out->data, SOA_DATA(a), 4, a->count);
+  return out;
+}
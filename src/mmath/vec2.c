@@ -1,70 +1,41 @@
 #include "mmath/vec2.h"
 #include "mmath_private.h"
+#include "mmath/vec2_inline.h"
 
 vec2 *vec2_create() {
-  vec2 *out = malloc(sizeof(vec2));
+  vec2 *out = mmath_alloc(sizeof(vec2), _Alignof(vec2));
   out->x = 0.f;
   out->y = 0.f;
   return out;
 }
 
 void vec2_free(vec2 *a) {
-  free(a);
+  mmath_free(a, sizeof(vec2), _Alignof(vec2));
 }
 
-vec2 *vec2_clone(const vec2 *a) {
-  vec2 *out = vec2_create();
-  vec2_copy(out, a);
+vec2a *vec2a_create() {
+  vec2a *out = mmath_alloc(sizeof(vec2a), _Alignof(vec2a));
+  vec2_zero(&out->v);
   return out;
 }
 
-vec2 *vec2_from_values(float x, float y) {
-  vec2 *out = vec2_create();
-  out->x = x;
-  out->y = y;
-  return out;
+void vec2a_free(vec2a *a) {
+  mmath_free(a, sizeof(vec2a), _Alignof(vec2a));
 }
 
-vec2 *vec2_copy(vec2 *out, const vec2 *a) {
-  out->x = a->x;
-  out->y = a->y;
+vec2 *vec2_clone(const vec2 *a) {
+  vec2 *out = vec2_create();
+  vec2_copy(out, a);
   return out;
 }
 
-vec2 *vec2_zero(vec2 *out) {
-  return vec2_set(out, 0.f, 0.f);
-}
-
-vec2 *vec2_set(vec2 *out, float x, float y) {
+vec2 *vec2_from_values(float x, float y) {
+  vec2 *out = vec2_create();
   out->x = x;
   out->y = y;
   return out;
 }
 
-vec2 *vec2_add(vec2 *out, const vec2 *a, const vec2 *b) {
-  out->x = a->x + b->x;
-  out->y = a->y + b->y;
-  return out;
-}
-
-vec2 *vec2_subtract(vec2 *out, const vec2 *a, const vec2 *b) {
-  out->x = a->x - b->x;
-  out->y = a->y - b->y;
-  return out;
-}
-
-vec2 *vec2_multiply(vec2 *out, const vec2 *a, const vec2 *b) {
-  out->x = a->x * b->x;
-  out->y = a->y * b->y;
-  return out;
-}
-
-vec2 *vec2_divide(vec2 *out, const vec2 *a, const vec2 *b) {
-  out->x = a->x / b->x;
-  out->y = a->y / b->y;
-  return out;
-}
-
 vec2 *vec2_ceil(vec2 *out, const vec2 *a) {
   out->x = ceilf(a->x);
   out->y = ceilf(a->y);
@@ -83,88 +54,6 @@ vec2 *vec2_round(vec2 *out, const vec2 *a) {
   return out;
 }
 
-vec2 *vec2_min(vec2 *out, const vec2 *a, const vec2 *b) {
-  out->x = fminf(a->x, b->x);
-  out->y = fminf(a->y, b->y);
-  return out;
-}
-
-vec2 *vec2_max(vec2 *out, const vec2 *a, const vec2 *b) {
-  out->x = fmaxf(a->x, b->x);
-  out->y = fmaxf(a->y, b->y);
-  return out;
-}
-
-vec2 *vec2_scale(vec2 *out, const vec2 *a, float b) {
-  out->x = a->x * b;
-  out->y = a->y * b;
-  return out;
-}
-
-vec2 *vec2_scale_and_add(vec2 *out, const vec2 *a, const vec2 *b, float scale) {
-  out->x = a->x + (b->x * scale);
-  out->y = a->y + (b->y * scale);
-  return out;
-}
-
-float vec2_distance(const vec2 *a, const vec2 *b) {
-  float dx = a->x - b->x;
-  float dy = a->y - b->y;
-
-  return sqrtf(dx * dx + dy * dy);
-}
-
-float vec2_distance_squared(const vec2 *a, const vec2 *b) {
-  float dx = a->x - b->x;
-  float dy = a->y - b->y;
-
-  return dx * dx + dy * dy;
-}
-
-float vec2_length(const vec2 *a) {
-  float dx = a->x;
-  float dy = a->y;
-
-  return sqrtf(dx * dx + dy * dy);
-}
-
-float vec2_length_squared(const vec2 *a) {
-  float dx = a->x;
-  float dy = a->y;
-
-  return dx * dx + dy * dy;
-}
-
-vec2 *vec2_negate(vec2 *out, const vec2 *a) {
-  out->x = -a->x;
-  out->y = -a->y;
-  return out;
-}
-
-vec2 *vec2_inverse(vec2 *out, const vec2 *a) {
-  out->x = 1.f / a->x;
-  out->y = 1.f / a->y;
-  return out;
-}
-
-vec2 *vec2_normalize(vec2 *out, const vec2 *a) {
-  float x = a->x;
-  float y = a->y;
-
-  float len = x * x + y * y;
-  if (len > 0) {
-    len = 1.f / sqrtf(len);
-  }
-
-  out->x = a->x * len;
-  out->y = a->y * len;
-  return out;
-}
-
-float vec2_dot(const vec2 *a, const vec2 *b) {
-  return a->x * b->x + a->y * b->y;
-}
-
 vec3 *vec2_cross(vec3 *out, const vec2 *a, const vec2 *b) {
   float z = a->x * b->y - a->y * b->x;
   out->x = out->y = 0;
@@ -172,15 +61,6 @@ vec3 *vec2_cross(vec3 *out, const vec2 *a, const vec2 *b) {
   return out;
 }
 
-vec2 *vec2_lerp(vec2 *out, const vec2 *a, const vec2 *b, float t) {
-  float x = a->x;
-  float y = a->y;
-
-  out->x = x + t * (b->x - x);
-  out->y = y + t * (b->y - y);
-  return out;
-}
-
 vec2 *vec2_random(vec2 *out, float scale) {
   float r = mmath_random() * 2.f * (float) M_PI;
 
@@ -229,8 +109,8 @@ vec2 *vec2_rotate(vec2 *out, const vec2 *a, const vec2 *b, float c) {
   float dx = a->x - b->x;
   float dy = a->y - b->y;
 
-  float sinc = sinf(c);
-  float cosc = cosf(c);
+  float sinc, cosc;
+  mmath_sincosf(c, &sinc, &cosc);
 
   out->x = dx * cosc - dy * sinc + b->x;
   out->y = dx * sinc + dy * cosc + b->y;
@@ -1,8 +1,9 @@
 #include "mmath/vec3.h"
 #include "mmath_private.h"
+#include "mmath/vec3_inline.h"
 
 vec3 *vec3_create() {
-  vec3 *out = malloc(sizeof(vec3));
+  vec3 *out = mmath_alloc(sizeof(vec3), _Alignof(vec3));
   out->x = 0.f;
   out->y = 0.f;
   out->z = 0.f;
@@ -10,69 +11,33 @@ vec3 *vec3_create() {
 }
 
 void vec3_free(vec3 *a) {
-  free(a);
+  mmath_free(a, sizeof(vec3), _Alignof(vec3));
 }
 
-vec3 *vec3_clone(const vec3 *a) {
-  vec3 *out = vec3_create();
-  vec3_copy(out, a);
+vec3a *vec3a_create() {
+  vec3a *out = mmath_alloc(sizeof(vec3a), _Alignof(vec3a));
+  vec3_zero(&out->v);
   return out;
 }
 
-vec3 *vec3_from_values(float x, float y, float z) {
-  vec3 *out = vec3_create();
-  out->x = x;
-  out->y = y;
-  out->z = z;
-  return out;
+void vec3a_free(vec3a *a) {
+  mmath_free(a, sizeof(vec3a), _Alignof(vec3a));
 }
 
-vec3 *vec3_copy(vec3 *out, const vec3 *a) {
-  out->x = a->x;
-  out->y = a->y;
-  out->z = a->z;
+vec3 *vec3_clone(const vec3 *a) {
+  vec3 *out = vec3_create();
+  vec3_copy(out, a);
   return out;
 }
 
-vec3 *vec3_zero(vec3 *out) {
-  return vec3_set(out, 0.f, 0.f, 0.f);
-}
-
-vec3 *vec3_set(vec3 *out, float x, float y, float z) {
+vec3 *vec3_from_values(float x, float y, float z) {
+  vec3 *out = vec3_create();
   out->x = x;
   out->y = y;
   out->z = z;
   return out;
 }
 
-vec3 *vec3_add(vec3 *out, const vec3 *a, const vec3 *b) {
-  out->x = a->x + b->x;
-  out->y = a->y + b->y;
-  out->z = a->z + b->z;
-  return out;
-}
-
-vec3 *vec3_subtract(vec3 *out, const vec3 *a, const vec3 *b) {
-  out->x = a->x - b->x;
-  out->y = a->y - b->y;
-  out->z = a->z - b->z;
-  return out;
-}
-
-vec3 *vec3_multiply(vec3 *out, const vec3 *a, const vec3 *b) {
-  out->x = a->x * b->x;
-  out->y = a->y * b->y;
-  out->z = a->z * b->z;
-  return out;
-}
-
-vec3 *vec3_divide(vec3 *out, const vec3 *a, const vec3 *b) {
-  out->x = a->x / b->x;
-  out->y = a->y / b->y;
-  out->z = a->z / b->z;
-  return out;
-}
-
 vec3 *vec3_ceil(vec3 *out, const vec3 *a) {
   out->x = ceilf(a->x);
   out->y = ceilf(a->y);
@@ -94,125 +59,6 @@ vec3 *vec3_round(vec3 *out, const vec3 *a) {
   return out;
 }
 
-vec3 *vec3_min(vec3 *out, const vec3 *a, const vec3 *b) {
-  out->x = fminf(a->x, b->x);
-  out->y = fminf(a->y, b->y);
-  out->z = fminf(a->z, b->z);
-  return out;
-}
-
-vec3 *vec3_max(vec3 *out, const vec3 *a, const vec3 *b) {
-  out->x = fmaxf(a->x, b->x);
-  out->y = fmaxf(a->y, b->y);
-  out->z = fmaxf(a->z, b->z);
-  return out;
-}
-
-vec3 *vec3_scale(vec3 *out, const vec3 *a, float b) {
-  out->x = a->x * b;
-  out->y = a->y * b;
-  out->z = a->z * b;
-  return out;
-}
-
-vec3 *vec3_scale_and_add(vec3 *out, const vec3 *a, const vec3 *b, float scale) {
-  out->x = a->x + (b->x * scale);
-  out->y = a->y + (b->y * scale);
-  out->z = a->z + (b->z * scale);
-  return out;
-}
-
-float vec3_distance(const vec3 *a, const vec3 *b) {
-  float dx = a->x - b->x;
-  float dy = a->y - b->y;
-  float dz = a->z - b->z;
-
-  return sqrtf(dx * dx + dy * dy + dz * dz);
-}
-
-float vec3_distance_squared(const vec3 *a, const vec3 *b) {
-  float dx = a->x - b->x;
-  float dy = a->y - b->y;
-  float dz = a->z - b->z;
-
-  return dx * dx + dy * dy + dz * dz;
-}
-
-float vec3_length(const vec3 *a) {
-  float dx = a->x;
-  float dy = a->y;
-  float dz = a->z;
-
-  return sqrtf(dx * dx + dy * dy + dz * dz);
-}
-
-float vec3_length_squared(const vec3 *a) {
-  float dx = a->x;
-  float dy = a->y;
-  float dz = a->z;
-
-  return dx * dx + dy * dy + dz * dz;
-}
-
-vec3 *vec3_negate(vec3 *out, const vec3 *a) {
-  out->x = -a->x;
-  out->y = -a->y;
-  out->z = -a->z;
-  return out;
-}
-
-vec3 *vec3_inverse(vec3 *out, const vec3 *a) {
-  out->x = 1.f / a->x;
-  out->y = 1.f / a->y;
-  out->z = 1.f / a->z;
-  return out;
-}
-
-vec3 *vec3_normalize(vec3 *out, const vec3 *a) {
-  float x = a->x;
-  float y = a->y;
-  float z = a->z;
-
-  float len = x * x + y * y + z * z;
-  if (len > 0) {
-    len = 1.f / sqrtf(len);
-  }
-
-  out->x = a->x * len;
-  out->y = a->y * len;
-  out->z = a->z * len;
-  return out;
-}
-
-float vec3_dot(const vec3 *a, const vec3 *b) {
-  return a->x * b->x + a->y * b->y + a->z * b->z;
-}
-
-vec3 *vec3_cross(vec3 *out, const vec3 *a, const vec3 *b) {
-  float ax = a->x;
-  float ay = a->y;
-  float az = a->z;
-  float bx = b->x;
-  float by = b->y;
-  float bz = b->z;
-
-  out->x = ay * bz - az * by;
-  out->y = az * bx - ax * bz;
-  out->z = ax * by - ay * bx;
-  return out;
-}
-
-vec3 *vec3_lerp(vec3 *out, const vec3 *a, const vec3 *b, float t) {
-  float x = a->x;
-  float y = a->y;
-  float z = a->z;
-
-  out->x = x + t * (b->x - x);
-  out->y = y + t * (b->y - y);
-  out->z = z + t * (b->z - z);
-  return out;
-}
-
 vec3 *vec3_hermite(vec3 *out, const vec3 *a, const vec3 *b, const vec3 *c, const vec3 *d, float t) {
   float factor_times2 = t * t;
   float factor1 = factor_times2 * (2 * t - 3) + 1;
@@ -277,6 +123,56 @@ vec3 *vec3_transform_mat4(vec3 *out, const vec3 *a, mat4 *m) {
   return out;
 }
 
+vec3 *vec3_transform_mat4_batch(
+  vec3 *out,
+  size_t out_stride,
+  const vec3 *a,
+  size_t a_stride,
+  size_t count,
+  const mat4 *m
+) {
+  float m00 = m->data[0], m01 = m->data[1], m02 = m->data[2], m03 = m->data[3];
+  float m10 = m->data[4], m11 = m->data[5], m12 = m->data[6], m13 = m->data[7];
+  float m20 = m->data[8], m21 = m->data[9], m22 = m->data[10], m23 = m->data[11];
+  float m30 = m->data[12], m31 = m->data[13], m32 = m->data[14], m33 = m->data[15];
+
+  unsigned char *dst = (unsigned char *) out;
+  const unsigned char *src = (const unsigned char *) a;
+  size_t i;
+
+  if (m03 == 0.f && m13 == 0.f && m23 == 0.f && m33 == 1.f) {
+    // Affine matrix, w is always 1
+    for (i = 0; i < count; ++i, dst += out_stride, src += a_stride) {
+      const vec3 *v = (const vec3 *) src;
+      vec3 *r = (vec3 *) dst;
+      float x = v->x;
+      float y = v->y;
+      float z = v->z;
+
+      r->x = m00 * x + m10 * y + m20 * z + m30;
+      r->y = m01 * x + m11 * y + m21 * z + m31;
+      r->z = m02 * x + m12 * y + m22 * z + m32;
+    }
+  } else {
+    for (i = 0; i < count; ++i, dst += out_stride, src += a_stride) {
+      const vec3 *v = (const vec3 *) src;
+      vec3 *r = (vec3 *) dst;
+      float x = v->x;
+      float y = v->y;
+      float z = v->z;
+
+      float w = m03 * x + m13 * y + m23 * z + m33;
+      w = w == 0.f ? 1.f : 1.f / w;
+
+      r->x = (m00 * x + m10 * y + m20 * z + m30) * w;
+      r->y = (m01 * x + m11 * y + m21 * z + m31) * w;
+      r->z = (m02 * x + m12 * y + m22 * z + m32) * w;
+    }
+  }
+
+  return out;
+}
+
 // TODO: Quat?
 
 vec3 *vec3_rotate_x(vec3 *out, const vec3 *a, const vec3 *b, float c) {
@@ -286,8 +182,8 @@ vec3 *vec3_rotate_x(vec3 *out, const vec3 *a, const vec3 *b, float c) {
   p.y = a->y - b->y;
   p.z = a->z - b->z;
 
-  float sinc = sinf(c);
-  float cosc = cosf(c);
+  float sinc, cosc;
+  mmath_sincosf(c, &sinc, &cosc);
 
   r.x = p.x;
   r.y = p.y * cosc - p.z * sinc;
@@ -306,8 +202,8 @@ vec3 *vec3_rotate_y(vec3 *out, const vec3 *a, const vec3 *b, float c) {
   p.y = a->y - b->y;
   p.z = a->z - b->z;
 
-  float sinc = sinf(c);
-  float cosc = cosf(c);
+  float sinc, cosc;
+  mmath_sincosf(c, &sinc, &cosc);
 
   r.x = p.z * sinc + p.x * cosc;
   r.y = p.y;
@@ -326,8 +222,8 @@ vec3 *vec3_rotate_z(vec3 *out, const vec3 *a, const vec3 *b, float c) {
   p.y = a->y - b->y;
   p.z = a->z - b->z;
 
-  float sinc = sinf(c);
-  float cosc = cosf(c);
+  float sinc, cosc;
+  mmath_sincosf(c, &sinc, &cosc);
 
   r.x = p.x * cosc - p.y * sinc;
   r.y = p.x * sinc + p.y * cosc;
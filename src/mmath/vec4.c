@@ -1,8 +1,9 @@
 #include "mmath/vec4.h"
 #include "mmath_private.h"
+#include "mmath/vec4_inline.h"
 
 vec4 *vec4_create() {
-  vec4 *out = malloc(sizeof(vec4));
+  vec4 *out = mmath_alloc(sizeof(vec4), _Alignof(vec4));
   out->x = 0.f;
   out->y = 0.f;
   out->z = 0.f;
@@ -11,37 +12,27 @@ vec4 *vec4_create() {
 }
 
 void vec4_free(vec4 *a) {
-  free(a);
+  mmath_free(a, sizeof(vec4), _Alignof(vec4));
 }
 
-vec4 *vec4_clone(const vec4 *a) {
-  vec4 *out = vec4_create();
-  vec4_copy(out, a);
+vec4a *vec4a_create() {
+  vec4a *out = mmath_alloc(sizeof(vec4a), _Alignof(vec4a));
+  vec4_zero(&out->v);
   return out;
 }
 
-vec4 *vec4_from_values(float x, float y, float z, float w) {
-  vec4 *out = vec4_create();
-  out->x = x;
-  out->y = y;
-  out->z = z;
-  out->w = w;
-  return out;
+void vec4a_free(vec4a *a) {
+  mmath_free(a, sizeof(vec4a), _Alignof(vec4a));
 }
 
-vec4 *vec4_copy(vec4 *out, const vec4 *a) {
-  out->x = a->x;
-  out->y = a->y;
-  out->z = a->z;
-  out->w = a->w;
+vec4 *vec4_clone(const vec4 *a) {
+  vec4 *out = vec4_create();
+  vec4_copy(out, a);
   return out;
 }
 
-vec4 *vec4_zero(vec4 *out) {
-  return vec4_set(out, 0.f, 0.f, 0.f, 0.f);
-}
-
-vec4 *vec4_set(vec4 *out, float x, float y, float z, float w) {
+vec4 *vec4_from_values(float x, float y, float z, float w) {
+  vec4 *out = vec4_create();
   out->x = x;
   out->y = y;
   out->z = z;
@@ -49,38 +40,6 @@ vec4 *vec4_set(vec4 *out, float x, float y, float z, float w) {
   return out;
 }
 
-vec4 *vec4_add(vec4 *out, const vec4 *a, const vec4 *b) {
-  out->x = a->x + b->x;
-  out->y = a->y + b->y;
-  out->z = a->z + b->z;
-  out->w = a->w + b->w;
-  return out;
-}
-
-vec4 *vec4_subtract(vec4 *out, const vec4 *a, const vec4 *b) {
-  out->x = a->x - b->x;
-  out->y = a->y - b->y;
-  out->z = a->z - b->z;
-  out->w = a->w - b->w;
-  return out;
-}
-
-vec4 *vec4_multiply(vec4 *out, const vec4 *a, const vec4 *b) {
-  out->x = a->x * b->x;
-  out->y = a->y * b->y;
-  out->z = a->z * b->z;
-  out->w = a->w * b->w;
-  return out;
-}
-
-vec4 *vec4_divide(vec4 *out, const vec4 *a, const vec4 *b) {
-  out->x = a->x / b->x;
-  out->y = a->y / b->y;
-  out->z = a->z / b->z;
-  out->w = a->w / b->w;
-  return out;
-}
-
 vec4 *vec4_ceil(vec4 *out, const vec4 *a) {
   out->x = ceilf(a->x);
   out->y = ceilf(a->y);
@@ -105,112 +64,6 @@ vec4 *vec4_round(vec4 *out, const vec4 *a) {
   return out;
 }
 
-vec4 *vec4_min(vec4 *out, const vec4 *a, const vec4 *b) {
-  out->x = fminf(a->x, b->x);
-  out->y = fminf(a->y, b->y);
-  out->z = fminf(a->z, b->z);
-  out->w = fminf(a->w, b->w);
-  return out;
-}
-
-vec4 *vec4_max(vec4 *out, const vec4 *a, const vec4 *b) {
-  out->x = fmaxf(a->x, b->x);
-  out->y = fmaxf(a->y, b->y);
-  out->z = fmaxf(a->z, b->z);
-  out->w = fmaxf(a->z, b->w);
-  return out;
-}
-
-vec4 *vec4_scale(vec4 *out, const vec4 *a, float b) {
-  out->x = a->x * b;
-  out->y = a->y * b;
-  out->z = a->z * b;
-  out->w = a->w * b;
-  return out;
-}
-
-vec4 *vec4_scale_and_add(vec4 *out, const vec4 *a, const vec4 *b, float scale) {
-  out->x = a->x + (b->x * scale);
-  out->y = a->y + (b->y * scale);
-  out->z = a->z + (b->z * scale);
-  out->w = a->w + (b->w * scale);
-  return out;
-}
-
-float vec4_distance(const vec4 *a, const vec4 *b) {
-  float dx = a->x - b->x;
-  float dy = a->y - b->y;
-  float dz = a->z - b->z;
-  float dw = a->w - b->w;
-
-  return sqrtf(dx * dx + dy * dy + dz * dz + dw * dw);
-}
-
-float vec4_distance_squared(const vec4 *a, const vec4 *b) {
-  float dx = a->x - b->x;
-  float dy = a->y - b->y;
-  float dz = a->z - b->z;
-  float dw = a->w - b->w;
-
-  return dx * dx + dy * dy + dz * dz + dw * dw;
-}
-
-float vec4_length(const vec4 *a) {
-  float dx = a->x;
-  float dy = a->y;
-  float dz = a->z;
-  float dw = a->w;
-
-  return sqrtf(dx * dx + dy * dy + dz * dz + dw * dw);
-}
-
-float vec4_length_squared(const vec4 *a) {
-  float dx = a->x;
-  float dy = a->y;
-  float dz = a->z;
-  float dw = a->w;
-
-  return dx * dx + dy * dy + dz * dz + dw * dw;
-}
-
-vec4 *vec4_negate(vec4 *out, const vec4 *a) {
-  out->x = -a->x;
-  out->y = -a->y;
-  out->z = -a->z;
-  out->w = -a->w;
-  return out;
-}
-
-vec4 *vec4_inverse(vec4 *out, const vec4 *a) {
-  out->x = 1.f / a->x;
-  out->y = 1.f / a->y;
-  out->z = 1.f / a->z;
-  out->w = 1.f / a->w;
-  return out;
-}
-
-vec4 *vec4_normalize(vec4 *out, const vec4 *a) {
-  float x = a->x;
-  float y = a->y;
-  float z = a->z;
-  float w = a->w;
-
-  float len = x * x + y * y + z * z + w * w;
-  if (len > 0) {
-    len = 1.f / sqrtf(len);
-  }
-
-  out->x = a->x * len;
-  out->y = a->y * len;
-  out->z = a->z * len;
-  out->w = a->w * len;
-  return out;
-}
-
-float vec4_dot(const vec4 *a, const vec4 *b) {
-  return a->x * b->x + a->y * b->y + a->z * b->z + a->w * b->w;
-}
-
 vec4 *vec4_cross(vec4 *out, const vec4 *u, const vec4 *v, const vec4 *w) {
   float A = (v->x * w->y) - (v->y * w->x);
   float B = (v->x * w->z) - (v->z * w->x);
@@ -231,19 +84,6 @@ vec4 *vec4_cross(vec4 *out, const vec4 *u, const vec4 *v, const vec4 *w) {
   return out;
 }
 
-vec4 *vec4_lerp(vec4 *out, const vec4 *a, const vec4 *b, float t) {
-  float x = a->x;
-  float y = a->y;
-  float z = a->z;
-  float w = a->w;
-
-  out->x = x + t * (b->x - x);
-  out->y = y + t * (b->y - y);
-  out->z = z + t * (b->z - z);
-  out->w = w + t * (b->z - w);
-  return out;
-}
-
 vec4 *vec4_random(vec4 *out, float scale) {
   // Marsaglia, George. Choosing a Point from the Surface of a
   // Sphere. Ann. Math. Statist. 43 (1972), no. 2, 645--646.
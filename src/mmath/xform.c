@@ -0,0 +1,288 @@
+#include "mmath/xform.h"
+#include "mmath_private.h"
+
+// Rotation matrices built from unit quaternions are orthonormal to a few ulp
+#define XFORM_RIGID_EPSILON 1e-5f
+
+static inline xform *xform_tag(xform *out, xform_kind kind) {
+  out->kind = kind;
+  return out;
+}
+
+xform *xform_identity(xform *out) {
+  mat4_identity(&out->matrix);
+  return xform_tag(out, MMATH_XFORM_IDENTITY);
+}
+
+xform *xform_from_mat4(xform *out, const mat4 *m) {
+  const float *d = m->data;
+  xform_kind kind;
+
+  if (&out->matrix != m) {
+    mat4_copy(&out->matrix, m);
+  }
+
+  if (d[3] != 0.f || d[7] != 0.f || d[11] != 0.f || d[15] != 1.f) {
+    kind = MMATH_XFORM_PROJECTIVE;
+  } else if (d[1] == 0.f && d[2] == 0.f && d[4] == 0.f && d[6] == 0.f && d[8] == 0.f && d[9] == 0.f) {
+    if (d[0] != 1.f || d[5] != 1.f || d[10] != 1.f) {
+      kind = MMATH_XFORM_SCALE_TRANSLATION;
+    } else if (d[12] != 0.f || d[13] != 0.f || d[14] != 0.f) {
+      kind = MMATH_XFORM_TRANSLATION;
+    } else {
+      kind = MMATH_XFORM_IDENTITY;
+    }
+  } else {
+    float xx = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+    float yy = d[4] * d[4] + d[5] * d[5] + d[6] * d[6];
+    float zz = d[8] * d[8] + d[9] * d[9] + d[10] * d[10];
+    float xy = d[0] * d[4] + d[1] * d[5] + d[2] * d[6];
+    float xz = d[0] * d[8] + d[1] * d[9] + d[2] * d[10];
+    float yz = d[4] * d[8] + d[5] * d[9] + d[6] * d[10];
+
+    if (
+      fabsf(xx - 1.f) <= XFORM_RIGID_EPSILON &&
+      fabsf(yy - 1.f) <= XFORM_RIGID_EPSILON &&
+      fabsf(zz - 1.f) <= XFORM_RIGID_EPSILON &&
+      fabsf(xy) <= XFORM_RIGID_EPSILON &&
+      fabsf(xz) <= XFORM_RIGID_EPSILON &&
+      fabsf(yz) <= XFORM_RIGID_EPSILON
+    ) {
+      kind = MMATH_XFORM_RIGID;
+    } else {
+      kind = MMATH_XFORM_AFFINE;
+    }
+  }
+
+  return xform_tag(out, kind);
+}
+
+xform *xform_from_translation(xform *out, const vec4 *v) {
+  mat4_from_translation(&out->matrix, v);
+  return xform_tag(out, MMATH_XFORM_TRANSLATION);
+}
+
+xform *xform_from_scaling(xform *out, const vec4 *v) {
+  mat4_from_scaling(&out->matrix, v);
+  return xform_tag(out, MMATH_XFORM_SCALE_TRANSLATION);
+}
+
+xform *xform_from_rotation(xform *out, float angle, const vec3 *axis) {
+  if (mat4_from_rotation(&out->matrix, angle, axis) == NULL) {
+    return NULL;
+  }
+  return xform_tag(out, MMATH_XFORM_RIGID);
+}
+
+xform *xform_from_quat(xform *out, const quat *q) {
+  mat4_from_quat(&out->matrix, q);
+  return xform_tag(out, MMATH_XFORM_RIGID);
+}
+
+xform *xform_from_rotation_translation(xform *out, const quat *q, const vec3 *v) {
+  mat4_from_rotation_translation(&out->matrix, q, v);
+  return xform_tag(out, MMATH_XFORM_RIGID);
+}
+
+xform *xform_from_rotation_translation_scale(xform *out, const quat *q, const vec3 *v, const vec3 *s) {
+  mat4_from_rotation_translation_scale(&out->matrix, q, v, s);
+  return xform_tag(out, s->x == 1.f && s->y == 1.f && s->z == 1.f ? MMATH_XFORM_RIGID : MMATH_XFORM_AFFINE);
+}
+
+xform *xform_look_at(xform *out, const vec3 *eye, const vec3 *center, const vec3 *up) {
+  mat4_look_at(&out->matrix, eye, center, up);
+  return xform_tag(out, MMATH_XFORM_RIGID);
+}
+
+xform *xform_ortho(xform *out, float left, float right, float bottom, float top, float near, float far) {
+  mat4_ortho(&out->matrix, left, right, bottom, top, near, far);
+  return xform_tag(out, MMATH_XFORM_SCALE_TRANSLATION);
+}
+
+xform *xform_perspective(xform *out, float fovy, float aspect, float near, float far) {
+  mat4_perspective(&out->matrix, fovy, aspect, near, far);
+  return xform_tag(out, MMATH_XFORM_PROJECTIVE);
+}
+
+xform *xform_frustum(xform *out, float left, float right, float bottom, float top, float near, float far) {
+  mat4_frustum(&out->matrix, left, right, bottom, top, near, far);
+  return xform_tag(out, MMATH_XFORM_PROJECTIVE);
+}
+
+xform *xform_copy(xform *out, const xform *a) {
+  mat4_copy(&out->matrix, &a->matrix);
+  return xform_tag(out, a->kind);
+}
+
+// a * b for diagonal upper 3x3s
+static void xform_multiply_scale_translation(mat4 *out, const mat4 *a, const mat4 *b) {
+  float ax = a->data[0], ay = a->data[5], az = a->data[10];
+  float bx = b->data[0], by = b->data[5], bz = b->data[10];
+  float tx = ax * b->data[12] + a->data[12];
+  float ty = ay * b->data[13] + a->data[13];
+  float tz = az * b->data[14] + a->data[14];
+
+  mat4_identity(out);
+  out->data[0] = ax * bx;
+  out->data[5] = ay * by;
+  out->data[10] = az * bz;
+  out->data[12] = tx;
+  out->data[13] = ty;
+  out->data[14] = tz;
+}
+
+// a * b when both bottom rows are (0, 0, 0, 1)
+static void xform_multiply_affine(mat4 *out, const mat4 *a, const mat4 *b) {
+#if defined(MMATH_SSE2)
+  __m128 a0 = _mm_loadu_ps(&a->data[0]);
+  __m128 a1 = _mm_loadu_ps(&a->data[4]);
+  __m128 a2 = _mm_loadu_ps(&a->data[8]);
+  __m128 a3 = _mm_loadu_ps(&a->data[12]);
+  __m128 r[4];
+  int j;
+
+  for (j = 0; j < 4; ++j) {
+    const float *c = &b->data[4 * j];
+    r[j] = _mm_add_ps(
+      _mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(c[0])), _mm_mul_ps(a1, _mm_set1_ps(c[1]))),
+      _mm_mul_ps(a2, _mm_set1_ps(c[2]))
+    );
+  }
+  r[3] = _mm_add_ps(r[3], a3);
+
+  for (j = 0; j < 4; ++j) {
+    _mm_storeu_ps(&out->data[4 * j], r[j]);
+  }
+#else
+  float a00 = a->data[0], a01 = a->data[1], a02 = a->data[2];
+  float a10 = a->data[4], a11 = a->data[5], a12 = a->data[6];
+  float a20 = a->data[8], a21 = a->data[9], a22 = a->data[10];
+  float a30 = a->data[12], a31 = a->data[13], a32 = a->data[14];
+  float r[12];
+  int j;
+
+  for (j = 0; j < 4; ++j) {
+    float b0 = b->data[4 * j], b1 = b->data[4 * j + 1], b2 = b->data[4 * j + 2];
+    r[3 * j] = b0 * a00 + b1 * a10 + b2 * a20;
+    r[3 * j + 1] = b0 * a01 + b1 * a11 + b2 * a21;
+    r[3 * j + 2] = b0 * a02 + b1 * a12 + b2 * a22;
+  }
+
+  for (j = 0; j < 3; ++j) {
+    out->data[4 * j] = r[3 * j];
+    out->data[4 * j + 1] = r[3 * j + 1];
+    out->data[4 * j + 2] = r[3 * j + 2];
+    out->data[4 * j + 3] = 0.f;
+  }
+  out->data[12] = r[9] + a30;
+  out->data[13] = r[10] + a31;
+  out->data[14] = r[11] + a32;
+  out->data[15] = 1.f;
+#endif
+}
+
+xform *xform_multiply(xform *out, const xform *a, const xform *b) {
+  xform_kind kind = a->kind > b->kind ? a->kind : b->kind;
+
+  // Scaling and rotating together is neither of the two
+  if (
+    (a->kind == MMATH_XFORM_SCALE_TRANSLATION && b->kind == MMATH_XFORM_RIGID) ||
+    (a->kind == MMATH_XFORM_RIGID && b->kind == MMATH_XFORM_SCALE_TRANSLATION)
+  ) {
+    kind = MMATH_XFORM_AFFINE;
+  }
+
+  if (a->kind == MMATH_XFORM_IDENTITY) {
+    return xform_copy(out, b);
+  }
+  if (b->kind == MMATH_XFORM_IDENTITY) {
+    return xform_copy(out, a);
+  }
+
+  if (kind <= MMATH_XFORM_SCALE_TRANSLATION) {
+    xform_multiply_scale_translation(&out->matrix, &a->matrix, &b->matrix);
+  } else if (kind <= MMATH_XFORM_AFFINE) {
+    xform_multiply_affine(&out->matrix, &a->matrix, &b->matrix);
+  } else {
+    mat4_multiply(&out->matrix, &a->matrix, &b->matrix);
+  }
+
+  return xform_tag(out, kind);
+}
+
+xform *xform_invert(xform *out, const xform *a) {
+  xform_kind kind = a->kind;
+
+  switch (kind) {
+    case MMATH_XFORM_IDENTITY:
+      mat4_identity(&out->matrix);
+      break;
+    case MMATH_XFORM_TRANSLATION: {
+      float tx = a->matrix.data[12], ty = a->matrix.data[13], tz = a->matrix.data[14];
+      mat4_identity(&out->matrix);
+      out->matrix.data[12] = -tx;
+      out->matrix.data[13] = -ty;
+      out->matrix.data[14] = -tz;
+      break;
+    }
+    case MMATH_XFORM_SCALE_TRANSLATION: {
+      float sx = a->matrix.data[0], sy = a->matrix.data[5], sz = a->matrix.data[10];
+      float tx = a->matrix.data[12], ty = a->matrix.data[13], tz = a->matrix.data[14];
+
+      if (sx == 0.f || sy == 0.f || sz == 0.f) {
+        return NULL;
+      }
+
+      sx = 1.f / sx;
+      sy = 1.f / sy;
+      sz = 1.f / sz;
+      mat4_identity(&out->matrix);
+      out->matrix.data[0] = sx;
+      out->matrix.data[5] = sy;
+      out->matrix.data[10] = sz;
+      out->matrix.data[12] = -tx * sx;
+      out->matrix.data[13] = -ty * sy;
+      out->matrix.data[14] = -tz * sz;
+      break;
+    }
+    case MMATH_XFORM_RIGID:
+      mat4_invert_rigid(&out->matrix, &a->matrix);
+      break;
+    case MMATH_XFORM_AFFINE:
+      if (mat4_invert_affine(&out->matrix, &a->matrix) == NULL) {
+        return NULL;
+      }
+      break;
+    default:
+      if (mat4_invert(&out->matrix, &a->matrix) == NULL) {
+        return NULL;
+      }
+      break;
+  }
+
+  return xform_tag(out, kind);
+}
+
+vec3 *xform_transform_point(vec3 *out, const vec3 *a, const xform *x) {
+  const float *m = x->matrix.data;
+  float px = a->x, py = a->y, pz = a->z;
+
+  switch (x->kind) {
+    case MMATH_XFORM_IDENTITY:
+      return vec3_copy(out, a);
+    case MMATH_XFORM_TRANSLATION:
+      return vec3_set(out, px + m[12], py + m[13], pz + m[14]);
+    case MMATH_XFORM_SCALE_TRANSLATION:
+      return vec3_set(out, px * m[0] + m[12], py * m[5] + m[13], pz * m[10] + m[14]);
+    case MMATH_XFORM_RIGID:
+    case MMATH_XFORM_AFFINE:
+      return vec3_set(
+        out,
+        m[0] * px + m[4] * py + m[8] * pz + m[12],
+        m[1] * px + m[5] * py + m[9] * pz + m[13],
+        m[2] * px + m[6] * py + m[10] * pz + m[14]
+      );
+    default:
+      return vec3_transform_mat4(out, a, (mat4 *) &x->matrix);
+  }
+}
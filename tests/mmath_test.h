@@ -0,0 +1,59 @@
+#ifndef MMATH_TEST_H
+#define MMATH_TEST_H
+
+// Minimal checks shared by the tests. Each test is one executable that returns non-zero when a
+// check failed; ctest runs it once per kernel set through MMATH_BACKEND.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <mmath.h>
+
+static int mmath_test_failures;
+
+#define MMATH_TEST_LOG_LIMIT 20
+
+#define CHECK(cond) mmath_test_check((cond), #cond, __FILE__, __LINE__)
+
+static inline void mmath_test_check(bool ok, const char *what, const char *file, int line) {
+  if (ok) {
+    return;
+  }
+  if (mmath_test_failures++ < MMATH_TEST_LOG_LIMIT) {
+    fprintf(stderr, "%s:%d: check failed: %s\n", file, line, what);
+  }
+}
+
+// Equal up to eps relative to the larger magnitude (absolute below 1), NaN only equals NaN
+static inline bool mmath_test_near(float a, float b, float eps) {
+  float scale = fmaxf(1.f, fmaxf(fabsf(a), fabsf(b)));
+
+  if (isnan(a) || isnan(b)) {
+    return isnan(a) && isnan(b);
+  }
+  return fabsf(a - b) <= eps * scale;
+}
+
+static inline bool mmath_test_near_array(const float *a, const float *b, size_t count, float eps) {
+  size_t i;
+
+  for (i = 0; i < count; ++i) {
+    if (!mmath_test_near(a[i], b[i], eps)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static inline int mmath_test_result(const char *name) {
+  if (mmath_test_failures > 0) {
+    fprintf(stderr, "%s (%s): %d checks failed\n", name, mmath_backend_name(mmath_get_backend()), mmath_test_failures);
+    return 1;
+  }
+  printf("%s (%s): ok\n", name, mmath_backend_name(mmath_get_backend()));
+  return 0;
+}
+
+#endif // MMATH_TEST_H
@@ -0,0 +1,151 @@
+#include "mmath_test.h"
+
+#define TEST_BATCH 37
+#define TEST_ROUNDS 200
+
+typedef struct test_point {
+  vec3 p;
+  float pad;
+} test_point;
+
+static float test_float(mmath_rng *rng) {
+  return mmath_rng_float(rng) * 2.f - 1.f;
+}
+
+static void test_random_trs(mmath_rng *rng, quat *q, vec3 *t, vec3 *s) {
+  mmath_rng_fill_unit_quat(rng, q, 1);
+  vec3_set(t, test_float(rng) * 10.f, test_float(rng) * 10.f, test_float(rng) * 10.f);
+  vec3_set(s, .5f + mmath_rng_float(rng), .5f + mmath_rng_float(rng), .5f + mmath_rng_float(rng));
+}
+
+static bool test_near_mat4(const mat4 *a, const mat4 *b, float eps) {
+  return mmath_test_near_array(a->data, b->data, 16, eps);
+}
+
+static bool test_near_mat3x4(const mat3x4 *a, const mat3x4 *b, float eps) {
+  return mmath_test_near_array(a->data, b->data, 12, eps);
+}
+
+static bool test_near_vec3(const vec3 *a, const vec3 *b, float eps) {
+  return mmath_test_near_array(a->data, b->data, 3, eps);
+}
+
+int main() {
+  mat3x4 a[TEST_BATCH], b[TEST_BATCH], out[TEST_BATCH], one;
+  mat4 m4[TEST_BATCH], expanded, product;
+  quat q[TEST_BATCH];
+  vec3 t[TEST_BATCH], s[TEST_BATCH], v, w;
+  test_point points[TEST_BATCH], transformed[TEST_BATCH];
+  uint32_t failed[(TEST_BATCH + 31) / 32];
+  mmath_rng rng;
+  size_t round, i;
+  int r, c;
+
+  mmath_rng_seed(&rng, 16);
+
+  for (round = 0; round < TEST_ROUNDS; ++round) {
+    size_t count = round % (TEST_BATCH + 1);
+
+    for (i = 0; i < TEST_BATCH; ++i) {
+      quat q2;
+      vec3 t2, s2;
+
+      test_random_trs(&rng, &q[i], &t[i], &s[i]);
+      mat4_from_rotation_translation_scale(&m4[i], &q[i], &t[i], &s[i]);
+      test_random_trs(&rng, &q2, &t2, &s2);
+      mat3x4_from_rotation_translation_scale(&b[i], &q2, &t2, &s2);
+      vec3_set(&points[i].p, test_float(&rng) * 5.f, test_float(&rng) * 5.f, test_float(&rng) * 5.f);
+    }
+
+    // Row-major, mat4 is column-major
+    mat3x4_from_mat4_batch(a, m4, count);
+    for (i = 0; i < count; ++i) {
+      for (r = 0; r < 3; ++r) {
+        for (c = 0; c < 4; ++c) {
+          CHECK(a[i].data[r * 4 + c] == m4[i].data[c * 4 + r]);
+        }
+      }
+      mat4_from_mat3x4(&expanded, &a[i]);
+      CHECK(mat4_exact_equals(&expanded, &m4[i]));
+    }
+    mat4_from_mat3x4_batch(m4, a, count);
+    for (i = 0; i < count; ++i) {
+      mat3x4_from_mat4(&one, &m4[i]);
+      CHECK(mat3x4_exact_equals(&one, &a[i]));
+    }
+
+    mat3x4_from_rotation_translation_scale_batch(out, q, t, s, count);
+    for (i = 0; i < count; ++i) {
+      mat3x4_from_rotation_translation_scale(&one, &q[i], &t[i], &s[i]);
+      CHECK(test_near_mat3x4(&out[i], &one, 1e-6f));
+      CHECK(test_near_mat3x4(&one, &a[i], 1e-6f));
+    }
+
+    mat3x4_multiply_batch(out, a, b, count);
+    for (i = 0; i < count; ++i) {
+      mat4 mb;
+
+      mat3x4_multiply(&one, &a[i], &b[i]);
+      CHECK(test_near_mat3x4(&out[i], &one, 1e-6f));
+      mat4_from_mat3x4(&expanded, &a[i]);
+      mat4_from_mat3x4(&mb, &b[i]);
+      mat4_multiply(&product, &expanded, &mb);
+      mat4_from_mat3x4(&expanded, &one);
+      CHECK(test_near_mat4(&expanded, &product, 1e-5f));
+    }
+
+    CHECK(mat3x4_invert_batch(out, a, count, failed) == 0);
+    for (i = 0; i < count; ++i) {
+      mat3x4_invert(&one, &a[i]);
+      CHECK(test_near_mat3x4(&out[i], &one, 1e-6f));
+      mat4_from_mat3x4(&expanded, &a[i]);
+      mat4_invert(&product, &expanded);
+      mat4_from_mat3x4(&expanded, &one);
+      CHECK(test_near_mat4(&expanded, &product, 1e-4f));
+    }
+
+    for (i = 0; i < count; ++i) {
+      transformed[i].pad = 7.f;
+    }
+    mat3x4_transform_point_batch(&transformed[0].p, sizeof(test_point), &points[0].p, sizeof(test_point), count, &a[0]);
+    for (i = 0; i < count; ++i) {
+      mat3x4_transform_point(&v, &points[i].p, &a[0]);
+      CHECK(test_near_vec3(&transformed[i].p, &v, 1e-6f));
+      CHECK(transformed[i].pad == 7.f);
+      vec3_transform_mat4(&w, &points[i].p, &m4[0]);
+      CHECK(test_near_vec3(&v, &w, 1e-5f));
+    }
+    mat3x4_transform_vector_batch(&transformed[0].p, sizeof(test_point), &points[0].p, sizeof(test_point), count, &a[0]);
+    for (i = 0; i < count; ++i) {
+      mat3x4_transform_vector(&v, &points[i].p, &a[0]);
+      CHECK(test_near_vec3(&transformed[i].p, &v, 1e-6f));
+      mat3x4_transform_point(&w, &points[i].p, &a[0]);
+      vec3_subtract(&w, &w, &(vec3) { { a[0].m03, a[0].m13, a[0].m23 } });
+      CHECK(test_near_vec3(&v, &w, 1e-5f));
+    }
+  }
+
+  {
+    // A zero scale makes the upper 3x3 singular, those elements are reported and left as they were
+    size_t count = 35;
+
+    for (i = 0; i < count; ++i) {
+      test_random_trs(&rng, &q[i], &t[i], &s[i]);
+      if (i % 3 == 1) {
+        s[i].y = 0.f;
+      }
+    }
+    mat3x4_from_rotation_translation_scale_batch(a, q, t, s, count);
+    memcpy(out, b, sizeof(out));
+    CHECK(mat3x4_invert_batch(out, a, count, failed) == 12);
+    for (i = 0; i < count; ++i) {
+      bool singular = i % 3 == 1;
+
+      CHECK(((failed[i / 32] >> (i % 32)) & 1) == (uint32_t) singular);
+      CHECK(!singular || mat3x4_exact_equals(&out[i], &b[i]));
+      CHECK(singular == (mat3x4_invert(&one, &a[i]) == NULL));
+    }
+  }
+
+  return mmath_test_result("mat3x4");
+}
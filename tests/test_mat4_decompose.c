@@ -0,0 +1,152 @@
+#include "mmath_test.h"
+
+#define TEST_BATCH 37
+#define TEST_ROUNDS 200
+
+static float test_float(mmath_rng *rng) {
+  return mmath_rng_float(rng) * 2.f - 1.f;
+}
+
+// T * R * shear * S with the shear laid out as mat4_decompose reports it
+static mat4 *test_compose(mat4 *out, const quat *r, const vec3 *t, const vec3 *s, const vec3 *shear) {
+  mat4 rt, hs;
+
+  mat4_from_rotation_translation(&rt, r, t);
+  mat4_set(
+    &hs,
+    s->x, 0.f, 0.f, 0.f,
+    shear->x * s->y, s->y, 0.f, 0.f,
+    shear->y * s->z, shear->z * s->z, s->z, 0.f,
+    0.f, 0.f, 0.f, 1.f
+  );
+  return mat4_multiply(out, &rt, &hs);
+}
+
+static bool test_near_quat(const quat *a, const quat *b, float eps) {
+  quat n;
+
+  // q and -q are the same rotation
+  quat_scale(&n, b, -1.f);
+  return mmath_test_near_array(a->data, b->data, 4, eps) || mmath_test_near_array(a->data, n.data, 4, eps);
+}
+
+static bool test_untouched(const void *p, size_t size) {
+  const unsigned char *c = p;
+  size_t i;
+
+  for (i = 0; i < size; ++i) {
+    if (c[i] != 0x7f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  mat4 m[TEST_BATCH], recomposed;
+  quat q[TEST_BATCH], r[TEST_BATCH], r1;
+  vec3 t[TEST_BATCH], s[TEST_BATCH], shear[TEST_BATCH];
+  vec3 ot[TEST_BATCH], os[TEST_BATCH], osh[TEST_BATCH], t1, s1, sh1;
+  uint32_t failed[(TEST_BATCH + 31) / 32];
+  mmath_rng rng;
+  size_t round, i;
+
+  mmath_rng_seed(&rng, 20);
+
+  for (round = 0; round < TEST_ROUNDS; ++round) {
+    size_t count = round % (TEST_BATCH + 1);
+    // Every other round mirrors one axis, mat4_decompose then reports three negative scales
+    bool reflect = round % 2 == 1;
+
+    mmath_rng_fill_unit_quat(&rng, q, TEST_BATCH);
+    for (i = 0; i < TEST_BATCH; ++i) {
+      vec3_set(&t[i], test_float(&rng) * 10.f, test_float(&rng) * 10.f, test_float(&rng) * 10.f);
+      vec3_set(&s[i], .25f + mmath_rng_float(&rng) * 2.f, .25f + mmath_rng_float(&rng) * 2.f, .25f + mmath_rng_float(&rng) * 2.f);
+      vec3_set(&shear[i], test_float(&rng) * .5f, test_float(&rng) * .5f, test_float(&rng) * .5f);
+      if (reflect) {
+        s[i].data[i % 3] = -s[i].data[i % 3];
+      }
+      test_compose(&m[i], &q[i], &t[i], &s[i], &shear[i]);
+    }
+
+    memset(r, 0x7f, sizeof(r));
+    CHECK(mat4_decompose_batch(r, ot, os, osh, m, count, failed) == 0);
+    for (i = 0; i < count; ++i) {
+      CHECK(((failed[i / 32] >> (i % 32)) & 1) == 0);
+      CHECK(mat4_decompose(&r1, &t1, &s1, &sh1, &m[i]));
+      CHECK(mmath_test_near_array(r[i].data, r1.data, 4, 1e-5f));
+      CHECK(mmath_test_near_array(ot[i].data, t1.data, 3, 1e-6f));
+      CHECK(mmath_test_near_array(os[i].data, s1.data, 3, 1e-5f));
+      CHECK(mmath_test_near_array(osh[i].data, sh1.data, 3, 1e-5f));
+
+      CHECK(mmath_test_near(quat_length(&r1), 1.f, 1e-5f));
+      test_compose(&recomposed, &r1, &t1, &s1, &sh1);
+      CHECK(mmath_test_near_array(recomposed.data, m[i].data, 16, 1e-4f));
+      if (reflect) {
+        CHECK(s1.x < 0.f && s1.y < 0.f && s1.z < 0.f);
+      } else {
+        CHECK(test_near_quat(&r1, &q[i], 1e-4f));
+        CHECK(mmath_test_near_array(s1.data, s[i].data, 3, 1e-4f));
+        CHECK(mmath_test_near_array(sh1.data, shear[i].data, 3, 1e-4f));
+      }
+    }
+    if (count < TEST_BATCH) {
+      CHECK(test_untouched(&r[count], sizeof(quat)));
+    }
+
+    // shear may be NULL
+    CHECK(mat4_decompose_batch(r, ot, os, NULL, m, count, NULL) == 0);
+    for (i = 0; i < count; ++i) {
+      mat4_decompose(&r1, &t1, &s1, NULL, &m[i]);
+      CHECK(mmath_test_near_array(r[i].data, r1.data, 4, 1e-5f));
+      CHECK(mmath_test_near_array(os[i].data, s1.data, 3, 1e-5f));
+    }
+  }
+
+  {
+    // Zero scales and repeated columns are singular, nothing is written for those
+    size_t count = 35, expected = 0;
+
+    mmath_rng_fill_unit_quat(&rng, q, count);
+    for (i = 0; i < count; ++i) {
+      vec3_set(&t[i], test_float(&rng), test_float(&rng), test_float(&rng));
+      vec3_set(&s[i], 1.f, 2.f, 3.f);
+      vec3_set(&shear[i], 0.f, 0.f, 0.f);
+      if (i % 5 == 1) {
+        s[i].data[i % 3] = 0.f;
+      }
+      test_compose(&m[i], &q[i], &t[i], &s[i], &shear[i]);
+      if (i % 5 == 3) {
+        memcpy(&m[i].data[8], &m[i].data[4], 4 * sizeof(float));
+      }
+      expected += i % 5 == 1 || i % 5 == 3;
+    }
+
+    memset(r, 0x7f, sizeof(r));
+    memset(ot, 0x7f, sizeof(ot));
+    memset(os, 0x7f, sizeof(os));
+    memset(osh, 0x7f, sizeof(osh));
+    CHECK(mat4_decompose_batch(r, ot, os, osh, m, count, failed) == expected);
+    for (i = 0; i < count; ++i) {
+      bool singular = i % 5 == 1 || i % 5 == 3;
+
+      CHECK(((failed[i / 32] >> (i % 32)) & 1) == (uint32_t) singular);
+      CHECK(!singular || test_untouched(&r[i], sizeof(quat)));
+      CHECK(!singular || test_untouched(&ot[i], sizeof(vec3)));
+      CHECK(!singular || test_untouched(&os[i], sizeof(vec3)));
+      CHECK(!singular || test_untouched(&osh[i], sizeof(vec3)));
+
+      memset(&r1, 0x7f, sizeof(r1));
+      memset(&t1, 0x7f, sizeof(t1));
+      memset(&s1, 0x7f, sizeof(s1));
+      memset(&sh1, 0x7f, sizeof(sh1));
+      CHECK(mat4_decompose(&r1, &t1, &s1, &sh1, &m[i]) == !singular);
+      CHECK(!singular || test_untouched(&r1, sizeof(r1)));
+      CHECK(!singular || test_untouched(&t1, sizeof(t1)));
+      CHECK(!singular || test_untouched(&s1, sizeof(s1)));
+      CHECK(!singular || test_untouched(&sh1, sizeof(sh1)));
+    }
+  }
+
+  return mmath_test_result("mat4_decompose");
+}
@@ -0,0 +1,148 @@
+#include "mmath_test.h"
+
+#define TEST_MATRICES 2000
+
+// Well conditioned: uniform entries in [-1, 1) with 4 added to the diagonal
+static void test_random_mat4(mmath_rng *rng, mat4 *out) {
+  int k;
+
+  for (k = 0; k < 16; ++k) {
+    out->data[k] = mmath_rng_float(rng) * 2.f - 1.f;
+  }
+  out->m00 += 4.f;
+  out->m11 += 4.f;
+  out->m22 += 4.f;
+  out->m33 += 4.f;
+}
+
+// Column-major like mat4: element (row r, column c) is data[c * 4 + r]
+static void test_multiply_ref(double *out, const mat4 *a, const mat4 *b) {
+  int r, c, k;
+
+  for (c = 0; c < 4; ++c) {
+    for (r = 0; r < 4; ++r) {
+      double sum = 0.;
+      for (k = 0; k < 4; ++k) {
+        sum += (double) a->data[k * 4 + r] * b->data[c * 4 + k];
+      }
+      out[c * 4 + r] = sum;
+    }
+  }
+}
+
+// Gauss-Jordan with partial pivoting, returns the determinant
+static double test_invert_ref(double *out, const mat4 *a) {
+  double m[4][8], det = 1.;
+  int r, c, k;
+
+  for (r = 0; r < 4; ++r) {
+    for (c = 0; c < 4; ++c) {
+      m[r][c] = a->data[c * 4 + r];
+      m[r][c + 4] = r == c;
+    }
+  }
+  for (c = 0; c < 4; ++c) {
+    int pivot = c;
+    for (r = c + 1; r < 4; ++r) {
+      if (fabs(m[r][c]) > fabs(m[pivot][c])) {
+        pivot = r;
+      }
+    }
+    if (pivot != c) {
+      for (k = 0; k < 8; ++k) {
+        double t = m[c][k];
+        m[c][k] = m[pivot][k];
+        m[pivot][k] = t;
+      }
+      det = -det;
+    }
+    det *= m[c][c];
+    for (k = 7; k >= c; --k) {
+      m[c][k] /= m[c][c];
+    }
+    for (r = 0; r < 4; ++r) {
+      if (r != c) {
+        double f = m[r][c];
+        for (k = c; k < 8; ++k) {
+          m[r][k] -= f * m[c][k];
+        }
+      }
+    }
+  }
+  for (r = 0; r < 4; ++r) {
+    for (c = 0; c < 4; ++c) {
+      out[c * 4 + r] = m[r][c + 4];
+    }
+  }
+  return det;
+}
+
+static bool test_near_ref(const mat4 *a, const double *ref, float eps) {
+  int k;
+
+  for (k = 0; k < 16; ++k) {
+    if (!mmath_test_near(a->data[k], (float) ref[k], eps)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  mmath_rng rng;
+  size_t i;
+  int k;
+
+  mmath_rng_seed(&rng, 2);
+
+  for (i = 0; i < TEST_MATRICES; ++i) {
+    mat4 a, b, out, alias;
+    double ref[16], det;
+
+    test_random_mat4(&rng, &a);
+    test_random_mat4(&rng, &b);
+
+    mat4_transpose(&out, &a);
+    for (k = 0; k < 16; ++k) {
+      CHECK(out.data[k] == a.data[(k % 4) * 4 + k / 4]);
+    }
+    alias = a;
+    CHECK(mat4_exact_equals(mat4_transpose(&alias, &alias), &out));
+
+    test_multiply_ref(ref, &a, &b);
+    mat4_multiply(&out, &a, &b);
+    CHECK(test_near_ref(&out, ref, 1e-5f));
+    alias = a;
+    CHECK(mat4_exact_equals(mat4_multiply(&alias, &alias, &b), &out));
+    alias = b;
+    CHECK(mat4_exact_equals(mat4_multiply(&alias, &a, &alias), &out));
+
+    det = test_invert_ref(ref, &a);
+    CHECK(mat4_invert(&out, &a) == &out);
+    CHECK(test_near_ref(&out, ref, 1e-5f));
+    alias = a;
+    CHECK(mat4_invert(&alias, &alias) == &alias && mat4_exact_equals(&alias, &out));
+    CHECK(mmath_test_near(mat4_determinant(&a), (float) det, 1e-4f));
+
+    for (k = 0; k < 16; ++k) {
+      ref[k] *= det;
+    }
+    mat4_adjoint(&out, &a);
+    CHECK(test_near_ref(&out, ref, 1e-4f));
+    alias = a;
+    CHECK(mat4_exact_equals(mat4_adjoint(&alias, &alias), &out));
+  }
+
+  {
+    // A zero column makes every term of the determinant 0 on any path
+    mat4 a, out;
+
+    test_random_mat4(&rng, &a);
+    a.m10 = a.m11 = a.m12 = a.m13 = 0.f;
+    out = a;
+    CHECK(mat4_invert(&out, &a) == NULL);
+    CHECK(mat4_exact_equals(&out, &a));
+  }
+
+  return mmath_test_result("mat4_kernels");
+}
@@ -0,0 +1,82 @@
+#include "mmath_test.h"
+
+#define TEST_BATCH 37
+#define TEST_ROUNDS 200
+
+static float test_float(mmath_rng *rng) {
+  return mmath_rng_float(rng) * 2.f - 1.f;
+}
+
+int main() {
+  mat4 out[TEST_BATCH], guard, parent, local, expected;
+  quat q[TEST_BATCH];
+  vec3 v[TEST_BATCH], s[TEST_BATCH];
+  float qs[4][TEST_BATCH], vs[3][TEST_BATCH], ss[3][TEST_BATCH];
+  const float *const q_soa[4] = { qs[0], qs[1], qs[2], qs[3] };
+  const float *const v_soa[3] = { vs[0], vs[1], vs[2] };
+  const float *const s_soa[3] = { ss[0], ss[1], ss[2] };
+  mmath_rng rng;
+  size_t round, i;
+  int k;
+
+  mmath_rng_seed(&rng, 19);
+  memset(&guard, 0x7f, sizeof(guard));
+
+  for (round = 0; round < TEST_ROUNDS; ++round) {
+    size_t count = round % (TEST_BATCH + 1);
+    const mat4 *p = round % 2 ? &parent : NULL;
+    quat pq;
+    vec3 pv, ps;
+
+    mmath_rng_fill_unit_quat(&rng, q, TEST_BATCH);
+    for (i = 0; i < TEST_BATCH; ++i) {
+      vec3_set(&v[i], test_float(&rng) * 10.f, test_float(&rng) * 10.f, test_float(&rng) * 10.f);
+      // Negative scales included, the batches must not assume a positive diagonal
+      vec3_set(&s[i], test_float(&rng) * 2.f, test_float(&rng) * 2.f, test_float(&rng) * 2.f);
+      for (k = 0; k < 4; ++k) {
+        qs[k][i] = q[i].data[k];
+      }
+      for (k = 0; k < 3; ++k) {
+        vs[k][i] = v[i].data[k];
+        ss[k][i] = s[i].data[k];
+      }
+    }
+    mmath_rng_fill_unit_quat(&rng, &pq, 1);
+    vec3_set(&pv, test_float(&rng) * 10.f, test_float(&rng) * 10.f, test_float(&rng) * 10.f);
+    vec3_set(&ps, .5f + mmath_rng_float(&rng), .5f + mmath_rng_float(&rng), .5f + mmath_rng_float(&rng));
+    mat4_from_rotation_translation_scale(&parent, &pq, &pv, &ps);
+
+    // The element past count must be left alone
+    memset(out, 0x7f, sizeof(out));
+    CHECK(mat4_from_rotation_translation_scale_batch(out, q, v, s, p, count) == out);
+    for (i = 0; i < count; ++i) {
+      mat4_from_rotation_translation_scale(&local, &q[i], &v[i], &s[i]);
+      if (p) {
+        mat4_multiply(&expected, p, &local);
+      } else {
+        expected = local;
+      }
+      CHECK(mmath_test_near_array(out[i].data, expected.data, 16, 1e-5f));
+    }
+    if (count < TEST_BATCH) {
+      CHECK(memcmp(&out[count], &guard, sizeof(guard)) == 0);
+    }
+
+    memset(out, 0x7f, sizeof(out));
+    CHECK(mat4_from_rotation_translation_scale_batch_soa(out, q_soa, v_soa, s_soa, p, count) == out);
+    for (i = 0; i < count; ++i) {
+      mat4_from_rotation_translation_scale(&local, &q[i], &v[i], &s[i]);
+      if (p) {
+        mat4_multiply(&expected, p, &local);
+      } else {
+        expected = local;
+      }
+      CHECK(mmath_test_near_array(out[i].data, expected.data, 16, 1e-5f));
+    }
+    if (count < TEST_BATCH) {
+      CHECK(memcmp(&out[count], &guard, sizeof(guard)) == 0);
+    }
+  }
+
+  return mmath_test_result("mat4_trs");
+}
@@ -0,0 +1,90 @@
+#include "mmath_test.h"
+
+#define TEST_NODES 36000
+#define TEST_ROUNDS 20
+
+// Random breadth-first forest: each node picks its parent from the previous level, and new
+// levels start at random widths so both wide and deep trees come up
+static void test_build(hierarchy *a, hierarchy *b, mmath_rng *rng, size_t count, uint32_t level_chance) {
+  int32_t lo = -1, hi = -1;
+  size_t level_begin = 0, i;
+
+  for (i = 0; i < count; ++i) {
+    int32_t parent = -1;
+    quat r;
+    vec3 t, s;
+
+    if (i > 0 && mmath_rng_next(rng) % level_chance == 0) {
+      lo = (int32_t) level_begin;
+      hi = (int32_t) i - 1;
+      level_begin = i;
+    }
+    if (hi >= 0) {
+      parent = lo + (int32_t) (mmath_rng_next(rng) % (uint32_t) (hi - lo + 1));
+    }
+    CHECK(hierarchy_add(a, parent) == (int32_t) i);
+    CHECK(hierarchy_add(b, parent) == (int32_t) i);
+
+    mmath_rng_fill_unit_quat(rng, &r, 1);
+    vec3_set(&t, mmath_rng_float(rng) * 2.f - 1.f, mmath_rng_float(rng) * 2.f - 1.f, mmath_rng_float(rng));
+    vec3_set(&s, .9f + mmath_rng_float(rng) * .2f, 1.f, 1.f);
+    hierarchy_set_local(a, i, &r, &t, &s);
+    hierarchy_set_local(b, i, &r, &t, &s);
+  }
+}
+
+static void test_compare(mmath_pool *pool, hierarchy *a, hierarchy *b, uint32_t *ua, uint32_t *ub) {
+  size_t na = hierarchy_update(a, ua);
+  size_t nb = mmath_parallel_hierarchy_update(pool, b, ub);
+
+  CHECK(na == nb);
+  CHECK(memcmp(ua, ub, na * sizeof(uint32_t)) == 0);
+  CHECK(memcmp(a->worlds, b->worlds, a->count * sizeof(mat4)) == 0);
+  CHECK(memcmp(a->dirty, b->dirty, a->count) == 0);
+  CHECK(a->first_dirty == b->first_dirty);
+}
+
+int main() {
+  static const size_t grains[] = { 0, 1, 7, 64, 1000 };
+  static const uint32_t level_chances[] = { 4000, 300, 8 };
+  mmath_pool *cores = mmath_pool_create(0);
+  // More threads than cores, so workers get preempted while others spin on their chunks
+  mmath_pool *pool = mmath_pool_create(2 * mmath_pool_threads(cores) + 1);
+  uint32_t *ua = malloc(TEST_NODES * sizeof(uint32_t)), *ub = malloc(TEST_NODES * sizeof(uint32_t));
+  mmath_rng rng;
+  size_t shape, round, k;
+
+  mmath_pool_destroy(cores);
+  mmath_rng_seed(&rng, 23);
+
+  for (shape = 0; shape < sizeof(level_chances) / sizeof(level_chances[0]); ++shape) {
+    hierarchy *a = hierarchy_create(0), *b = hierarchy_create(0);
+
+    test_build(a, b, &rng, TEST_NODES, level_chances[shape]);
+    test_compare(pool, a, b, ua, ub);
+
+    for (round = 0; round < TEST_ROUNDS; ++round) {
+      size_t marks = mmath_rng_next(&rng) % 400;
+
+      mmath_pool_set_grain(pool, grains[round % (sizeof(grains) / sizeof(grains[0]))]);
+      for (k = 0; k < marks; ++k) {
+        size_t index = mmath_rng_next(&rng) % TEST_NODES;
+        hierarchy_mark_dirty(a, index);
+        hierarchy_mark_dirty(b, index);
+      }
+      if (round % 7 == 3) {
+        hierarchy_mark_dirty(a, 0);
+        hierarchy_mark_dirty(b, 0);
+      }
+      test_compare(round % 5 == 4 ? NULL : pool, a, b, ua, ub);
+    }
+
+    hierarchy_free(a);
+    hierarchy_free(b);
+  }
+
+  mmath_pool_destroy(pool);
+  free(ua);
+  free(ub);
+  return mmath_test_result("parallel_hierarchy");
+}
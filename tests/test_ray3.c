@@ -0,0 +1,175 @@
+#include "mmath_test.h"
+
+#define TEST_ROUNDS 2000
+#define TEST_TRIANGLES 6
+
+static float test_float(mmath_rng *rng) {
+  return mmath_rng_float(rng) * 2.f - 1.f;
+}
+
+static void test_random_vec3(mmath_rng *rng, vec3 *out, float scale) {
+  vec3_set(out, test_float(rng) * scale, test_float(rng) * scale, test_float(rng) * scale);
+}
+
+// Aimed at the unit cube so that most rays hit something, every fourth one runs along an edge
+// of the first triangle, which is parallel to it
+static void test_random_ray(mmath_rng *rng, ray3 *out, const vec3 *a, const vec3 *b, size_t i) {
+  vec3 target;
+
+  test_random_vec3(rng, &out->origin, 3.f);
+  if (i % 4 == 3) {
+    vec3_subtract(&out->direction, b, a);
+    return;
+  }
+  test_random_vec3(rng, &target, 1.f);
+  vec3_subtract(&out->direction, &target, &out->origin);
+}
+
+// Lanes past count hold NaNs or something that would hit, the packet tests have to ignore both
+static void test_garbage(float *lanes, size_t count, float value) {
+  size_t i;
+
+  for (i = count; i < 8; ++i) {
+    lanes[i] = (i + count) % 2 ? NAN : value;
+  }
+}
+
+static void test_rays_against_triangle(mmath_rng *rng, size_t count) {
+  vec3 tri[TEST_TRIANGLES][3];
+  ray3 rays[8];
+  ray3_packet packet;
+  ray3_packet_hit hit, before;
+  float t[8], u[8], v[8];
+  size_t i, j;
+  int k;
+
+  for (j = 0; j < TEST_TRIANGLES; ++j) {
+    for (k = 0; k < 3; ++k) {
+      test_random_vec3(rng, &tri[j][k], 1.f);
+    }
+  }
+  for (i = 0; i < count; ++i) {
+    test_random_ray(rng, &rays[i], &tri[0][0], &tri[0][1], i);
+    ray3_packet_set(&packet, i, &rays[i]);
+    // Some rays are limited to a short distance, the rest take any hit
+    t[i] = hit.t[i] = i % 3 == 0 ? mmath_rng_float(rng) * 3.f : INFINITY;
+    u[i] = hit.u[i] = -1.f;
+    v[i] = hit.v[i] = -1.f;
+  }
+  {
+    // Aimed at the centroid of the first triangle, with no distance limit
+    vec3 origin, direction;
+
+    test_random_vec3(rng, &origin, 3.f);
+    vec3_add(&direction, &tri[0][0], &tri[0][1]);
+    vec3_add(&direction, &direction, &tri[0][2]);
+    vec3_scale_and_add(&direction, &origin, &direction, -1.f / 3.f);
+    vec3_negate(&direction, &direction);
+    for (k = 0; k < 3; ++k) {
+      test_garbage(packet.origin[k], count, origin.data[k]);
+      test_garbage(packet.direction[k], count, direction.data[k]);
+    }
+  }
+  test_garbage(hit.t, count, INFINITY);
+  test_garbage(hit.u, count, -1.f);
+  test_garbage(hit.v, count, -1.f);
+
+  for (j = 0; j < TEST_TRIANGLES; ++j) {
+    uint32_t expected = 0, mask;
+
+    for (i = 0; i < count; ++i) {
+      vec2 uv;
+
+      if (ray3_intersect_triangle(&rays[i], &tri[j][0], &tri[j][1], &tri[j][2], &t[i], &uv)) {
+        u[i] = uv.x;
+        v[i] = uv.y;
+        expected |= (uint32_t) 1 << i;
+      }
+    }
+    before = hit;
+    mask = ray3_packet_intersect_triangle(&hit, &packet, count, &tri[j][0], &tri[j][1], &tri[j][2]);
+    CHECK(mask == expected);
+    for (i = 0; i < count; ++i) {
+      CHECK(hit.t[i] == t[i] && hit.u[i] == u[i] && hit.v[i] == v[i]);
+    }
+    CHECK(memcmp(&hit.t[count], &before.t[count], (8 - count) * sizeof(float)) == 0);
+    CHECK(memcmp(&hit.u[count], &before.u[count], (8 - count) * sizeof(float)) == 0);
+    CHECK(memcmp(&hit.v[count], &before.v[count], (8 - count) * sizeof(float)) == 0);
+  }
+}
+
+static void test_ray_against_triangles(mmath_rng *rng, size_t count) {
+  vec3 tri[8][3];
+  ray3 r;
+  ray3_triangle_packet packet;
+  float t_max = mmath_rng_float(rng) < .25f ? mmath_rng_float(rng) * 3.f : INFINITY;
+  float t = t_max, best = t_max;
+  vec2 uv = { { -1.f, -1.f } }, best_uv = uv;
+  int lane, expected = -1;
+  size_t i;
+  int k;
+
+  for (i = 0; i < count; ++i) {
+    // Every third triangle repeats an earlier one, the lowest lane has to win the tie
+    if (i >= 3 && i % 3 == 0) {
+      memcpy(tri[i], tri[i - 3], sizeof(tri[i]));
+    } else {
+      for (k = 0; k < 3; ++k) {
+        test_random_vec3(rng, &tri[i][k], 1.f);
+      }
+    }
+    ray3_triangle_packet_set(&packet, i, &tri[i][0], &tri[i][1], &tri[i][2]);
+  }
+  test_random_ray(rng, &r, &tri[0][0], &tri[0][1], mmath_rng_next(rng));
+  {
+    // A large triangle right in front of the origin, closer than anything else
+    vec3 p, a, b, c;
+
+    vec3_scale_and_add(&p, &r.origin, &r.direction, 1e-3f);
+    vec3_add(&a, &p, &(vec3) { { -100.f, -100.f, 0.f } });
+    vec3_add(&b, &p, &(vec3) { { 300.f, -100.f, 0.f } });
+    vec3_add(&c, &p, &(vec3) { { -100.f, 300.f, 0.f } });
+    for (i = count; i < 8; ++i) {
+      ray3_triangle_packet_set(&packet, i, &a, &b, &c);
+    }
+    test_garbage(packet.vertex[0], count, a.x);
+  }
+
+  for (i = 0; i < count; ++i) {
+    float ti = t_max;
+    vec2 uvi;
+
+    if (ray3_intersect_triangle(&r, &tri[i][0], &tri[i][1], &tri[i][2], &ti, &uvi) && (expected < 0 || ti < best)) {
+      best = ti;
+      best_uv = uvi;
+      expected = (int) i;
+    }
+  }
+
+  lane = ray3_intersect_triangle_packet(&r, &packet, count, &t, &uv);
+  CHECK(lane == expected);
+  CHECK(t == best);
+  CHECK(uv.x == best_uv.x && uv.y == best_uv.y);
+
+  // uv may be NULL
+  t = t_max;
+  CHECK(ray3_intersect_triangle_packet(&r, &packet, count, &t, NULL) == expected);
+  CHECK(t == best);
+}
+
+int main() {
+  mmath_rng rng;
+  size_t count;
+  int round;
+
+  mmath_rng_seed(&rng, 25);
+
+  for (round = 0; round < TEST_ROUNDS; ++round) {
+    for (count = 1; count <= 8; ++count) {
+      test_rays_against_triangle(&rng, count);
+      test_ray_against_triangles(&rng, count);
+    }
+  }
+
+  return mmath_test_result("ray3");
+}
@@ -0,0 +1,210 @@
+#include "mmath_test.h"
+
+#define TEST_MAX 33
+
+static const size_t test_counts[] = { 1, 3, 4, 5, 8, 17, 33 };
+
+static float test_float(mmath_rng *rng) {
+  return mmath_rng_float(rng) * 2.f - 1.f;
+}
+
+static void test_fill(mmath_rng *rng, float *out, size_t count) {
+  size_t i;
+
+  for (i = 0; i < count; ++i) {
+    out[i] = test_float(rng) * 4.f;
+  }
+}
+
+static void test_vec3(size_t count, mmath_rng *rng) {
+  vec3_soa *a = vec3_soa_create(count), *b = vec3_soa_create(count), *out = vec3_soa_create(count);
+  vec3 va[TEST_MAX], vb[TEST_MAX], vo[TEST_MAX], e, g;
+  float dots[TEST_MAX];
+  mat4 m;
+  size_t i;
+  int k;
+
+  test_fill(rng, va[0].data, 3 * count);
+  test_fill(rng, vb[0].data, 3 * count);
+  // A zero vector must normalize to zero in the SIMD body and in the tail alike
+  vec3_set(&va[count / 2], 0.f, 0.f, 0.f);
+  vec3_set(&va[count - 1], 0.f, 0.f, 0.f);
+  vec3_soa_from_vec3(a, va);
+  vec3_soa_from_vec3(b, vb);
+
+  vec3_soa_to_vec3(vo, a);
+  CHECK(memcmp(vo, va, count * sizeof(vec3)) == 0);
+  for (i = 0; i < count; ++i) {
+    vec3_soa_get(&g, b, i);
+    CHECK(vec3_exact_equals(&g, &vb[i]));
+  }
+
+  vec3_soa_add(out, a, b);
+  for (i = 0; i < count; ++i) {
+    vec3_add(&e, &va[i], &vb[i]);
+    CHECK(vec3_exact_equals(vec3_soa_get(&g, out, i), &e));
+  }
+  vec3_soa_scale_and_add(out, a, b, -.75f);
+  for (i = 0; i < count; ++i) {
+    vec3_scale_and_add(&e, &va[i], &vb[i], -.75f);
+    CHECK(mmath_test_near_array(vec3_soa_get(&g, out, i)->data, e.data, 3, 1e-6f));
+  }
+  vec3_soa_dot(dots, a, b);
+  for (i = 0; i < count; ++i) {
+    CHECK(mmath_test_near(dots[i], vec3_dot(&va[i], &vb[i]), 1e-6f));
+  }
+  vec3_soa_cross(out, a, b);
+  for (i = 0; i < count; ++i) {
+    vec3_cross(&e, &va[i], &vb[i]);
+    CHECK(mmath_test_near_array(vec3_soa_get(&g, out, i)->data, e.data, 3, 1e-6f));
+  }
+  vec3_soa_lerp(out, a, b, .3f);
+  for (i = 0; i < count; ++i) {
+    vec3_lerp(&e, &va[i], &vb[i], .3f);
+    CHECK(mmath_test_near_array(vec3_soa_get(&g, out, i)->data, e.data, 3, 1e-6f));
+  }
+  vec3_soa_normalize(out, a);
+  for (i = 0; i < count; ++i) {
+    vec3_normalize(&e, &va[i]);
+    CHECK(mmath_test_near_array(vec3_soa_get(&g, out, i)->data, e.data, 3, 1e-6f));
+  }
+
+  // A projective matrix, then one with a zero bottom row, which divides by 1 instead of 0
+  for (k = 0; k < 2; ++k) {
+    test_fill(rng, m.data, 16);
+    m.m03 *= .1f;
+    m.m13 *= .1f;
+    m.m23 *= .1f;
+    m.m33 = 16.f;
+    if (k == 1) {
+      m.m03 = m.m13 = m.m23 = m.m33 = 0.f;
+    }
+    vec3_soa_transform_mat4(out, a, &m);
+    for (i = 0; i < count; ++i) {
+      vec3_transform_mat4(&e, &va[i], &m);
+      CHECK(mmath_test_near_array(vec3_soa_get(&g, out, i)->data, e.data, 3, 1e-6f));
+    }
+  }
+
+  // out may be one of the inputs
+  vec3_soa_add(a, a, b);
+  for (i = 0; i < count; ++i) {
+    vec3_add(&e, &va[i], &vb[i]);
+    CHECK(vec3_exact_equals(vec3_soa_get(&g, a, i), &e));
+  }
+  vec3_soa_set(a, count - 1, &vb[0]);
+  CHECK(vec3_exact_equals(vec3_soa_get(&g, a, count - 1), &vb[0]));
+
+  vec3_soa_free(a);
+  vec3_soa_free(b);
+  vec3_soa_free(out);
+}
+
+static void test_vec4(size_t count, mmath_rng *rng) {
+  vec4_soa *a = vec4_soa_create(count), *b = vec4_soa_create(count), *out = vec4_soa_create(count);
+  vec4 va[TEST_MAX], vb[TEST_MAX], vo[TEST_MAX], e, g;
+  float dots[TEST_MAX];
+  mat4 m;
+  size_t i;
+
+  test_fill(rng, va[0].data, 4 * count);
+  test_fill(rng, vb[0].data, 4 * count);
+  vec4_set(&va[count / 2], 0.f, 0.f, 0.f, 0.f);
+  vec4_set(&va[count - 1], 0.f, 0.f, 0.f, 0.f);
+  vec4_soa_from_vec4(a, va);
+  vec4_soa_from_vec4(b, vb);
+
+  vec4_soa_to_vec4(vo, a);
+  CHECK(memcmp(vo, va, count * sizeof(vec4)) == 0);
+
+  vec4_soa_add(out, a, b);
+  for (i = 0; i < count; ++i) {
+    vec4_add(&e, &va[i], &vb[i]);
+    CHECK(vec4_exact_equals(vec4_soa_get(&g, out, i), &e));
+  }
+  vec4_soa_scale_and_add(out, a, b, 2.5f);
+  for (i = 0; i < count; ++i) {
+    vec4_scale_and_add(&e, &va[i], &vb[i], 2.5f);
+    CHECK(mmath_test_near_array(vec4_soa_get(&g, out, i)->data, e.data, 4, 1e-6f));
+  }
+  vec4_soa_dot(dots, a, b);
+  for (i = 0; i < count; ++i) {
+    CHECK(mmath_test_near(dots[i], vec4_dot(&va[i], &vb[i]), 1e-6f));
+  }
+  vec4_soa_lerp(out, a, b, .6f);
+  for (i = 0; i < count; ++i) {
+    vec4_lerp(&e, &va[i], &vb[i], .6f);
+    CHECK(mmath_test_near_array(vec4_soa_get(&g, out, i)->data, e.data, 4, 1e-6f));
+  }
+  vec4_soa_normalize(out, a);
+  for (i = 0; i < count; ++i) {
+    vec4_normalize(&e, &va[i]);
+    CHECK(mmath_test_near_array(vec4_soa_get(&g, out, i)->data, e.data, 4, 1e-6f));
+  }
+  test_fill(rng, m.data, 16);
+  vec4_soa_transform_mat4(out, a, &m);
+  for (i = 0; i < count; ++i) {
+    vec4_transform_mat4(&e, &va[i], &m);
+    CHECK(mmath_test_near_array(vec4_soa_get(&g, out, i)->data, e.data, 4, 1e-6f));
+  }
+
+  vec4_soa_free(a);
+  vec4_soa_free(b);
+  vec4_soa_free(out);
+}
+
+static void test_quat(size_t count, mmath_rng *rng) {
+  quat_soa *a = quat_soa_create(count), *b = quat_soa_create(count), *out = quat_soa_create(count);
+  quat qa[TEST_MAX], qb[TEST_MAX], qo[TEST_MAX], e, g;
+  size_t i;
+
+  test_fill(rng, qa[0].data, 4 * count);
+  test_fill(rng, qb[0].data, 4 * count);
+  quat_set(&qa[count - 1], 0.f, 0.f, 0.f, 0.f);
+  quat_soa_from_quat(a, qa);
+  quat_soa_from_quat(b, qb);
+
+  quat_soa_to_quat(qo, b);
+  CHECK(memcmp(qo, qb, count * sizeof(quat)) == 0);
+
+  quat_soa_multiply(out, a, b);
+  for (i = 0; i < count; ++i) {
+    quat_multiply(&e, &qa[i], &qb[i]);
+    CHECK(mmath_test_near_array(quat_soa_get(&g, out, i)->data, e.data, 4, 1e-6f));
+  }
+  quat_soa_normalize(out, a);
+  for (i = 0; i < count; ++i) {
+    quat_normalize(&e, &qa[i]);
+    CHECK(mmath_test_near_array(quat_soa_get(&g, out, i)->data, e.data, 4, 1e-6f));
+  }
+  // In place, both operands aliasing out
+  quat_soa_multiply(b, b, b);
+  for (i = 0; i < count; ++i) {
+    quat_multiply(&e, &qb[i], &qb[i]);
+    CHECK(mmath_test_near_array(quat_soa_get(&g, b, i)->data, e.data, 4, 1e-6f));
+  }
+  quat_soa_set(out, 0, &qb[0]);
+  CHECK(quat_exact_equals(quat_soa_get(&g, out, 0), &qb[0]));
+
+  quat_soa_free(a);
+  quat_soa_free(b);
+  quat_soa_free(out);
+}
+
+int main() {
+  mmath_rng rng;
+  size_t i;
+  int round;
+
+  mmath_rng_seed(&rng, 21);
+
+  for (round = 0; round < 50; ++round) {
+    for (i = 0; i < sizeof(test_counts) / sizeof(test_counts[0]); ++i) {
+      test_vec3(test_counts[i], &rng);
+      test_vec4(test_counts[i], &rng);
+      test_quat(test_counts[i], &rng);
+    }
+  }
+
+  return mmath_test_result("soa");
+}